@@ -0,0 +1,57 @@
+#include "duckpgq/core/functions/function_data/centrality_function_data.hpp"
+
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+CentralityFunctionData::CentralityFunctionData(ClientContext &context, int32_t csr_id, int64_t samples,
+                                               bool normalized)
+    : context(context), csr_id(csr_id), samples(samples), normalized(normalized), state_converged(false) {
+}
+
+unique_ptr<FunctionData> CentralityFunctionData::CentralityBind(ClientContext &context, ScalarFunction &bound_function,
+                                                                vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[0]->IsFoldable()) {
+		throw InvalidInputException("Id must be constant.");
+	}
+
+	int32_t csr_id = ExpressionExecutor::EvaluateScalar(context, *arguments[0]).GetValue<int32_t>();
+	auto duckpgq_state = GetDuckPGQState(context);
+	duckpgq_state->csr_to_delete.insert(csr_id);
+
+	if (arguments.size() == 2) {
+		return make_uniq<CentralityFunctionData>(context, csr_id, 0, false);
+	}
+	for (idx_t i = 2; i < arguments.size(); i++) {
+		if (!arguments[i]->IsFoldable()) {
+			throw InvalidInputException("%s parameters must be constant.", bound_function.name);
+		}
+	}
+	// a NULL sample size runs from every vertex
+	auto samples_value = ExpressionExecutor::EvaluateScalar(context, *arguments[2]);
+	int64_t samples = 0;
+	if (!samples_value.IsNull()) {
+		samples = samples_value.GetValue<int64_t>();
+		if (samples <= 0) {
+			throw InvalidInputException("%s samples must be positive, got %d", bound_function.name, samples);
+		}
+	}
+	auto normalized = false;
+	if (arguments.size() > 3) {
+		auto normalized_value = ExpressionExecutor::EvaluateScalar(context, *arguments[3]);
+		normalized = !normalized_value.IsNull() && normalized_value.GetValue<bool>();
+	}
+	return make_uniq<CentralityFunctionData>(context, csr_id, samples, normalized);
+}
+
+unique_ptr<FunctionData> CentralityFunctionData::Copy() const {
+	return make_uniq<CentralityFunctionData>(context, csr_id, samples, normalized);
+}
+
+bool CentralityFunctionData::Equals(const FunctionData &other_p) const {
+	auto &other = other_p.Cast<CentralityFunctionData>();
+	return csr_id == other.csr_id && samples == other.samples && normalized == other.normalized &&
+	       state_converged == other.state_converged;
+}
+
+} // namespace duckdb
@@ -0,0 +1,58 @@
+#include "duckpgq/core/functions/function_data/community_detection_function_data.hpp"
+
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+CommunityDetectionFunctionData::CommunityDetectionFunctionData(ClientContext &context, int32_t csr_id, bool leiden,
+                                                               int64_t seed, double resolution,
+                                                               int64_t max_iterations)
+    : context(context), csr_id(csr_id), leiden(leiden), seed(seed), resolution(resolution),
+      max_iterations(max_iterations), state_converged(false), modularity(0), runtime_ms(0) {
+}
+
+unique_ptr<FunctionData>
+CommunityDetectionFunctionData::CommunityDetectionBind(ClientContext &context, ScalarFunction &bound_function,
+                                                       vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[0]->IsFoldable()) {
+		throw InvalidInputException("Id must be constant.");
+	}
+	for (idx_t i = 2; i < arguments.size(); i++) {
+		if (!arguments[i]->IsFoldable()) {
+			throw InvalidInputException("%s parameters must be constant.", bound_function.name);
+		}
+	}
+
+	int32_t csr_id = ExpressionExecutor::EvaluateScalar(context, *arguments[0]).GetValue<int32_t>();
+	auto duckpgq_state = GetDuckPGQState(context);
+	duckpgq_state->csr_to_delete.insert(csr_id);
+
+	auto leiden = bound_function.name == "leiden";
+	auto seed = ExpressionExecutor::EvaluateScalar(context, *arguments[2]).GetValue<int64_t>();
+	double resolution = LEIDEN_DEFAULT_RESOLUTION;
+	if (leiden) {
+		resolution = ExpressionExecutor::EvaluateScalar(context, *arguments[3]).GetValue<double>();
+		if (resolution <= 0) {
+			throw InvalidInputException("leiden resolution must be positive, got %f", resolution);
+		}
+	}
+	auto max_iterations = ExpressionExecutor::EvaluateScalar(context, *arguments.back()).GetValue<int64_t>();
+	if (max_iterations <= 0) {
+		throw InvalidInputException("%s max_iterations must be positive, got %d", bound_function.name,
+		                            max_iterations);
+	}
+	return make_uniq<CommunityDetectionFunctionData>(context, csr_id, leiden, seed, resolution, max_iterations);
+}
+
+unique_ptr<FunctionData> CommunityDetectionFunctionData::Copy() const {
+	return make_uniq<CommunityDetectionFunctionData>(context, csr_id, leiden, seed, resolution, max_iterations);
+}
+
+bool CommunityDetectionFunctionData::Equals(const FunctionData &other_p) const {
+	auto &other = other_p.Cast<CommunityDetectionFunctionData>();
+	return csr_id == other.csr_id && leiden == other.leiden && seed == other.seed &&
+	       resolution == other.resolution && max_iterations == other.max_iterations &&
+	       state_converged == other.state_converged;
+}
+
+} // namespace duckdb
@@ -0,0 +1,70 @@
+#include "duckpgq/core/functions/function_data/edge_filter_function_data.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckpgq/common.hpp"
+
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+unique_ptr<FunctionData> EdgeFilterFunctionData::Copy() const {
+	return make_uniq<EdgeFilterFunctionData>(context, csr_id, filter);
+}
+
+const DuckPGQBitmap &EdgeFilterFunctionData::GetEdgeMask(CSR &csr) {
+	if (!mask_ready || mask_edge_count != csr.e.size()) {
+		lock_guard<mutex> guard(mask_lock);
+		if (!mask_ready || mask_edge_count != csr.e.size()) {
+			auto mask = make_uniq<DuckPGQBitmap>(csr.e.size());
+			{
+				lock_guard<mutex> property_guard(csr.property_lock);
+				csr.GetEdgeProperty(filter.property).Evaluate(filter, *mask);
+			}
+			edge_mask = std::move(mask);
+			mask_edge_count = csr.e.size();
+			mask_ready = true;
+		}
+	}
+	return *edge_mask;
+}
+
+bool EdgeFilterFunctionData::Equals(const FunctionData &other_p) const {
+	auto &other = other_p.Cast<EdgeFilterFunctionData>();
+	return other.csr_id == csr_id && other.filter == filter;
+}
+
+unique_ptr<FunctionData> EdgeFilterFunctionData::EdgeFilterBind(ClientContext &context, ScalarFunction &bound_function,
+                                                                vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[0]->IsFoldable()) {
+		throw InvalidInputException("Id must be constant.");
+	}
+	for (idx_t i = 2; i < 5; i++) {
+		if (!arguments[i]->IsFoldable()) {
+			throw InvalidInputException("The edge property, filter operator and filter constant must be constant.");
+		}
+	}
+	int32_t csr_id = ExpressionExecutor::EvaluateScalar(context, *arguments[0]).GetValue<int32_t>();
+
+	CSREdgeFilter filter;
+	filter.property = ExpressionExecutor::EvaluateScalar(context, *arguments[2]).ToString();
+	filter.type = CSREdgeFilter::ParseType(ExpressionExecutor::EvaluateScalar(context, *arguments[3]).ToString());
+	auto constant = ExpressionExecutor::EvaluateScalar(context, *arguments[4]);
+	bool is_list = filter.type == CSREdgeFilterType::BETWEEN || filter.type == CSREdgeFilterType::IN;
+	if (is_list) {
+		if (constant.type().id() != LogicalTypeId::LIST || constant.IsNull()) {
+			throw InvalidInputException("Edge filters with between or in need a list of constants");
+		}
+		filter.constants = ListValue::GetChildren(constant);
+		if (filter.type == CSREdgeFilterType::BETWEEN && filter.constants.size() != 2) {
+			throw InvalidInputException("Edge filters with between need a list with a lower and an upper bound");
+		}
+	} else {
+		filter.constants.push_back(std::move(constant));
+	}
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	duckpgq_state->csr_to_delete.insert(csr_id);
+
+	return make_uniq<EdgeFilterFunctionData>(context, csr_id, std::move(filter));
+}
+
+} // namespace duckdb
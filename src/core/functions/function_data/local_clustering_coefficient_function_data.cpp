@@ -5,8 +5,9 @@
 
 namespace duckdb {
 
-LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientFunctionData(ClientContext &context, int32_t csr_id)
-    : context(context), csr_id(csr_id) {
+LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientFunctionData(ClientContext &context, int32_t csr_id,
+                                                                               bool count_triangles)
+    : context(context), csr_id(csr_id), count_triangles(count_triangles), state_converged(false) {
 }
 
 unique_ptr<FunctionData> LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientBind(
@@ -18,16 +19,17 @@ unique_ptr<FunctionData> LocalClusteringCoefficientFunctionData::LocalClustering
 	int32_t csr_id = ExpressionExecutor::EvaluateScalar(context, *arguments[0]).GetValue<int32_t>();
 	auto duckpgq_state = GetDuckPGQState(context);
 	duckpgq_state->csr_to_delete.insert(csr_id);
-	return make_uniq<LocalClusteringCoefficientFunctionData>(context, csr_id);
+	return make_uniq<LocalClusteringCoefficientFunctionData>(context, csr_id,
+	                                                         bound_function.name != "local_wedge_count");
 }
 
 unique_ptr<FunctionData> LocalClusteringCoefficientFunctionData::Copy() const {
-	return make_uniq<LocalClusteringCoefficientFunctionData>(context, csr_id);
+	return make_uniq<LocalClusteringCoefficientFunctionData>(context, csr_id, count_triangles);
 }
 
 bool LocalClusteringCoefficientFunctionData::Equals(const FunctionData &other_p) const {
 	auto &other = other_p.Cast<LocalClusteringCoefficientFunctionData>();
-	return other.csr_id == csr_id;
+	return other.csr_id == csr_id && other.count_triangles == count_triangles;
 }
 
 } // namespace duckdb
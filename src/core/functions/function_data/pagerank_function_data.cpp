@@ -6,8 +6,14 @@ namespace duckdb {
 
 // Constructor
 PageRankFunctionData::PageRankFunctionData(ClientContext &ctx, int32_t csr)
-    : context(ctx), csr_id(csr), damping_factor(0.85), convergence_threshold(1e-6), iteration_count(0),
-      state_initialized(false), converged(false) {
+    : PageRankFunctionData(ctx, csr, PAGERANK_DEFAULT_DAMPING, PAGERANK_DEFAULT_TOLERANCE,
+                           PAGERANK_DEFAULT_MAX_ITERATIONS) {
+}
+
+PageRankFunctionData::PageRankFunctionData(ClientContext &ctx, int32_t csr, double_t damping_factor,
+                                           double_t convergence_threshold, int64_t max_iterations)
+    : context(ctx), csr_id(csr), damping_factor(damping_factor), convergence_threshold(convergence_threshold),
+      max_iterations(max_iterations), iteration_count(0), state_initialized(false), converged(false) {
 }
 
 unique_ptr<FunctionData> PageRankFunctionData::PageRankBind(ClientContext &context, ScalarFunction &bound_function,
@@ -20,19 +26,38 @@ unique_ptr<FunctionData> PageRankFunctionData::PageRankBind(ClientContext &conte
 	auto duckpgq_state = GetDuckPGQState(context);
 	duckpgq_state->csr_to_delete.insert(csr_id);
 
-	return make_uniq<PageRankFunctionData>(context, csr_id);
+	if (arguments.size() == 2) {
+		return make_uniq<PageRankFunctionData>(context, csr_id);
+	}
+	for (idx_t i = 2; i < arguments.size(); i++) {
+		if (!arguments[i]->IsFoldable()) {
+			throw InvalidInputException("PageRank parameters must be constant.");
+		}
+	}
+	auto damping_factor = ExpressionExecutor::EvaluateScalar(context, *arguments[2]).GetValue<double>();
+	auto convergence_threshold = ExpressionExecutor::EvaluateScalar(context, *arguments[3]).GetValue<double>();
+	auto max_iterations = ExpressionExecutor::EvaluateScalar(context, *arguments[4]).GetValue<int64_t>();
+	if (damping_factor < 0 || damping_factor > 1) {
+		throw InvalidInputException("PageRank damping must be between 0 and 1, got %f", damping_factor);
+	}
+	if (convergence_threshold <= 0) {
+		throw InvalidInputException("PageRank tolerance must be positive, got %f", convergence_threshold);
+	}
+	if (max_iterations <= 0) {
+		throw InvalidInputException("PageRank max_iterations must be positive, got %d", max_iterations);
+	}
+	return make_uniq<PageRankFunctionData>(context, csr_id, damping_factor, convergence_threshold, max_iterations);
 }
 
 // Copy method
 unique_ptr<FunctionData> PageRankFunctionData::Copy() const {
-	auto result = make_uniq<PageRankFunctionData>(context, csr_id);
+	auto result =
+	    make_uniq<PageRankFunctionData>(context, csr_id, damping_factor, convergence_threshold, max_iterations);
 	result->rank = rank;           // Deep copy of rank vector
 	result->temp_rank = temp_rank; // Deep copy of temp_rank vector
-	result->damping_factor = damping_factor;
-	result->convergence_threshold = convergence_threshold;
 	result->iteration_count = iteration_count;
 	result->state_initialized = state_initialized;
-	result->converged = converged;
+	result->converged = converged.load();
 	// Note: state_lock is not copied as mutexes are not copyable
 	return std::move(result);
 }
@@ -55,6 +80,9 @@ bool PageRankFunctionData::Equals(const FunctionData &other_p) const {
 	if (convergence_threshold != other.convergence_threshold) {
 		return false;
 	}
+	if (max_iterations != other.max_iterations) {
+		return false;
+	}
 	if (iteration_count != other.iteration_count) {
 		return false;
 	}
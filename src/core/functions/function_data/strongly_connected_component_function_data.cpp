@@ -0,0 +1,36 @@
+#include "duckpgq/core/functions/function_data/strongly_connected_component_function_data.hpp"
+
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+StronglyConnectedComponentFunctionData::StronglyConnectedComponentFunctionData(ClientContext &context, int32_t csr_id,
+                                                                               bool build_condensation)
+    : context(context), csr_id(csr_id), build_condensation(build_condensation), state_converged(false) {
+}
+
+unique_ptr<FunctionData> StronglyConnectedComponentFunctionData::StronglyConnectedComponentBind(
+    ClientContext &context, ScalarFunction &bound_function, vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[0]->IsFoldable()) {
+		throw InvalidInputException("Id must be constant.");
+	}
+
+	int32_t csr_id = ExpressionExecutor::EvaluateScalar(context, *arguments[0]).GetValue<int32_t>();
+	auto duckpgq_state = GetDuckPGQState(context);
+	duckpgq_state->csr_to_delete.insert(csr_id);
+
+	return make_uniq<StronglyConnectedComponentFunctionData>(
+	    context, csr_id, bound_function.name == "strongly_connected_component_successors");
+}
+
+unique_ptr<FunctionData> StronglyConnectedComponentFunctionData::Copy() const {
+	return make_uniq<StronglyConnectedComponentFunctionData>(context, csr_id, build_condensation);
+}
+
+bool StronglyConnectedComponentFunctionData::Equals(const FunctionData &other_p) const {
+	auto &other = other_p.Cast<StronglyConnectedComponentFunctionData>();
+	return csr_id == other.csr_id && build_condensation == other.build_condensation &&
+	       state_converged == other.state_converged;
+}
+
+} // namespace duckdb
@@ -0,0 +1,34 @@
+#include "duckpgq/core/functions/function_data/summarize_csr_function_data.hpp"
+
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+SummarizeCSRFunctionData::SummarizeCSRFunctionData(ClientContext &context, int32_t csr_id)
+    : context(context), csr_id(csr_id), state_converged(false) {
+}
+
+unique_ptr<FunctionData> SummarizeCSRFunctionData::SummarizeCSRBind(ClientContext &context,
+                                                                    ScalarFunction &bound_function,
+                                                                    vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[0]->IsFoldable()) {
+		throw InvalidInputException("Id must be constant.");
+	}
+
+	int32_t csr_id = ExpressionExecutor::EvaluateScalar(context, *arguments[0]).GetValue<int32_t>();
+	auto duckpgq_state = GetDuckPGQState(context);
+	duckpgq_state->csr_to_delete.insert(csr_id);
+
+	return make_uniq<SummarizeCSRFunctionData>(context, csr_id);
+}
+
+unique_ptr<FunctionData> SummarizeCSRFunctionData::Copy() const {
+	return make_uniq<SummarizeCSRFunctionData>(context, csr_id);
+}
+
+bool SummarizeCSRFunctionData::Equals(const FunctionData &other_p) const {
+	auto &other = other_p.Cast<SummarizeCSRFunctionData>();
+	return csr_id == other.csr_id && state_converged == other.state_converged;
+}
+
+} // namespace duckdb
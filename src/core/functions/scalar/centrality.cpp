@@ -0,0 +1,115 @@
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/centrality_function_data.hpp"
+#include "duckpgq/core/utils/centrality.hpp"
+#include "duckpgq/core/utils/duckpgq_utils.hpp"
+
+#include <duckpgq/core/functions/scalar.hpp>
+
+namespace duckdb {
+
+//! Writes the centrality of every row whose rowid is a vertex of the CSR, NULL otherwise. The first chunk computes
+//! the scores of all vertices with compute(context, csr, info).
+template <class COMPUTE>
+static void ExecuteCentrality(DataChunk &args, ExpressionState &state, Vector &result, COMPUTE &&compute) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CentralityFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		throw ConstraintException("CSR not found. Is the graph populated?");
+	}
+	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
+		throw ConstraintException("Need to initialize CSR before doing %s.", func_expr.function.name);
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	if (!info.state_converged) {
+		std::lock_guard<std::mutex> guard(info.centrality_lock);
+		if (!info.state_converged) {
+			csr.Compact();
+			CSRReadGuard read_guard(csr);
+			info.centrality = compute(info.context, csr, info);
+			info.state_converged = true;
+		}
+	}
+
+	auto &src = args.data[1];
+	UnifiedVectorFormat vdata_src;
+	src.ToUnifiedFormat(args.size(), vdata_src);
+	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<double>(result);
+	ValidityMask &result_validity = FlatVector::Validity(result);
+
+	for (idx_t n = 0; n < args.size(); n++) {
+		auto src_sel = vdata_src.sel->get_index(n);
+		int64_t src_node = csr.ToInternal(src_data[src_sel]);
+		if (!vdata_src.validity.RowIsValid(src_sel) || src_node < 0 || src_node >= csr.VertexCount()) {
+			result_validity.SetInvalid(n);
+			continue;
+		}
+		result_data[n] = info.centrality[src_node];
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+static void BetweennessCentralityFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteCentrality(args, state, result, [](ClientContext &context, const CSR &csr, CentralityFunctionData &info) {
+		return BetweennessCentrality(context, csr, info.samples, info.normalized);
+	});
+}
+
+static void ClosenessCentralityFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteCentrality(args, state, result, [](ClientContext &context, const CSR &csr, CentralityFunctionData &info) {
+		return ClosenessCentrality(context, csr, info.samples);
+	});
+}
+
+static void HarmonicCentralityFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteCentrality(args, state, result, [](ClientContext &context, const CSR &csr, CentralityFunctionData &info) {
+		return HarmonicCentrality(context, csr, info.samples);
+	});
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCentralityScalarFunctions(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. vertex rowid
+	 * 3. <optional> number of sampled sources, NULL for all vertices
+	 * 4. <optional> normalize the scores
+	 */
+	ScalarFunctionSet betweenness("betweenness_centrality");
+	betweenness.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::DOUBLE,
+	                                       BetweennessCentralityFunction, CentralityFunctionData::CentralityBind));
+	betweenness.AddFunction(
+	    ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BOOLEAN},
+	                   LogicalType::DOUBLE, BetweennessCentralityFunction, CentralityFunctionData::CentralityBind));
+	loader.RegisterFunction(betweenness);
+
+	/* 1. CSR ID
+	 * 2. vertex rowid
+	 * 3. <optional> number of sampled sources, NULL for all vertices
+	 */
+	ScalarFunctionSet closeness("closeness_centrality");
+	closeness.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::DOUBLE,
+	                                     ClosenessCentralityFunction, CentralityFunctionData::CentralityBind));
+	closeness.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT},
+	                                     LogicalType::DOUBLE, ClosenessCentralityFunction,
+	                                     CentralityFunctionData::CentralityBind));
+	loader.RegisterFunction(closeness);
+
+	ScalarFunctionSet harmonic("harmonic_centrality");
+	harmonic.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::DOUBLE,
+	                                    HarmonicCentralityFunction, CentralityFunctionData::CentralityBind));
+	harmonic.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT},
+	                                    LogicalType::DOUBLE, HarmonicCentralityFunction,
+	                                    CentralityFunctionData::CentralityBind));
+	loader.RegisterFunction(harmonic);
+}
+
+} // namespace duckdb
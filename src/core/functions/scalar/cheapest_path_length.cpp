@@ -10,15 +10,16 @@
 namespace duckdb {
 
 template <typename T, int16_t lane_limit>
-static int16_t InitialiseBellmanFord(const DataChunk &args, int64_t input_size, const UnifiedVectorFormat &vdata_src,
-                                     const int64_t *src_data, idx_t result_size, vector<vector<T>> &dists) {
+static int16_t InitialiseBellmanFord(const CSR &csr, const DataChunk &args, int64_t input_size,
+                                     const UnifiedVectorFormat &vdata_src, const int64_t *src_data, idx_t result_size,
+                                     vector<vector<T>> &dists) {
 	dists.resize(input_size, std::vector<T>(lane_limit, std::numeric_limits<T>::max() / 2));
 
 	int16_t lanes = 0;
 	for (idx_t i = result_size; i < args.size() && lanes < lane_limit; i++) {
 		auto src_index = vdata_src.sel->get_index(i);
 		if (vdata_src.validity.RowIsValid(src_index)) {
-			const int64_t &src_entry = src_data[src_index];
+			auto src_entry = csr.ToInternal(src_data[src_index]);
 			dists[src_entry][lanes] = 0;
 			lanes++;
 		}
@@ -56,7 +57,7 @@ int16_t TemplatedBatchBellmanFord(CSR *csr, DataChunk &args, int64_t input_size,
                                   ValidityMask &result_validity) {
 	vector<vector<T>> dists;
 	int16_t curr_batch_size =
-	    InitialiseBellmanFord<T, lane_limit>(args, input_size, vdata_src, src_data, result_size, dists);
+	    InitialiseBellmanFord<T, lane_limit>(*csr, args, input_size, vdata_src, src_data, result_size, dists);
 	bool changed = true;
 	while (changed) {
 		changed = false;
@@ -75,7 +76,7 @@ int16_t TemplatedBatchBellmanFord(CSR *csr, DataChunk &args, int64_t input_size,
 			result_validity.SetInvalid(i);
 		}
 
-		const auto &target_entry = target_data[target_index];
+		auto target_entry = csr->ToInternal(target_data[target_index]);
 		auto resulting_distance = dists[target_entry][i % lane_limit];
 
 		if (resulting_distance == std::numeric_limits<T>::max() / 2) {
@@ -143,6 +144,8 @@ static void CheapestPathLengthFunction(DataChunk &args, ExpressionState &state,
 
 	// 1. Get the CSR graph representation
 	CSR *csr = duckpgq_state->GetCSR(info.csr_id);
+	ApplyVertexReordering(info.context, *duckpgq_state, *csr);
+	CSRReadGuard read_guard(*csr);
 	auto &src = args.data[2];
 
 	UnifiedVectorFormat vdata_src, vdata_target;
@@ -0,0 +1,111 @@
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/community_detection_function_data.hpp"
+#include "duckpgq/core/utils/community_detection.hpp"
+#include "duckpgq/core/utils/duckpgq_utils.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <duckpgq/core/functions/scalar.hpp>
+
+namespace duckdb {
+
+//! Finds the communities of all vertices with the algorithm info was bound for, once
+static void DetectCommunities(CommunityDetectionFunctionData &info, CSR &csr) {
+	Profiler profiler;
+	profiler.Start();
+	csr.Compact();
+	CSRReadGuard read_guard(csr);
+	auto graph = BuildCommunityGraph(info.context, csr);
+	auto seed = static_cast<uint64_t>(info.seed);
+	if (info.leiden) {
+		info.community = Leiden(info.context, graph, seed, info.resolution, info.max_iterations);
+	} else {
+		info.community = LabelPropagation(info.context, graph, seed, info.max_iterations);
+	}
+	info.modularity = Modularity(info.context, graph, info.community, info.resolution);
+	// ids that do not depend on the seed's choice of representative or on the vertex order
+	auto dictionary = GetDuckPGQState(info.context)->GetRowidDictionary(info.csr_id, csr.VertexCount());
+	LabelComponentsBySmallestRowid(&info.context, &csr, dictionary, info.community);
+	profiler.End();
+	info.runtime_ms = profiler.Elapsed() * 1000;
+}
+
+static void CommunityDetectionFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CommunityDetectionFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		throw ConstraintException("CSR not found. Is the graph populated?");
+	}
+	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
+		throw ConstraintException("Need to initialize CSR before doing %s.", func_expr.function.name);
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	if (!info.state_converged) {
+		std::lock_guard<std::mutex> guard(info.community_lock);
+		if (!info.state_converged) {
+			DetectCommunities(info, csr);
+			info.state_converged = true;
+		}
+	}
+
+	auto &src = args.data[1];
+	UnifiedVectorFormat vdata_src;
+	src.ToUnifiedFormat(args.size(), vdata_src);
+	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto &children = StructVector::GetEntries(result);
+	auto community_data = FlatVector::GetData<int64_t>(*children[0]);
+	auto modularity_data = FlatVector::GetData<double>(*children[1]);
+	auto runtime_data = FlatVector::GetData<double>(*children[2]);
+	for (idx_t n = 0; n < args.size(); n++) {
+		auto src_sel = vdata_src.sel->get_index(n);
+		int64_t src_node = csr.ToInternal(src_data[src_sel]);
+		if (!vdata_src.validity.RowIsValid(src_sel) || src_node < 0 || src_node >= csr.VertexCount()) {
+			FlatVector::SetNull(result, n, true);
+			continue;
+		}
+		community_data[n] = info.community[src_node];
+		modularity_data[n] = info.modularity;
+		runtime_data[n] = info.runtime_ms;
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCommunityDetectionScalarFunctions(ExtensionLoader &loader) {
+	// the same modularity and runtime are repeated on every row
+	auto community_type = LogicalType::STRUCT({{"community", LogicalType::BIGINT},
+	                                           {"modularity", LogicalType::DOUBLE},
+	                                           {"runtime_ms", LogicalType::DOUBLE}});
+	/* 1. CSR ID
+	 * 2. vertex rowid
+	 * 3. seed of the update order and tie breaks
+	 * 4. maximum number of iterations
+	 */
+	loader.RegisterFunction(ScalarFunction("label_propagation",
+	                                       {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                        LogicalType::BIGINT},
+	                                       community_type, CommunityDetectionFunction,
+	                                       CommunityDetectionFunctionData::CommunityDetectionBind));
+	/* 1. CSR ID
+	 * 2. vertex rowid
+	 * 3. seed of the move phases and refinement order
+	 * 4. resolution of the modularity
+	 * 5. maximum number of levels
+	 */
+	loader.RegisterFunction(ScalarFunction("leiden",
+	                                       {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                        LogicalType::DOUBLE, LogicalType::BIGINT},
+	                                       community_type, CommunityDetectionFunction,
+	                                       CommunityDetectionFunctionData::CommunityDetectionBind));
+}
+
+} // namespace duckdb
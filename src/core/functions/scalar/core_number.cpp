@@ -0,0 +1,151 @@
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/core_number_function_data.hpp"
+#include "duckpgq/core/utils/duckpgq_utils.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <duckpgq/core/functions/scalar.hpp>
+
+#include <atomic>
+
+namespace duckdb {
+
+//! Core numbers of an undirected CSR by bucketed peeling. Vertices wait in the bucket of their degree among the
+//! vertices not yet peeled. Level k peels its bucket in parallel rounds: vertices whose degree drops to k join the
+//! next round, those that stay above k move to the bucket of their new degree. Every vertex enters a bucket once
+//! plus once per lost edge, so peeling takes O(V + E).
+static vector<int64_t> ComputeCoreNumbers(ClientContext &context, const CSR &csr) {
+	auto vertex_count = csr.VertexCount();
+	unique_ptr<std::atomic<int64_t>[]> degree(new std::atomic<int64_t>[vertex_count]);
+	unique_ptr<std::atomic<bool>[]> peeled(new std::atomic<bool>[vertex_count]);
+	auto max_degree = TraversalParallelReduce<int64_t>(
+	    &context, vertex_count, 0,
+	    [&](idx_t begin, idx_t end) {
+		    int64_t range_max = 0;
+		    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			    int64_t vertex_degree = 0;
+			    csr.ForEachNeighbor(vertex, [&](int64_t neighbor) { vertex_degree += neighbor != vertex; });
+			    degree[vertex].store(vertex_degree, std::memory_order_relaxed);
+			    peeled[vertex].store(false, std::memory_order_relaxed);
+			    range_max = MaxValue(range_max, vertex_degree);
+		    }
+		    return range_max;
+	    },
+	    [](int64_t a, int64_t b) { return MaxValue(a, b); });
+
+	vector<vector<int64_t>> buckets(max_degree + 1);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		buckets[degree[vertex].load(std::memory_order_relaxed)].push_back(vertex);
+	}
+
+	vector<int64_t> core(vertex_count, 0);
+	mutex peel_lock;
+	for (int64_t k = 0; k <= max_degree; k++) {
+		// vertices that dropped below this bucket were peeled at their lower degree already
+		vector<int64_t> frontier;
+		for (auto vertex : buckets[k]) {
+			if (!peeled[vertex].load(std::memory_order_relaxed)) {
+				peeled[vertex].store(true, std::memory_order_relaxed);
+				frontier.push_back(vertex);
+			}
+		}
+		vector<int64_t>().swap(buckets[k]);
+
+		while (!frontier.empty()) {
+			vector<int64_t> next_frontier;
+			TraversalParallelFor(&context, frontier.size(), [&](idx_t begin, idx_t end) {
+				vector<int64_t> range_frontier;
+				vector<std::pair<int64_t, int64_t>> range_moves;
+				for (auto i = begin; i < end; i++) {
+					auto vertex = frontier[i];
+					core[vertex] = k;
+					csr.ForEachNeighbor(vertex, [&](int64_t neighbor) {
+						if (neighbor == vertex || peeled[neighbor].load(std::memory_order_relaxed)) {
+							return;
+						}
+						// the degree of a vertex never drops below the level it is peeled at
+						auto neighbor_degree = degree[neighbor].load(std::memory_order_relaxed);
+						while (neighbor_degree > k &&
+						       !degree[neighbor].compare_exchange_weak(neighbor_degree, neighbor_degree - 1,
+						                                               std::memory_order_relaxed)) {
+						}
+						if (neighbor_degree <= k) {
+							return;
+						}
+						if (neighbor_degree - 1 > k) {
+							range_moves.emplace_back(neighbor_degree - 1, neighbor);
+						} else if (!peeled[neighbor].exchange(true, std::memory_order_relaxed)) {
+							range_frontier.push_back(neighbor);
+						}
+					});
+				}
+				lock_guard<mutex> guard(peel_lock);
+				next_frontier.insert(next_frontier.end(), range_frontier.begin(), range_frontier.end());
+				for (auto &move : range_moves) {
+					buckets[move.first].push_back(move.second);
+				}
+			});
+			frontier = std::move(next_frontier);
+		}
+	}
+	return core;
+}
+
+static void CoreNumberFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CoreNumberFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		throw ConstraintException("CSR not found. Is the graph populated?");
+	}
+	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
+		throw ConstraintException("Need to initialize CSR before doing core number.");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	if (!info.state_converged) {
+		std::lock_guard<std::mutex> guard(info.core_lock);
+		if (!info.state_converged) {
+			csr.Compact();
+			CSRReadGuard read_guard(csr);
+			info.core = ComputeCoreNumbers(info.context, csr);
+			info.state_converged = true;
+		}
+	}
+
+	auto &src = args.data[1];
+	UnifiedVectorFormat vdata_src;
+	src.ToUnifiedFormat(args.size(), vdata_src);
+	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<int64_t>(result);
+	ValidityMask &result_validity = FlatVector::Validity(result);
+
+	for (idx_t n = 0; n < args.size(); n++) {
+		auto src_sel = vdata_src.sel->get_index(n);
+		int64_t src_node = csr.ToInternal(src_data[src_sel]);
+		if (!vdata_src.validity.RowIsValid(src_sel) || src_node < 0 || src_node >= csr.VertexCount()) {
+			result_validity.SetInvalid(n);
+			continue;
+		}
+		result_data[n] = info.core[src_node];
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCoreNumberScalarFunction(ExtensionLoader &loader) {
+	/* 1. CSR ID, of an undirected CSR
+	 * 2. vertex rowid
+	 */
+	loader.RegisterFunction(ScalarFunction("core_number", {LogicalType::INTEGER, LogicalType::BIGINT},
+	                                       LogicalType::BIGINT, CoreNumberFunction,
+	                                       CoreNumberFunctionData::CoreNumberBind));
+}
+
+} // namespace duckdb
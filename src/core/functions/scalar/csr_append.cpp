@@ -0,0 +1,117 @@
+#include "duckdb/common/vector_operations/quaternary_executor.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq_extension.hpp>
+
+namespace duckdb {
+
+static void CsrAppendEdgeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	CSR *csr = duckpgq_state->GetCSR(info.id);
+	if (!csr->initialized_e) {
+		throw ConstraintException("Need to initialize CSR before appending edges");
+	}
+
+	if (args.ColumnCount() == 4) {
+		TernaryExecutor::Execute<int64_t, int64_t, int64_t, int64_t>(
+		    args.data[1], args.data[2], args.data[3], result, args.size(),
+		    [&](int64_t src, int64_t dst, int64_t edge_id) { return (int64_t)csr->AppendEdge(src, dst, edge_id); });
+		return;
+	}
+	if (args.data[4].GetType().InternalType() == PhysicalType::INT64) {
+		QuaternaryExecutor::Execute<int64_t, int64_t, int64_t, int64_t, int64_t>(
+		    args.data[1], args.data[2], args.data[3], args.data[4], result, args.size(),
+		    [&](int64_t src, int64_t dst, int64_t edge_id, int64_t weight) {
+			    return (int64_t)csr->AppendEdge(src, dst, edge_id, weight, 0);
+		    });
+		return;
+	}
+	QuaternaryExecutor::Execute<int64_t, int64_t, int64_t, double_t, int64_t>(
+	    args.data[1], args.data[2], args.data[3], args.data[4], result, args.size(),
+	    [&](int64_t src, int64_t dst, int64_t edge_id, double_t weight) {
+		    return (int64_t)csr->AppendEdge(src, dst, edge_id, 0, weight);
+	    });
+}
+
+static void CsrCompactFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	CSR *csr = duckpgq_state->GetCSR(info.id);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int64_t>(result);
+	result_data[0] = static_cast<int64_t>(csr->Compact());
+}
+
+static void CsrReorderFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	CSR *csr = duckpgq_state->GetCSR(info.id);
+	if (!csr->initialized_e) {
+		throw ConstraintException("Need to initialize CSR before reordering it");
+	}
+	auto method = ParseCSRReorderMethod(args.data[1].GetValue(0).ToString());
+	{
+		lock_guard<mutex> csr_reorder_lock(duckpgq_state->csr_lock);
+		csr->Reorder(method);
+		// an explicit reorder takes precedence over the duckpgq_vertex_reordering setting
+		csr->reorder_checked = true;
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<bool>(result);
+	result_data[0] = true;
+}
+
+ScalarFunctionSet GetCSRAppendEdgeFunction() {
+	ScalarFunctionSet set("csr_append_edge");
+	/* 1. CSR ID
+	 * 2. source rowid
+	 * 3. destination rowid
+	 * 4. edge rowid
+	 * 5. <optional> edge weight (INT OR DOUBLE)
+	 */
+	set.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT},
+	                               LogicalType::BIGINT, CsrAppendEdgeFunction, CSRFunctionData::CSRBind));
+	set.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                LogicalType::BIGINT},
+	                               LogicalType::BIGINT, CsrAppendEdgeFunction, CSRFunctionData::CSRBind));
+	set.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                LogicalType::DOUBLE},
+	                               LogicalType::BIGINT, CsrAppendEdgeFunction, CSRFunctionData::CSRBind));
+	for (auto &function : set.functions) {
+		function.stability = FunctionStability::VOLATILE;
+	}
+	return set;
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCSRAppendScalarFunctions(ExtensionLoader &loader) {
+	loader.RegisterFunction(GetCSRAppendEdgeFunction());
+
+	ScalarFunction compact("csr_compact", {LogicalType::INTEGER}, LogicalType::BIGINT, CsrCompactFunction,
+	                       CSRFunctionData::CSRBind);
+	compact.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(compact);
+
+	/* 1. CSR ID
+	 * 2. Reordering method: none, degree or rcm
+	 */
+	ScalarFunction reorder("csr_reorder", {LogicalType::INTEGER, LogicalType::VARCHAR}, LogicalType::BOOLEAN,
+	                       CsrReorderFunction, CSRFunctionData::CSRBind);
+	reorder.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(reorder);
+}
+
+} // namespace duckdb
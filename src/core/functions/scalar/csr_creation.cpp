@@ -40,7 +40,8 @@ static void CsrInitializeVertex(DuckPGQState &context, int32_t id, int64_t v_siz
 	}
 }
 
-static void CsrInitializeEdge(DuckPGQState &context, int32_t id, int64_t v_size, int64_t e_size) {
+static void CsrInitializeEdge(DuckPGQState &context, int32_t id, int64_t v_size, int64_t e_size,
+                              bool with_labels = false) {
 	const lock_guard<mutex> csr_init_lock(context.csr_lock);
 
 	auto csr_entry = context.csr_list.find(id);
@@ -50,6 +51,10 @@ static void CsrInitializeEdge(DuckPGQState &context, int32_t id, int64_t v_size,
 	try {
 		csr_entry->second->e.resize(e_size, 0);
 		csr_entry->second->edge_ids.resize(e_size, 0);
+		if (with_labels) {
+			csr_entry->second->edge_labels.resize(e_size, 0);
+			csr_entry->second->initialized_labels = true;
+		}
 	} catch (std::bad_alloc const &) {
 		throw Exception(ExceptionType::INTERNAL, "Unable to initialize vector of size for csr edge table "
 		                                         "representation");
@@ -167,6 +172,98 @@ static void CreateCsrEdgeFunction(DataChunk &args, ExpressionState &state, Vecto
 	    });
 }
 
+static void CreateCsrEdgeLabeledFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context, true);
+
+	int64_t vertex_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	int64_t edge_size = args.data[2].GetValue(0).GetValue<int64_t>();
+	int64_t edge_size_count = args.data[3].GetValue(0).GetValue<int64_t>();
+	if (edge_size != edge_size_count) {
+		duckpgq_state->csr_to_delete.insert(info.id);
+		throw ConstraintException("Non-existent/non-unique vertices detected. Make sure all "
+		                          "vertices referred by edge tables exist and are unique for path-finding queries.");
+	}
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.id);
+	if (!csr_entry->second->initialized_e) {
+		CsrInitializeEdge(*duckpgq_state, info.id, vertex_size, edge_size, true);
+	}
+	auto &csr = *csr_entry->second;
+	QuaternaryExecutor::Execute<int64_t, int64_t, int64_t, int32_t, int32_t>(
+	    args.data[4], args.data[5], args.data[6], args.data[7], result, args.size(),
+	    [&](int64_t src, int64_t dst, int64_t edge_id, int32_t label) {
+		    if (label < 0 || label >= CSR_MAX_EDGE_LABELS) {
+			    throw ConstraintException("Edge label %d is outside of the supported range [0, %d)", label,
+			                              CSR_MAX_EDGE_LABELS);
+		    }
+		    auto pos = ++csr.v[src + 1];
+		    csr.e[(int64_t)pos - 1] = dst;
+		    csr.edge_ids[(int64_t)pos - 1] = edge_id;
+		    csr.edge_labels[(int64_t)pos - 1] = static_cast<uint8_t>(label);
+		    return 1;
+	    });
+}
+
+static void CreateCsrVertexSymmetricFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t input_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	auto csr_entry = duckpgq_state->csr_list.find(info.id);
+
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_v) {
+		CsrInitializeVertex(*duckpgq_state, info.id, input_size);
+		csr_entry = duckpgq_state->csr_list.find(info.id);
+	}
+
+	// every edge adds one to the degree of both endpoints, a self-loop is only stored once
+	BinaryExecutor::Execute<int64_t, int64_t, int64_t>(args.data[2], args.data[3], result, args.size(),
+	                                                   [&](int64_t src, int64_t dst) {
+		                                                   csr_entry->second->v[src + 2]++;
+		                                                   if (src == dst) {
+			                                                   return (int64_t)1;
+		                                                   }
+		                                                   csr_entry->second->v[dst + 2]++;
+		                                                   return (int64_t)2;
+	                                                   });
+}
+
+static void CreateCsrEdgeSymmetricFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context, true);
+
+	int64_t vertex_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	int64_t edge_size = args.data[2].GetValue(0).GetValue<int64_t>();
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		throw ConstraintException("Need to compute the symmetric vertex degrees before building the CSR edges");
+	}
+	if (!csr_entry->second->initialized_e) {
+		CsrInitializeEdge(*duckpgq_state, info.id, vertex_size, edge_size);
+	}
+	auto &csr = *csr_entry->second;
+	csr.symmetric = true;
+	TernaryExecutor::Execute<int64_t, int64_t, int64_t, int32_t>(
+	    args.data[3], args.data[4], args.data[5], result, args.size(), [&](int64_t src, int64_t dst, int64_t edge_id) {
+		    auto pos = ++csr.v[src + 1];
+		    csr.e[(int64_t)pos - 1] = dst;
+		    csr.edge_ids[(int64_t)pos - 1] = edge_id;
+		    if (src != dst) {
+			    pos = ++csr.v[dst + 1];
+			    csr.e[(int64_t)pos - 1] = src;
+			    csr.edge_ids[(int64_t)pos - 1] = edge_id;
+		    }
+		    return 1;
+	    });
+}
+
 ScalarFunctionSet GetCSRVertexFunction() {
 	ScalarFunctionSet set("create_csr_vertex");
 
@@ -213,6 +310,44 @@ ScalarFunctionSet GetCSREdgeFunction() {
 void CoreScalarFunctions::RegisterCSRCreationScalarFunctions(ExtensionLoader &loader) {
 	loader.RegisterFunction(GetCSREdgeFunction());
 	loader.RegisterFunction(GetCSRVertexFunction());
+
+	/* 1. CSR ID
+	 * 2. Vertex size, over all vertex tables
+	 * 3. Sum of the edges (assuming all unique vertices)
+	 * 4. Edge size (to ensure all vertices are unique this should equal point 3)
+	 * 5. source dense id
+	 * 6. destination dense id
+	 * 7. edge rowid
+	 * 8. edge label, the bit checked in the label mask of the traversal
+	 */
+	loader.RegisterFunction(ScalarFunction("create_csr_edge_labeled",
+	                                       {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                        LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                        LogicalType::BIGINT, LogicalType::INTEGER},
+	                                       LogicalType::INTEGER, CreateCsrEdgeLabeledFunction, CSRFunctionData::CSRBind));
+
+	/* 1. CSR ID
+	 * 2. Vertex size
+	 * 3. source rowid
+	 * 4. destination rowid
+	 */
+	loader.RegisterFunction(ScalarFunction(
+	    "create_csr_vertex_symmetric",
+	    {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT}, LogicalType::BIGINT,
+	    CreateCsrVertexSymmetricFunction, CSRFunctionData::CSRVertexBind));
+
+	/* 1. CSR ID
+	 * 2. Vertex size
+	 * 3. Sum of create_csr_vertex_symmetric, the number of directed edges in the CSR
+	 * 4. source rowid
+	 * 5. destination rowid
+	 * 6. edge rowid, stored for both directions
+	 */
+	loader.RegisterFunction(ScalarFunction("create_csr_edge_symmetric",
+	                                       {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                        LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT},
+	                                       LogicalType::INTEGER, CreateCsrEdgeSymmetricFunction,
+	                                       CSRFunctionData::CSREdgeBind));
 }
 
 } // namespace duckdb
@@ -0,0 +1,66 @@
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq_extension.hpp>
+
+namespace duckdb {
+
+static void CsrEdgePropertyFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	CSR *csr = duckpgq_state->GetCSR(info.id);
+	auto name = args.data[1].GetValue(0).ToString();
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<bool>(result);
+	lock_guard<mutex> guard(csr->property_lock);
+	csr->SetEdgeProperty(name, args.data[2], args.data[3], args.size(), result_data);
+}
+
+static void CsrTemporalIndexFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	CSR *csr = duckpgq_state->GetCSR(info.id);
+	auto property = args.data[1].GetValue(0).ToString();
+	{
+		lock_guard<mutex> csr_index_lock(duckpgq_state->csr_lock);
+		lock_guard<mutex> guard(csr->property_lock);
+		csr->BuildTemporalIndex(property);
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<bool>(result);
+	result_data[0] = true;
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCSREdgePropertyScalarFunction(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. Property name
+	 * 3. edge rowid
+	 * 4. property value
+	 * Returns whether the edge rowid is part of the CSR
+	 */
+	ScalarFunction edge_property("csr_edge_property",
+	                             {LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::ANY},
+	                             LogicalType::BOOLEAN, CsrEdgePropertyFunction, CSRFunctionData::CSRBind);
+	edge_property.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(edge_property);
+
+	/* 1. CSR ID
+	 * 2. Integral edge property holding the edge time
+	 */
+	ScalarFunction temporal_index("csr_temporal_index", {LogicalType::INTEGER, LogicalType::VARCHAR},
+	                              LogicalType::BOOLEAN, CsrTemporalIndexFunction, CSRFunctionData::CSRBind);
+	temporal_index.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(temporal_index);
+}
+
+} // namespace duckdb
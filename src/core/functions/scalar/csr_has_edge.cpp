@@ -0,0 +1,42 @@
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq_extension.hpp>
+
+namespace duckdb {
+
+static void CsrHasEdgeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	CSR *csr = duckpgq_state->GetCSR(info.id);
+	if (!csr->initialized_e) {
+		throw ConstraintException("Need to initialize CSR before checking for edges");
+	}
+	ApplyVertexReordering(info.context, *duckpgq_state, *csr);
+	ApplyHubRows(info.context, *duckpgq_state, *csr);
+	CSRReadGuard read_guard(*csr);
+
+	BinaryExecutor::Execute<int64_t, int64_t, bool>(
+	    args.data[1], args.data[2], result, args.size(),
+	    [&](int64_t src, int64_t dst) { return csr->HasEdge(csr->ToInternal(src), csr->ToInternal(dst)); });
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCSRHasEdgeScalarFunction(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. source rowid
+	 * 3. destination rowid
+	 */
+	ScalarFunction has_edge("csr_has_edge", {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT},
+	                        LogicalType::BOOLEAN, CsrHasEdgeFunction, CSRFunctionData::CSRBind);
+	has_edge.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(has_edge);
+}
+
+} // namespace duckdb
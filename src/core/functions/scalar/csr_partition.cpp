@@ -0,0 +1,221 @@
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq_extension.hpp>
+
+namespace duckdb {
+
+static int64_t GetEdgesPerPartition(DataChunk &args, idx_t column) {
+	int64_t edges_per_partition = DEFAULT_CSR_PARTITION_EDGES;
+	if (args.ColumnCount() > column) {
+		edges_per_partition = args.data[column].GetValue(0).GetValue<int64_t>();
+	}
+	if (edges_per_partition <= 0) {
+		throw InvalidInputException("Edges per partition must be positive, got %d", edges_per_partition);
+	}
+	return edges_per_partition;
+}
+
+static void CsrPartitionFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	auto edges_per_partition = GetEdgesPerPartition(args, 1);
+
+	// a later chunk of the query that partitioned this CSR reuses its partitions
+	auto find_partitions = [&]() -> PartitionedCSR * {
+		auto partitioned_entry = duckpgq_state->partitioned_csr_list.find(info.id);
+		if (partitioned_entry == duckpgq_state->partitioned_csr_list.end() ||
+		    !duckpgq_state->csr_to_delete.count(info.id)) {
+			return nullptr;
+		}
+		return partitioned_entry->second.get();
+	};
+	idx_t partition_count = 0;
+	{
+		lock_guard<mutex> csr_index_lock(duckpgq_state->csr_lock);
+		auto partitioned = find_partitions();
+		if (partitioned) {
+			partition_count = partitioned->PartitionCount();
+		}
+	}
+	if (partition_count == 0) {
+		CSR *csr = duckpgq_state->GetCSR(info.id);
+		if (!(csr->initialized_v && csr->initialized_e)) {
+			throw ConstraintException("Need to initialize CSR before partitioning it");
+		}
+		ApplyVertexReordering(info.context, *duckpgq_state, *csr);
+		csr->Compact();
+
+		lock_guard<mutex> csr_index_lock(duckpgq_state->csr_lock);
+		auto existing = find_partitions();
+		if (existing) {
+			partition_count = existing->PartitionCount();
+		} else {
+			unique_ptr<PartitionedCSR> partitioned;
+			{
+				CSRReadGuard read_guard(*csr);
+				partitioned = make_uniq<PartitionedCSR>(BufferManager::GetBufferManager(info.context), *csr,
+				                                        static_cast<idx_t>(edges_per_partition));
+			}
+			partition_count = partitioned->PartitionCount();
+			duckpgq_state->partitioned_csr_list[info.id] = std::move(partitioned);
+			// the edges now live in the partitions, the in-memory copy is dropped at the end of this query once
+			// nothing in it reads the CSR anymore
+			duckpgq_state->csr_to_delete.insert(info.id);
+		}
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int64_t>(result);
+	result_data[0] = static_cast<int64_t>(partition_count);
+}
+
+//! Lays out the partitions on the first call, from the out-degrees that create_csr_vertex stored under the same id
+static PartitionedCSR &GetPartitionsToFill(ClientContext &context, DuckPGQState &duckpgq_state, int32_t id,
+                                           int64_t vertex_size, idx_t edges_per_partition) {
+	lock_guard<mutex> csr_index_lock(duckpgq_state.csr_lock);
+	auto partitioned_entry = duckpgq_state.partitioned_csr_list.find(id);
+	if (partitioned_entry != duckpgq_state.partitioned_csr_list.end()) {
+		if (partitioned_entry->second->IsComplete()) {
+			throw ConstraintException("A partitioned CSR with ID %d already exists", id);
+		}
+		return *partitioned_entry->second;
+	}
+	auto csr_entry = duckpgq_state.csr_list.find(id);
+	if (csr_entry == duckpgq_state.csr_list.end() || !csr_entry->second->initialized_v) {
+		throw ConstraintException("Need to compute the vertex degrees with create_csr_vertex before streaming the edges");
+	}
+	auto &degree_csr = *csr_entry->second;
+	if (vertex_size < 0 || static_cast<idx_t>(vertex_size) + 2 > degree_csr.vsize) {
+		throw ConstraintException("Vertex size %d does not match the %d vertex degrees of CSR %d", vertex_size,
+		                          degree_csr.vsize - 2, id);
+	}
+	vector<int64_t> degrees(vertex_size);
+	for (int64_t i = 0; i < vertex_size; i++) {
+		degrees[i] = degree_csr.v[i + 2];
+	}
+	auto partitioned =
+	    make_uniq<PartitionedCSR>(BufferManager::GetBufferManager(context), degrees, edges_per_partition);
+	auto &result = *partitioned;
+	duckpgq_state.partitioned_csr_list[id] = std::move(partitioned);
+	// the degrees are no longer needed, nothing reads a CSR without edges
+	duckpgq_state.csr_to_delete.insert(id);
+	return result;
+}
+
+static void CreateCsrPartitionedEdgeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context, true);
+
+	int64_t vertex_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	int64_t edge_size = args.data[2].GetValue(0).GetValue<int64_t>();
+	int64_t edge_size_count = args.data[3].GetValue(0).GetValue<int64_t>();
+	if (edge_size != edge_size_count) {
+		duckpgq_state->csr_to_delete.insert(info.id);
+		throw ConstraintException("Non-existent/non-unique vertices detected. Make sure all "
+		                          "vertices referred by edge tables exist and are unique for path-finding queries.");
+	}
+	auto edges_per_partition = GetEdgesPerPartition(args, 6);
+	auto &partitioned = GetPartitionsToFill(info.context, *duckpgq_state, info.id, vertex_size,
+	                                        static_cast<idx_t>(edges_per_partition));
+
+	// gather the chunk so the partitions are filled in batches, the edges never exist as a whole in memory
+	UnifiedVectorFormat src_data, dst_data;
+	args.data[4].ToUnifiedFormat(args.size(), src_data);
+	args.data[5].ToUnifiedFormat(args.size(), dst_data);
+	auto src_values = UnifiedVectorFormat::GetData<int64_t>(src_data);
+	auto dst_values = UnifiedVectorFormat::GetData<int64_t>(dst_data);
+	vector<int64_t> src(args.size());
+	vector<int64_t> dst(args.size());
+	for (idx_t i = 0; i < args.size(); i++) {
+		auto src_index = src_data.sel->get_index(i);
+		auto dst_index = dst_data.sel->get_index(i);
+		if (!src_data.validity.RowIsValid(src_index) || !dst_data.validity.RowIsValid(dst_index)) {
+			throw ConstraintException("Edges of a partitioned CSR need a source and a destination");
+		}
+		src[i] = src_values[src_index];
+		dst[i] = dst_values[dst_index];
+	}
+	partitioned.AppendEdges(src.data(), dst.data(), args.size());
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int32_t>(result);
+	result_data[0] = 1;
+}
+
+static void DeletePartitionedCsrFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	idx_t flag = 0;
+	{
+		lock_guard<mutex> csr_index_lock(duckpgq_state->csr_lock);
+		auto partitioned_entry = duckpgq_state->partitioned_csr_list.find(info.id);
+		if (partitioned_entry != duckpgq_state->partitioned_csr_list.end()) {
+			// wait for the last reader before freeing the partitions, no new reader can look them up while
+			// csr_lock is held
+			partitioned_entry->second->access_lock.Lock();
+			partitioned_entry->second->access_lock.Unlock();
+			duckpgq_state->partitioned_csr_list.erase(partitioned_entry);
+			flag = 1;
+		}
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<bool>(result);
+	result_data[0] = flag == 1;
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterCSRPartitionScalarFunctions(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. Maximum number of edges in a partition (optional)
+	 */
+	ScalarFunctionSet partition_set("csr_partition");
+	partition_set.AddFunction(
+	    ScalarFunction({LogicalType::INTEGER}, LogicalType::BIGINT, CsrPartitionFunction, CSRFunctionData::CSRBind));
+	partition_set.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::BIGINT,
+	                                         CsrPartitionFunction, CSRFunctionData::CSRBind));
+	for (auto &function : partition_set.functions) {
+		function.stability = FunctionStability::VOLATILE;
+	}
+	loader.RegisterFunction(partition_set);
+
+	/* 1. CSR ID, holding the out-degrees computed by create_csr_vertex
+	 * 2. Vertex size
+	 * 3. Sum of the edges (assuming all unique vertices)
+	 * 4. Edge size (to ensure all vertices are unique this should equal point 3)
+	 * 5. source rowid
+	 * 6. destination rowid
+	 * 7. Maximum number of edges in a partition (optional)
+	 */
+	ScalarFunctionSet partitioned_edge_set("create_csr_partitioned_edge");
+	partitioned_edge_set.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT,
+	                                                 LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT},
+	                                                LogicalType::INTEGER, CreateCsrPartitionedEdgeFunction,
+	                                                CSRFunctionData::CSRBind));
+	partitioned_edge_set.AddFunction(ScalarFunction(
+	    {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+	     LogicalType::BIGINT, LogicalType::BIGINT},
+	    LogicalType::INTEGER, CreateCsrPartitionedEdgeFunction, CSRFunctionData::CSRBind));
+	for (auto &function : partitioned_edge_set.functions) {
+		function.stability = FunctionStability::VOLATILE;
+	}
+	loader.RegisterFunction(partitioned_edge_set);
+
+	ScalarFunction drop("delete_partitioned_csr", {LogicalType::INTEGER}, LogicalType::BOOLEAN,
+	                    DeletePartitionedCsrFunction, CSRFunctionData::CSRBind);
+	drop.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(drop);
+}
+
+} // namespace duckdb
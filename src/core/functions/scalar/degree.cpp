@@ -0,0 +1,95 @@
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/duckpgq_utils.hpp"
+
+#include <duckpgq/core/functions/scalar.hpp>
+
+namespace duckdb {
+
+//! Writes degree(csr, vertex) for every row whose rowid is a vertex of the CSR, NULL otherwise. The degrees are
+//! differences of the offsets of the CSR and its transpose, so a cached CSR answers without touching the edges.
+template <class DEGREE>
+static void ExecuteDegree(DataChunk &args, ExpressionState &state, Vector &result, bool needs_transpose,
+                          DEGREE &&degree) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		throw ConstraintException("CSR not found. Is the graph populated?");
+	}
+	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
+		throw ConstraintException("Need to initialize CSR before computing degrees.");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	// appended edges only show up in the offsets once they are merged
+	csr.Compact();
+	CSRReadGuard read_guard(csr);
+	// a symmetric CSR stores every edge in both directions, its in-degrees are its out-degrees
+	auto transpose = needs_transpose && !csr.symmetric ? &csr.GetTranspose() : nullptr;
+
+	auto &src = args.data[1];
+	UnifiedVectorFormat vdata_src;
+	src.ToUnifiedFormat(args.size(), vdata_src);
+	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<int64_t>(result);
+	ValidityMask &result_validity = FlatVector::Validity(result);
+
+	for (idx_t n = 0; n < args.size(); n++) {
+		auto src_sel = vdata_src.sel->get_index(n);
+		int64_t src_node = csr.ToInternal(src_data[src_sel]);
+		if (!vdata_src.validity.RowIsValid(src_sel) || src_node < 0 || src_node >= csr.VertexCount()) {
+			result_validity.SetInvalid(n);
+			continue;
+		}
+		result_data[n] = degree(csr, transpose, src_node);
+	}
+}
+
+static void OutDegreeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteDegree(args, state, result, false,
+	              [](const CSR &csr, const CSRTranspose *, int64_t vertex) { return csr.Degree(vertex); });
+}
+
+static void InDegreeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteDegree(args, state, result, true, [](const CSR &csr, const CSRTranspose *transpose, int64_t vertex) {
+		return transpose ? transpose->Degree(vertex) : csr.Degree(vertex);
+	});
+}
+
+static void DegreeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteDegree(args, state, result, true, [](const CSR &csr, const CSRTranspose *transpose, int64_t vertex) {
+		return transpose ? transpose->Degree(vertex) + csr.Degree(vertex) : csr.Degree(vertex);
+	});
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterDegreeScalarFunctions(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. vertex rowid
+	 */
+	ScalarFunction out_degree("out_degree", {LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::BIGINT,
+	                          OutDegreeFunction, CSRFunctionData::CSRBind);
+	out_degree.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(out_degree);
+
+	// Edges into the vertex
+	ScalarFunction in_degree("in_degree", {LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::BIGINT,
+	                         InDegreeFunction, CSRFunctionData::CSRBind);
+	in_degree.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(in_degree);
+
+	// Edges into and out of the vertex, the neighbours of a symmetric CSR
+	ScalarFunction degree("degree", {LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::BIGINT, DegreeFunction,
+	                      CSRFunctionData::CSRBind);
+	degree.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(degree);
+}
+
+} // namespace duckdb
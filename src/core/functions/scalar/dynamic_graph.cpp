@@ -0,0 +1,120 @@
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq_extension.hpp>
+
+namespace duckdb {
+
+static DynamicGraph &GetDynamicGraphOrThrow(DuckPGQState &duckpgq_state, int32_t id) {
+	auto dynamic_graph = duckpgq_state.GetDynamicGraph(id);
+	if (!dynamic_graph) {
+		throw ConstraintException("Dynamic graph not found with ID %d", id);
+	}
+	return *dynamic_graph;
+}
+
+static void CreateDynamicGraphFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	if (v_size < 0) {
+		throw ConstraintException("Dynamic graph needs a non-negative vertex count, got %d", v_size);
+	}
+	{
+		lock_guard<mutex> csr_init_lock(duckpgq_state->csr_lock);
+		auto &entry = duckpgq_state->dynamic_graph_list[info.id];
+		if (entry) {
+			// wait for the last traversal of the graph that is replaced
+			entry->access_lock.Lock();
+			entry->access_lock.Unlock();
+		}
+		entry = make_uniq<DynamicGraph>(v_size);
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<bool>(result);
+	result_data[0] = true;
+}
+
+static void DynamicGraphInsertEdgeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	auto &graph = GetDynamicGraphOrThrow(*duckpgq_state, info.id);
+
+	CSRWriteGuard guard(graph.access_lock);
+	BinaryExecutor::Execute<int64_t, int64_t, bool>(args.data[1], args.data[2], result, args.size(),
+	                                                [&](int64_t src, int64_t dst) {
+		                                                graph.InsertEdge(src, dst);
+		                                                return true;
+	                                                });
+}
+
+static void DynamicGraphDeleteEdgeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	auto &graph = GetDynamicGraphOrThrow(*duckpgq_state, info.id);
+
+	CSRWriteGuard guard(graph.access_lock);
+	BinaryExecutor::Execute<int64_t, int64_t, bool>(
+	    args.data[1], args.data[2], result, args.size(),
+	    [&](int64_t src, int64_t dst) { return graph.DeleteEdge(src, dst); });
+}
+
+static void DeleteDynamicGraphFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	idx_t flag = 0;
+	{
+		lock_guard<mutex> csr_init_lock(duckpgq_state->csr_lock);
+		auto graph_entry = duckpgq_state->dynamic_graph_list.find(info.id);
+		if (graph_entry != duckpgq_state->dynamic_graph_list.end()) {
+			// wait for the last traversal before freeing the graph, no new one can look it up while csr_lock is held
+			graph_entry->second->access_lock.Lock();
+			graph_entry->second->access_lock.Unlock();
+			duckpgq_state->dynamic_graph_list.erase(graph_entry);
+			flag = 1;
+		}
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<bool>(result);
+	result_data[0] = flag == 1;
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterDynamicGraphScalarFunctions(ExtensionLoader &loader) {
+	/* 1. Graph ID
+	 * 2. Vertex count
+	 */
+	ScalarFunction create("create_dynamic_graph", {LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::BOOLEAN,
+	                      CreateDynamicGraphFunction, CSRFunctionData::CSRBind);
+	/* 1. Graph ID
+	 * 2. source rowid
+	 * 3. destination rowid
+	 */
+	ScalarFunction insert_edge("dynamic_graph_insert_edge",
+	                           {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT}, LogicalType::BOOLEAN,
+	                           DynamicGraphInsertEdgeFunction, CSRFunctionData::CSRBind);
+	ScalarFunction delete_edge("dynamic_graph_delete_edge",
+	                           {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT}, LogicalType::BOOLEAN,
+	                           DynamicGraphDeleteEdgeFunction, CSRFunctionData::CSRBind);
+	ScalarFunction drop("delete_dynamic_graph", {LogicalType::INTEGER}, LogicalType::BOOLEAN,
+	                    DeleteDynamicGraphFunction, CSRFunctionData::CSRBind);
+	for (auto function : {&create, &insert_edge, &delete_edge, &drop}) {
+		function->stability = FunctionStability::VOLATILE;
+		loader.RegisterFunction(*function);
+	}
+}
+
+} // namespace duckdb
@@ -2,60 +2,19 @@
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/edge_filter_function_data.hpp"
 #include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
 
 #include <duckpgq/core/functions/scalar.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
 
 namespace duckdb {
 
-static bool IterativeLength(int64_t v_size, int64_t *v, vector<int64_t> &e, vector<std::bitset<LANE_LIMIT>> &seen,
-                            vector<std::bitset<LANE_LIMIT>> &visit, vector<std::bitset<LANE_LIMIT>> &next) {
-	bool change = false;
-	for (auto i = 0; i < v_size; i++) {
-		next[i] = 0;
-	}
-	for (auto i = 0; i < v_size; i++) {
-		if (visit[i].any()) {
-			for (auto offset = v[i]; offset < v[i + 1]; offset++) {
-				auto n = e[offset];
-				next[n] = next[n] | visit[i];
-			}
-		}
-	}
-	for (auto i = 0; i < v_size; i++) {
-		next[i] = next[i] & ~seen[i];
-		seen[i] = seen[i] | next[i];
-		change |= next[i].any();
-	}
-	return change;
-}
-
-static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
-	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
-	auto duckpgq_state = GetDuckPGQState(info.context);
-
-	D_ASSERT(duckpgq_state->csr_list[info.csr_id]);
-
-	if (info.csr_id + 1 > duckpgq_state->csr_list.size()) {
-		throw ConstraintException("Invalid ID");
-	}
-	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
-	if (csr_entry == duckpgq_state->csr_list.end()) {
-		throw ConstraintException("Need to initialize CSR before doing shortest path");
-	}
-
-	if (!csr_entry->second->initialized_v) {
-		throw ConstraintException("Need to initialize CSR before doing shortest path");
-	}
-	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
-	int64_t *v = reinterpret_cast<int64_t *>(duckpgq_state->csr_list[info.csr_id]->v);
-	vector<int64_t> &e = duckpgq_state->csr_list[info.csr_id]->e;
-
+template <class GRAPH>
+static void IterativeLengthSearch(const GRAPH &graph, const TraversalOptions<GRAPH> &options, int64_t v_size,
+                                  DataChunk &args, Vector &src, Vector &dst, Vector &result) {
 	// get src and dst vectors for searches
-	auto &src = args.data[2];
-	auto &dst = args.data[3];
 	UnifiedVectorFormat vdata_src;
 	UnifiedVectorFormat vdata_dst;
 	src.ToUnifiedFormat(args.size(), vdata_src);
@@ -69,10 +28,7 @@ static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vec
 	result.SetVectorType(VectorType::FLAT_VECTOR);
 	auto result_data = FlatVector::GetData<int64_t>(result);
 
-	// create temp SIMD arrays
-	vector<std::bitset<LANE_LIMIT>> seen(v_size);
-	vector<std::bitset<LANE_LIMIT>> visit1(v_size);
-	vector<std::bitset<LANE_LIMIT>> visit2(v_size);
+	LaneBfs bfs(v_size);
 
 	// maps lane to search number
 	int64_t lane_to_num[LANE_LIMIT];
@@ -82,12 +38,7 @@ static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vec
 
 	int64_t started_searches = 0;
 	while (started_searches < args.size()) {
-
-		// empty visit vectors
-		for (auto i = 0; i < v_size; i++) {
-			seen[i] = 0;
-			visit1[i] = 0;
-		}
+		bfs.Reset();
 
 		// add search jobs to free lanes
 		uint64_t active = 0;
@@ -103,7 +54,7 @@ static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vec
 				} else if (src_data[src_pos] == dst_data[dst_pos]) {
 					result_data[search_num] = 0; // path of length 0 does not require a search
 				} else {
-					visit1[src_data[src_pos]][lane] = true;
+					bfs.AddSource(graph.ToInternal(src_data[src_pos]), lane, false);
 					lane_to_num[lane] = search_num; // active lane
 					active++;
 					break;
@@ -113,7 +64,7 @@ static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vec
 
 		// make passes while a lane is still active
 		for (int64_t iter = 1; active; iter++) {
-			if (!IterativeLength(v_size, v, e, seen, (iter & 1) ? visit1 : visit2, (iter & 1) ? visit2 : visit1)) {
+			if (!bfs.Step(graph, options)) {
 				break;
 			}
 			// detect lanes that finished
@@ -121,7 +72,7 @@ static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vec
 				int64_t search_num = lane_to_num[lane];
 				if (search_num >= 0) { // active lane
 					auto dst_pos = vdata_dst.sel->get_index(search_num);
-					if (seen[dst_data[dst_pos]][lane]) {
+					if (bfs.seen[graph.ToInternal(dst_data[dst_pos])][lane]) {
 						result_data[search_num] = iter; /* found at iter => iter = path length */
 						lane_to_num[lane] = -1;         // mark inactive
 						active--;
@@ -140,6 +91,107 @@ static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vec
 			}
 		}
 	}
+}
+
+static void IterativeLengthFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		auto partitioned_csr = duckpgq_state->GetPartitionedCSR(info.csr_id);
+		if (partitioned_csr) {
+			CSRReadGuard read_guard(partitioned_csr->access_lock);
+			IterativeLengthSearch(*partitioned_csr, TraversalOptions<PartitionedCSR>(), v_size, args, args.data[2],
+			                      args.data[3], result);
+			return;
+		}
+		auto dynamic_graph = duckpgq_state->GetDynamicGraph(info.csr_id);
+		if (!dynamic_graph) {
+			throw ConstraintException("Need to initialize CSR before doing shortest path");
+		}
+		CSRReadGuard read_guard(dynamic_graph->access_lock);
+		IterativeLengthSearch(*dynamic_graph, GetTraversalOptions(info.context, *dynamic_graph), v_size, args,
+		                      args.data[2], args.data[3], result);
+		return;
+	}
+
+	if (!csr_entry->second->initialized_v) {
+		throw ConstraintException("Need to initialize CSR before doing shortest path");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	CSRReadGuard read_guard(csr);
+	IterativeLengthSearch(csr, GetTraversalOptions(info.context, csr), v_size, args, args.data[2], args.data[3],
+	                      result);
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+static void IterativeLengthLabeledFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	auto label_mask = static_cast<uint64_t>(args.data[2].GetValue(0).GetValue<int64_t>());
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_v) {
+		throw ConstraintException("Need to initialize CSR before doing shortest path");
+	}
+	if (!csr_entry->second->initialized_labels) {
+		throw ConstraintException("CSR %d has no edge labels, build it with create_csr_edge_labeled", info.csr_id);
+	}
+	ApplyVertexReordering(info.context, *duckpgq_state, *csr_entry->second);
+	CSRReadGuard read_guard(*csr_entry->second);
+	CSRLabelView graph(*csr_entry->second, label_mask);
+	IterativeLengthSearch(graph, GetTraversalOptions(info.context, graph), v_size, args, args.data[3], args.data[4],
+	                      result);
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+static void IterativeLengthFilteredFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<EdgeFilterFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_v) {
+		throw ConstraintException("Need to initialize CSR before doing shortest path");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	CSRReadGuard read_guard(csr);
+	CSREdgeMaskView graph(csr, info.GetEdgeMask(csr));
+	IterativeLengthSearch(graph, GetTraversalOptions(info.context, graph), v_size, args, args.data[5], args.data[6],
+	                      result);
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+static void IterativeLengthWindowFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	auto window_start = GetTimeWindowBound(args.data[2].GetValue(0), true);
+	auto window_end = GetTimeWindowBound(args.data[3].GetValue(0), false);
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_v) {
+		throw ConstraintException("Need to initialize CSR before doing shortest path");
+	}
+	if (!csr_entry->second->initialized_times) {
+		throw ConstraintException("CSR %d has no temporal index, build it with csr_temporal_index", info.csr_id);
+	}
+	ApplyVertexReordering(info.context, *duckpgq_state, *csr_entry->second);
+	// the temporal index only covers the base arrays, compaction merges appended edges and rebuilds it
+	csr_entry->second->Compact();
+	CSRReadGuard read_guard(*csr_entry->second);
+	CSRTimeWindowView graph(*csr_entry->second, window_start, window_end);
+	IterativeLengthSearch(graph, GetTraversalOptions(info.context, graph), v_size, args, args.data[4], args.data[5],
+	                      result);
 	duckpgq_state->csr_to_delete.insert(info.csr_id);
 }
 
@@ -150,6 +202,47 @@ void CoreScalarFunctions::RegisterIterativeLengthScalarFunction(ExtensionLoader
 	loader.RegisterFunction(ScalarFunction(
 	    "iterativelength", {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT},
 	    LogicalType::BIGINT, IterativeLengthFunction, IterativeLengthFunctionData::IterativeLengthBind));
+
+	/* 1. CSR ID
+	 * 2. Vertex size
+	 * 3. Label mask, bit i enables the edges with label i
+	 * 4. source dense id
+	 * 5. destination dense id
+	 */
+	loader.RegisterFunction(ScalarFunction(
+	    "iterativelength_labeled",
+	    {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT},
+	    LogicalType::BIGINT, IterativeLengthLabeledFunction, IterativeLengthFunctionData::IterativeLengthBind));
+
+	/* 1. CSR ID
+	 * 2. Vertex size
+	 * 3. Edge property attached with csr_edge_property
+	 * 4. Filter operator: =, <>, <, <=, >, >=, between or in
+	 * 5. Filter constant, a list for between and in
+	 * 6. source dense id
+	 * 7. destination dense id
+	 */
+	loader.RegisterFunction(ScalarFunction("iterativelength_filtered",
+	                                       {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::VARCHAR,
+	                                        LogicalType::VARCHAR, LogicalType::ANY, LogicalType::BIGINT,
+	                                        LogicalType::BIGINT},
+	                                       LogicalType::BIGINT, IterativeLengthFilteredFunction,
+	                                       EdgeFilterFunctionData::EdgeFilterBind));
+
+	/* 1. CSR ID
+	 * 2. Vertex size
+	 * 3. Window start, inclusive
+	 * 4. Window end, inclusive
+	 * 5. source dense id
+	 * 6. destination dense id
+	 */
+	ScalarFunctionSet window_set("iterativelength_window");
+	for (auto &time_type : {LogicalType::BIGINT, LogicalType::TIMESTAMP}) {
+		window_set.AddFunction(ScalarFunction(
+		    {LogicalType::INTEGER, LogicalType::BIGINT, time_type, time_type, LogicalType::BIGINT, LogicalType::BIGINT},
+		    LogicalType::BIGINT, IterativeLengthWindowFunction, IterativeLengthFunctionData::IterativeLengthBind));
+	}
+	loader.RegisterFunction(window_set);
 }
 
 } // namespace duckdb
@@ -3,6 +3,7 @@
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckpgq/common.hpp"
 #include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
 #include <duckpgq_extension.hpp>
 
 #include <duckpgq/core/functions/scalar.hpp>
@@ -10,26 +11,6 @@
 
 namespace duckdb {
 
-static bool IterativeLength2(int64_t v_size, int64_t *V, vector<int64_t> &E, vector<std::bitset<LANE_LIMIT>> &seen,
-                             vector<std::bitset<LANE_LIMIT>> &visit, vector<std::bitset<LANE_LIMIT>> &next) {
-	std::bitset<LANE_LIMIT> change;
-	for (auto v = 0; v < v_size; v++) {
-		seen[v] |= visit[v];
-		next[v] = 0;
-	}
-	for (auto v = 0; v < v_size; v++) {
-		if (visit[v].any()) {
-			for (auto e = V[v]; e < V[v + 1]; e++) {
-				auto n = E[e];
-				auto unseen = visit[v] & ~seen[n];
-				next[n] |= unseen;
-				change |= unseen;
-			}
-		}
-	}
-	return change.any();
-}
-
 static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
 	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
@@ -37,9 +18,11 @@ static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Ve
 	auto duckpgq_state = GetDuckPGQState(info.context);
 
 	D_ASSERT(duckpgq_state->csr_list[info.csr_id]);
+	auto &csr = *duckpgq_state->csr_list[info.csr_id];
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	CSRReadGuard read_guard(csr);
 	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
-	int64_t *v = reinterpret_cast<int64_t *>(duckpgq_state->csr_list[info.csr_id]->v);
-	vector<int64_t> &e = duckpgq_state->csr_list[info.csr_id]->e;
+	auto options = GetTraversalOptions(info.context, csr);
 
 	// get src and dst vectors for searches
 	auto &src = args.data[2];
@@ -57,10 +40,7 @@ static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Ve
 
 	ValidityMask &result_validity = FlatVector::Validity(result);
 
-	// create temp SIMD arrays
-	vector<std::bitset<LANE_LIMIT>> seen(v_size);
-	vector<std::bitset<LANE_LIMIT>> visit1(v_size);
-	vector<std::bitset<LANE_LIMIT>> visit2(v_size);
+	LaneBfs bfs(v_size);
 
 	// maps lane to search number
 	int64_t lane_to_num[LANE_LIMIT];
@@ -70,12 +50,7 @@ static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Ve
 
 	int64_t started_searches = 0;
 	while (started_searches < args.size()) {
-
-		// empty visit vectors
-		for (auto i = 0; i < v_size; i++) {
-			seen[i] = 0;
-			visit1[i] = 0;
-		}
+		bfs.Reset();
 
 		// add search jobs to free lanes
 		uint64_t active = 0;
@@ -91,7 +66,7 @@ static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Ve
 				} else if (src_data[src_pos] == dst_data[dst_pos]) {
 					result_data[search_num] = 0; // path of length 0 does not require a search
 				} else {
-					visit1[src_data[src_pos]][lane] = true;
+					bfs.AddSource(csr.ToInternal(src_data[src_pos]), lane, false);
 					lane_to_num[lane] = search_num; // active lane
 					active++;
 					break;
@@ -101,7 +76,7 @@ static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Ve
 
 		// make passes while a lane is still active
 		for (int64_t iter = 1; active; iter++) {
-			if (!IterativeLength2(v_size, v, e, seen, (iter & 1) ? visit1 : visit2, (iter & 1) ? visit2 : visit1)) {
+			if (!bfs.Step(csr, options)) {
 				break;
 			}
 			// detect lanes that finished
@@ -109,7 +84,8 @@ static void IterativeLength2Function(DataChunk &args, ExpressionState &state, Ve
 				int64_t search_num = lane_to_num[lane];
 				if (search_num >= 0) { // active lane
 					auto dst_pos = vdata_dst.sel->get_index(search_num);
-					if ((iter & 1) ? visit2[dst_data[dst_pos]][lane] : visit1[dst_data[dst_pos]][lane]) {
+					auto dst_vertex = csr.ToInternal(dst_data[dst_pos]);
+					if (bfs.visit[dst_vertex][lane]) {
 						result_data[search_num] = iter; /* found at iter => iter = path length */
 						lane_to_num[lane] = -1;         // mark inactive
 						active--;
@@ -3,43 +3,13 @@
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckpgq/common.hpp"
 #include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
 
 #include <duckpgq/core/functions/scalar.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
 
 namespace duckdb {
 
-static bool IterativeLengthBidirectional(int64_t v_size, int64_t *V, vector<int64_t> &E,
-                                         vector<std::bitset<LANE_LIMIT>> &seen, vector<std::bitset<LANE_LIMIT>> &visit,
-                                         vector<std::bitset<LANE_LIMIT>> &next) {
-	bool change = false;
-	for (auto v = 0; v < v_size; v++) {
-		next[v] = 0;
-	}
-	for (auto v = 0; v < v_size; v++) {
-		if (visit[v].any()) {
-			for (auto e = V[v]; e < V[v + 1]; e++) {
-				auto n = E[e];
-				next[n] = next[n] | visit[v];
-			}
-		}
-	}
-	for (auto v = 0; v < v_size; v++) {
-		next[v] = next[v] & ~seen[v];
-		seen[v] = seen[v] | next[v];
-		change |= next[v].any();
-	}
-	return change;
-}
-static std::bitset<LANE_LIMIT> InterSectFronteers(int64_t v_size, vector<std::bitset<LANE_LIMIT>> &src_seen,
-                                                  vector<std::bitset<LANE_LIMIT>> &dst_seen) {
-	std::bitset<LANE_LIMIT> result;
-	for (auto v = 0; v < v_size; v++) {
-		result |= src_seen[v] & dst_seen[v];
-	}
-	return result;
-}
-
 static void IterativeLengthBidirectionalFunction(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
 	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
@@ -47,9 +17,11 @@ static void IterativeLengthBidirectionalFunction(DataChunk &args, ExpressionStat
 	auto duckpgq_state = GetDuckPGQState(info.context);
 
 	D_ASSERT(duckpgq_state->csr_list[info.csr_id]);
+	auto &csr = *duckpgq_state->csr_list[info.csr_id];
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	CSRReadGuard read_guard(csr);
 	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
-	int64_t *v = reinterpret_cast<int64_t *>(duckpgq_state->csr_list[info.csr_id]->v);
-	vector<int64_t> &e = duckpgq_state->csr_list[info.csr_id]->e;
+	auto options = GetTraversalOptions(info.context, csr);
 
 	// get src and dst vectors for searches
 	auto &src = args.data[2];
@@ -58,21 +30,17 @@ static void IterativeLengthBidirectionalFunction(DataChunk &args, ExpressionStat
 	UnifiedVectorFormat vdata_dst;
 	src.ToUnifiedFormat(args.size(), vdata_src);
 	dst.ToUnifiedFormat(args.size(), vdata_dst);
-	auto src_data = vdata_src.data;
-	auto dst_data = vdata_dst.data;
+	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
+	auto dst_data = reinterpret_cast<int64_t *>(vdata_dst.data);
 
 	// create result vector
 	result.SetVectorType(VectorType::FLAT_VECTOR);
 	ValidityMask &result_validity = FlatVector::Validity(result);
 	auto result_data = FlatVector::GetData<int64_t>(result);
 
-	// create temp SIMD arrays
-	vector<std::bitset<LANE_LIMIT>> src_seen(v_size);
-	vector<std::bitset<LANE_LIMIT>> src_visit1(v_size);
-	vector<std::bitset<LANE_LIMIT>> src_visit2(v_size);
-	vector<std::bitset<LANE_LIMIT>> dst_seen(v_size);
-	vector<std::bitset<LANE_LIMIT>> dst_visit1(v_size);
-	vector<std::bitset<LANE_LIMIT>> dst_visit2(v_size);
+	// one search from every source and one from every destination, both following the out-edges
+	LaneBfs src_bfs(v_size);
+	LaneBfs dst_bfs(v_size);
 
 	// maps lane to search number
 	int64_t lane_to_num[LANE_LIMIT];
@@ -82,14 +50,8 @@ static void IterativeLengthBidirectionalFunction(DataChunk &args, ExpressionStat
 
 	int64_t started_searches = 0;
 	while (started_searches < args.size()) {
-
-		// empty visit vectors
-		for (auto i = 0; i < v_size; i++) {
-			src_seen[i] = 0;
-			dst_seen[i] = 0;
-			src_visit1[i] = 0;
-			dst_visit1[i] = 0;
-		}
+		src_bfs.Reset();
+		dst_bfs.Reset();
 
 		// add search jobs to free lanes
 		uint64_t active = 0;
@@ -105,10 +67,8 @@ static void IterativeLengthBidirectionalFunction(DataChunk &args, ExpressionStat
 				} else if (src_data[src_pos] == dst_data[dst_pos]) {
 					result_data[search_num] = 0; // path of length 0 does not require a search
 				} else {
-					src_visit1[src_data[src_pos]][lane] = true;
-					dst_visit1[dst_data[dst_pos]][lane] = true;
-					src_seen[src_data[src_pos]][lane] = true;
-					dst_seen[dst_data[dst_pos]][lane] = true;
+					src_bfs.AddSource(csr.ToInternal(src_data[src_pos]), lane, true);
+					dst_bfs.AddSource(csr.ToInternal(dst_data[dst_pos]), lane, true);
 					lane_to_num[lane] = search_num; // active lane
 					active++;
 					break;
@@ -118,16 +78,16 @@ static void IterativeLengthBidirectionalFunction(DataChunk &args, ExpressionStat
 
 		// make passes while a lane is still active
 		for (int64_t iter = 0; active; iter++) {
-			if (!IterativeLengthBidirectional(v_size, v, e, (iter & 1) ? dst_seen : src_seen,
-			                                  (iter & 2)   ? (iter & 1) ? dst_visit2 : src_visit2
-			                                  : (iter & 1) ? dst_visit1
-			                                               : src_visit1,
-			                                  (iter & 2)   ? (iter & 1) ? dst_visit1 : src_visit1
-			                                  : (iter & 1) ? dst_visit2
-			                                               : src_visit2)) {
+			// the two sides take turns
+			auto &side = (iter & 1) ? dst_bfs : src_bfs;
+			auto &other_side = (iter & 1) ? src_bfs : dst_bfs;
+			if (!side.Step(csr, options)) {
 				break;
 			}
-			std::bitset<LANE_LIMIT> done = InterSectFronteers(v_size, src_seen, dst_seen);
+			// the searches can only meet in a vertex this side reached in this level
+			std::bitset<LANE_LIMIT> done;
+			VertexMap(side.frontier,
+			          [&](int64_t vertex) { done |= side.visit[vertex] & other_side.seen[vertex]; });
 			// detect lanes that finished
 			for (int64_t lane = 0; lane < LANE_LIMIT; lane++) {
 				if (done[lane]) {
@@ -1,16 +1,17 @@
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckpgq/common.hpp"
 #include "duckpgq/core/functions/function_data/local_clustering_coefficient_function_data.hpp"
-#include "duckpgq/core/utils/duckpgq_bitmap.hpp"
 #include "duckpgq/core/utils/duckpgq_utils.hpp"
+#include "duckpgq/core/utils/triangle_counting.hpp"
 
 #include <duckpgq/core/functions/scalar.hpp>
 
+#include <cmath>
+
 namespace duckdb {
 
-static void LocalClusteringCoefficientFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
-	auto &info = func_expr.bind_info->Cast<LocalClusteringCoefficientFunctionData>();
+//! The CSR of info, with the triangles and degrees of all its vertices counted by the first chunk
+static CSR &GetTriangleCSR(LocalClusteringCoefficientFunctionData &info) {
 	auto duckpgq_state = GetDuckPGQState(info.context);
 
 	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
@@ -21,52 +22,132 @@ static void LocalClusteringCoefficientFunction(DataChunk &args, ExpressionState
 	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
 		throw ConstraintException("Need to initialize CSR before doing local clustering coefficient.");
 	}
-	int64_t *v = reinterpret_cast<int64_t *>(duckpgq_state->csr_list[info.csr_id]->v);
-	vector<int64_t> &e = duckpgq_state->csr_list[info.csr_id]->e;
-	size_t v_size = duckpgq_state->csr_list[info.csr_id]->vsize;
-	// get src and dst vectors for searches
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	if (!info.state_converged) {
+		std::lock_guard<std::mutex> guard(info.triangle_lock);
+		if (!info.state_converged) {
+			csr.Compact();
+			CSRReadGuard read_guard(csr);
+			auto oriented = OrientByDegree(info.context, csr);
+			if (info.count_triangles) {
+				info.triangles = CountVertexTriangles(info.context, oriented);
+			}
+			info.degree = std::move(oriented.degree);
+			info.state_converged = true;
+		}
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+	return csr;
+}
+
+//! Calls write(row, vertex) for every row whose rowid is a vertex of the CSR, the other rows are NULL
+template <class WRITE>
+static void ForEachVertexRow(DataChunk &args, const CSR &csr, Vector &result, WRITE &&write) {
+	// get src vector for searches
 	auto &src = args.data[1];
 	UnifiedVectorFormat vdata_src;
 	src.ToUnifiedFormat(args.size(), vdata_src);
 	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
 
-	ValidityMask &result_validity = FlatVector::Validity(result);
-	// create result vector
+	// create result vector, SetNull also nulls the fields of a struct result
 	result.SetVectorType(VectorType::FLAT_VECTOR);
-	auto result_data = FlatVector::GetData<float>(result);
-
-	DuckPGQBitmap neighbors(v_size);
-
 	for (idx_t n = 0; n < args.size(); n++) {
 		auto src_sel = vdata_src.sel->get_index(n);
-		if (!vdata_src.validity.RowIsValid(src_sel)) {
-			result_validity.SetInvalid(n);
-		}
-		int64_t src_node = src_data[src_sel];
-		int64_t number_of_edges = v[src_node + 1] - v[src_node];
-		if (number_of_edges < 2) {
-			result_data[n] = static_cast<float>(0.0);
+		int64_t src_node = csr.ToInternal(src_data[src_sel]);
+		if (!vdata_src.validity.RowIsValid(src_sel) || src_node < 0 || src_node >= csr.VertexCount()) {
+			FlatVector::SetNull(result, n, true);
 			continue;
 		}
-		neighbors.reset();
-		for (int64_t offset = v[src_node]; offset < v[src_node + 1]; offset++) {
-			neighbors.set(e[offset]);
-		}
+		write(n, src_node);
+	}
+}
 
-		// Count connections between neighbors
-		int64_t count = 0;
-		for (int64_t offset = v[src_node]; offset < v[src_node + 1]; offset++) {
-			int64_t neighbor = e[offset];
-			for (int64_t offset2 = v[neighbor]; offset2 < v[neighbor + 1]; offset2++) {
-				int is_connected = neighbors.test(e[offset2]);
-				count += is_connected; // Add 1 if connected, 0 otherwise
-			}
+//! Writes value(vertex) for every row whose rowid is a vertex of the CSR, NULL otherwise
+template <class T, class VALUE>
+static void ExecutePerVertex(DataChunk &args, ExpressionState &state, Vector &result, VALUE &&value) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<LocalClusteringCoefficientFunctionData>();
+	auto &csr = GetTriangleCSR(info);
+	auto result_data = FlatVector::GetData<T>(result);
+	ForEachVertexRow(args, csr, result, [&](idx_t row, int64_t vertex) { result_data[row] = value(info, vertex); });
+}
+
+static void LocalClusteringCoefficientFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePerVertex<float>(args, state, result, [](LocalClusteringCoefficientFunctionData &info, int64_t vertex) {
+		auto degree = info.degree[vertex];
+		if (degree < 2) {
+			return static_cast<float>(0.0);
 		}
+		// every triangle closes two ordered pairs of neighbours
+		const float degree_float = static_cast<float>(degree);
+		return static_cast<float>(2 * info.triangles[vertex]) / (degree_float * (degree_float - 1.0f));
+	});
+}
 
-		const float num_edges_float = static_cast<float>(number_of_edges);
-		float local_result = static_cast<float>(count) / (num_edges_float * (num_edges_float - 1.0f));
+static void LocalTriangleCountFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePerVertex<int64_t>(args, state, result, [](LocalClusteringCoefficientFunctionData &info, int64_t vertex) {
+		return info.triangles[vertex];
+	});
+}
+
+static void LocalWedgeCountFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePerVertex<int64_t>(args, state, result, [](LocalClusteringCoefficientFunctionData &info, int64_t vertex) {
+		auto degree = info.degree[vertex];
+		return degree * (degree - 1) / 2;
+	});
+}
+
+static void LocalTriangleWedgeCountFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<LocalClusteringCoefficientFunctionData>();
+	auto &csr = GetTriangleCSR(info);
+	auto &children = StructVector::GetEntries(result);
+	auto triangles = FlatVector::GetData<int64_t>(*children[0]);
+	auto wedges = FlatVector::GetData<int64_t>(*children[1]);
+	ForEachVertexRow(args, csr, result, [&](idx_t row, int64_t vertex) {
+		auto degree = info.degree[vertex];
+		triangles[row] = info.triangles[vertex];
+		wedges[row] = degree * (degree - 1) / 2;
+	});
+}
+
+static void ApproximateTriangleCountFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<LocalClusteringCoefficientFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
 
-		result_data[n] = local_result;
+	auto error = args.data[2].GetValue(0).GetValue<double>();
+	auto confidence = args.data[3].GetValue(0).GetValue<double>();
+	if (error <= 0) {
+		throw InvalidInputException("Approximate triangle count error must be positive, got %f", error);
+	}
+	if (confidence <= 0 || confidence >= 1) {
+		throw InvalidInputException("Approximate triangle count confidence must be between 0 and 1 exclusive, got %f",
+		                            confidence);
+	}
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		throw ConstraintException("CSR not found. Is the graph populated?");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	csr.Compact();
+	ApplyHubRows(info.context, *duckpgq_state, csr);
+	CSRReadGuard read_guard(csr);
+	// the estimate does not depend on the row, every chunk repeats the same sampling
+	auto estimate = EstimateTriangles(info.context, csr, error, confidence);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto &children = StructVector::GetEntries(result);
+	ConstantVector::GetData<int64_t>(*children[0])[0] = static_cast<int64_t>(std::llround(estimate.triangles));
+	ConstantVector::GetData<int64_t>(*children[1])[0] = static_cast<int64_t>(std::floor(estimate.lower_bound));
+	ConstantVector::GetData<int64_t>(*children[2])[0] = static_cast<int64_t>(std::ceil(estimate.upper_bound));
+	ConstantVector::GetData<double>(*children[3])[0] = estimate.transitivity;
+	ConstantVector::GetData<int64_t>(*children[4])[0] = static_cast<int64_t>(estimate.samples);
+	ConstantVector::GetData<bool>(*children[5])[0] = estimate.error_met;
+	for (auto &child : children) {
+		child->SetVectorType(VectorType::CONSTANT_VECTOR);
 	}
 	duckpgq_state->csr_to_delete.insert(info.csr_id);
 }
@@ -75,9 +156,43 @@ static void LocalClusteringCoefficientFunction(DataChunk &args, ExpressionState
 // Register functions
 //------------------------------------------------------------------------------
 void CoreScalarFunctions::RegisterLocalClusteringCoefficientScalarFunction(ExtensionLoader &loader) {
+	/* 1. CSR ID, of an undirected CSR
+	 * 2. vertex rowid
+	 */
 	loader.RegisterFunction(ScalarFunction("local_clustering_coefficient", {LogicalType::INTEGER, LogicalType::BIGINT},
 	                                       LogicalType::FLOAT, LocalClusteringCoefficientFunction,
 	                                       LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientBind));
+	// Triangles through the vertex
+	loader.RegisterFunction(ScalarFunction("local_triangle_count", {LogicalType::INTEGER, LogicalType::BIGINT},
+	                                       LogicalType::BIGINT, LocalTriangleCountFunction,
+	                                       LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientBind));
+	// Pairs of distinct neighbours of the vertex
+	loader.RegisterFunction(ScalarFunction("local_wedge_count", {LogicalType::INTEGER, LogicalType::BIGINT},
+	                                       LogicalType::BIGINT, LocalWedgeCountFunction,
+	                                       LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientBind));
+
+	// Both counts from one orientation of the CSR, for the global clustering coefficient
+	loader.RegisterFunction(ScalarFunction(
+	    "local_triangle_wedge_count", {LogicalType::INTEGER, LogicalType::BIGINT},
+	    LogicalType::STRUCT({{"triangles", LogicalType::BIGINT}, {"wedges", LogicalType::BIGINT}}),
+	    LocalTriangleWedgeCountFunction, LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientBind));
+
+	/* 1. CSR ID, of an undirected CSR
+	 * 2. vertex rowid, the estimate is the same for every row
+	 * 3. error, relative half-width of the confidence interval to sample for, error_met tells whether it was reached
+	 * 4. confidence of the interval
+	 */
+	auto estimate_type = LogicalType::STRUCT({{"triangle_count", LogicalType::BIGINT},
+	                                          {"lower_bound", LogicalType::BIGINT},
+	                                          {"upper_bound", LogicalType::BIGINT},
+	                                          {"global_clustering_coefficient", LogicalType::DOUBLE},
+	                                          {"samples", LogicalType::BIGINT},
+	                                          {"error_met", LogicalType::BOOLEAN}});
+	ScalarFunction approximate("approximate_triangle_count",
+	                           {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::DOUBLE, LogicalType::DOUBLE},
+	                           estimate_type, ApproximateTriangleCountFunction,
+	                           LocalClusteringCoefficientFunctionData::LocalClusteringCoefficientBind);
+	loader.RegisterFunction(approximate);
 }
 
 } // namespace duckdb
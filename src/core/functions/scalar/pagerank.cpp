@@ -5,82 +5,130 @@
 #include <duckpgq/core/functions/table/pagerank.hpp>
 #include <duckpgq/core/utils/duckpgq_bitmap.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq/core/utils/sparse_linear_algebra.hpp>
 
 namespace duckdb {
 
-static void PageRankFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
-	auto &info = func_expr.bind_info->Cast<PageRankFunctionData>();
-	auto duckpgq_state = GetDuckPGQState(info.context);
-
-	// Locate the CSR representation of the graph
-	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
-	if (csr_entry == duckpgq_state->csr_list.end()) {
-		throw ConstraintException("CSR not found. Is the graph populated?");
+//! Weighted out-degree of every vertex, the plain out-degree on a CSR without weights
+static vector<double> OutWeights(const CSR &csr, const vector<double> &weights, size_t v_size) {
+	vector<double> out_weights(v_size, 0.0);
+	auto offsets = reinterpret_cast<const int64_t *>(csr.v);
+	for (int64_t vertex = 0; vertex < csr.VertexCount(); vertex++) {
+		if (weights.empty()) {
+			out_weights[vertex] = static_cast<double>(csr.Degree(vertex));
+			continue;
+		}
+		for (auto offset = offsets[vertex]; offset < offsets[vertex + 1]; offset++) {
+			if (weights[offset] < 0) {
+				throw InvalidInputException("PageRank edge weights must not be negative, got %f", weights[offset]);
+			}
+			out_weights[vertex] += weights[offset];
+		}
 	}
+	return out_weights;
+}
 
-	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
-		throw ConstraintException("Need to initialize CSR before running PageRank.");
+//! Spreads the rank of every vertex over its out-edges in proportion to their weight, as the plus-times product
+//! (rank / out-weight) A pulled over the transpose. Returns the rank held by vertices without out-weight.
+static double ScatterRank(ClientContext &context, const CSR &csr, const SparseOptions &options,
+                          const vector<double> &weights, const vector<double> &out_weights,
+                          const vector<double> &rank, vector<double> &contribution, vector<double> &temp_rank) {
+	auto total_dangling_rank = TraversalParallelReduce<double>(
+	    &context, rank.size(), 0.0,
+	    [&](idx_t begin, idx_t end) {
+		    double dangling_rank = 0.0;
+		    for (auto i = begin; i < end; i++) {
+			    if (out_weights[i] > 0) {
+				    contribution[i] = rank[i] / out_weights[i];
+			    } else {
+				    contribution[i] = 0.0;
+				    dangling_rank += rank[i];
+			    }
+		    }
+		    return dangling_rank;
+	    },
+	    [](double a, double b) { return a + b; });
+	if (weights.empty()) {
+		VxM<PlusTimesSemiring<double>>(csr, PatternWeight<PlusTimesSemiring<double>>(), contribution, temp_rank,
+		                               options);
+	} else {
+		VxM<PlusTimesSemiring<double>>(csr, ColumnWeight<double>(weights), contribution, temp_rank, options);
 	}
+	return total_dangling_rank;
+}
 
-	auto *v = reinterpret_cast<int64_t *>(duckpgq_state->csr_list[info.csr_id]->v);
-	vector<int64_t> &e = duckpgq_state->csr_list[info.csr_id]->e;
-	size_t v_size = duckpgq_state->csr_list[info.csr_id]->vsize;
+//! Same scatter over a partitioned CSR, streaming one partition at a time
+static double ScatterRank(const PartitionedCSR &graph, size_t v_size, const vector<double> &rank,
+                          vector<double> &temp_rank) {
+	vector<bool> dangling(v_size, true);
+	for (idx_t partition = 0; partition < graph.PartitionCount(); partition++) {
+		graph.ForEachPartitionVertex(partition, [&](int64_t i, const int64_t *neighbors, int64_t degree) {
+			if (degree == 0) {
+				return;
+			}
+			double rank_contrib = rank[i] / static_cast<double_t>(degree);
+			for (int64_t j = 0; j < degree; j++) {
+				temp_rank[neighbors[j]] += rank_contrib;
+			}
+			dangling[i] = false;
+		});
+	}
+	double total_dangling_rank = 0.0;
+	for (size_t i = 0; i < v_size; i++) {
+		if (dangling[i]) {
+			total_dangling_rank += rank[i];
+		}
+	}
+	return total_dangling_rank;
+}
 
-	// State initialization (only once)
+//! scatter(rank, temp_rank) stores the rank flowing over the edges in temp_rank and returns the dangling rank.
+//! The first caller runs all iterations, until the ranks converge or max_iterations is reached.
+template <class SCATTER>
+static void PageRankIterate(size_t v_size, PageRankFunctionData &info, SCATTER &&scatter) {
+	std::lock_guard<std::mutex> guard(info.state_lock);
+	if (info.converged) {
+		return;
+	}
 	if (!info.state_initialized) {
-		info.rank.resize(v_size, 1.0 / static_cast<double>(v_size)); // Initial rank for each node
-		info.temp_rank.resize(v_size,
-		                      0.0);        // Temporary storage for ranks during iteration
-		info.damping_factor = 0.85;        // Typical damping factor
-		info.convergence_threshold = 1e-6; // Convergence threshold
-		info.state_initialized = true;
-		info.converged = false;
+		info.rank.assign(v_size, 1.0 / static_cast<double>(v_size));
+		info.temp_rank.assign(v_size, 0.0);
 		info.iteration_count = 0;
+		info.state_initialized = true;
 	}
 
-	// Check if already converged
-	if (!info.converged) {
-		std::lock_guard<std::mutex> guard(info.state_lock); // Thread safety
-
-		bool continue_iteration = true;
-		while (continue_iteration) {
-			fill(info.temp_rank.begin(), info.temp_rank.end(), 0.0);
-
-			double total_dangling_rank = 0.0; // For dangling nodes
-
-			for (size_t i = 0; i < v_size; i++) {
-				auto start_edge = v[i];
-				auto end_edge = (i + 1 < v_size) ? v[i + 1] : e.size(); // Adjust end_edge
-				if (end_edge > start_edge) {
-					double rank_contrib = info.rank[i] / static_cast<double_t>(end_edge - start_edge);
-					for (int64_t j = start_edge; j < end_edge; j++) {
-						int64_t neighbor = e[j];
-						info.temp_rank[neighbor] += rank_contrib;
-					}
-				} else {
-					total_dangling_rank += info.rank[i];
-				}
-			}
-
-			// Apply damping factor and handle dangling node ranks
-			double correction_factor = total_dangling_rank / static_cast<double>(v_size);
-			double max_delta = 0.0;
-			for (size_t i = 0; i < v_size; i++) {
-				info.temp_rank[i] = (1 - info.damping_factor) / static_cast<double>(v_size) +
-				                    info.damping_factor * (info.temp_rank[i] + correction_factor);
-				max_delta = std::max(max_delta, std::abs(info.temp_rank[i] - info.rank[i]));
-			}
-
-			info.rank.swap(info.temp_rank);
-			info.iteration_count++;
-			if (max_delta < info.convergence_threshold) {
-				info.converged = true;
-				continue_iteration = false;
-			}
+	while (!info.converged) {
+		fill(info.temp_rank.begin(), info.temp_rank.end(), 0.0);
+
+		// For dangling nodes
+		double total_dangling_rank = scatter(info.rank, info.temp_rank);
+
+		// Apply damping factor and handle dangling node ranks
+		double correction_factor = total_dangling_rank / static_cast<double>(v_size);
+		double teleport = (1 - info.damping_factor) / static_cast<double>(v_size);
+		double max_delta = TraversalParallelReduce<double>(
+		    &info.context, v_size, 0.0,
+		    [&](idx_t begin, idx_t end) {
+			    double range_delta = 0.0;
+			    for (auto i = begin; i < end; i++) {
+				    info.temp_rank[i] = teleport + info.damping_factor * (info.temp_rank[i] + correction_factor);
+				    range_delta = std::max(range_delta, std::abs(info.temp_rank[i] - info.rank[i]));
+			    }
+			    return range_delta;
+		    },
+		    [](double a, double b) { return std::max(a, b); });
+
+		info.rank.swap(info.temp_rank);
+		info.iteration_count++;
+		if (max_delta < info.convergence_threshold || info.iteration_count >= info.max_iterations) {
+			info.converged = true;
 		}
 	}
+}
 
+template <class GRAPH>
+static void PageRankOutput(const GRAPH &graph, size_t v_size, PageRankFunctionData &info, DataChunk &args,
+                           Vector &result) {
 	// Get the source vector for the current DataChunk
 	auto &src = args.data[1];
 	UnifiedVectorFormat vdata_src;
@@ -104,8 +152,62 @@ static void PageRankFunction(DataChunk &args, ExpressionState &state, Vector &re
 			result_validity.SetInvalid(i);
 			continue;
 		}
-		result_data[i] = info.rank[node_id];
+		result_data[i] = info.rank[graph.ToInternal(node_id)];
+	}
+}
+
+static void PageRankFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<PageRankFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	// Locate the CSR representation of the graph
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end()) {
+		auto partitioned_csr = duckpgq_state->GetPartitionedCSR(info.csr_id);
+		if (!partitioned_csr) {
+			throw ConstraintException("CSR not found. Is the graph populated?");
+		}
+		CSRReadGuard read_guard(partitioned_csr->access_lock);
+		auto v_size = partitioned_csr->vsize;
+		PageRankIterate(v_size, info, [&](const vector<double> &rank, vector<double> &temp_rank) {
+			return ScatterRank(*partitioned_csr, v_size, rank, temp_rank);
+		});
+		PageRankOutput(*partitioned_csr, partitioned_csr->vsize, info, args, result);
+		return;
+	}
+
+	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
+		throw ConstraintException("Need to initialize CSR before running PageRank.");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+
+	if (!info.converged) {
+		{
+			// appended edges are merged before the first iteration, like the other changes to a cached CSR
+			lock_guard<mutex> csr_compact_lock(duckpgq_state->csr_lock);
+			csr.Compact();
+		}
+		CSRReadGuard read_guard(csr);
+		// every iteration pulls over the in-edges without atomics, building the transpose once pays off after the
+		// first one
+		SparseOptions options;
+		options.context = &info.context;
+		options.transpose = &csr.GetTranspose();
+		vector<double> weights;
+		if (!csr.w_double.empty()) {
+			weights = csr.w_double;
+		} else if (!csr.w.empty()) {
+			weights.assign(csr.w.begin(), csr.w.end());
+		}
+		auto out_weights = OutWeights(csr, weights, csr.vsize);
+		vector<double> contribution(csr.vsize);
+		PageRankIterate(csr.vsize, info, [&](const vector<double> &rank, vector<double> &temp_rank) {
+			return ScatterRank(info.context, csr, options, weights, out_weights, rank, contribution, temp_rank);
+		});
 	}
+	PageRankOutput(csr, csr.vsize, info, args, result);
 
 	duckpgq_state->csr_to_delete.insert(info.csr_id);
 }
@@ -114,8 +216,19 @@ static void PageRankFunction(DataChunk &args, ExpressionState &state, Vector &re
 // Register functions
 //------------------------------------------------------------------------------
 void CoreScalarFunctions::RegisterPageRankScalarFunction(ExtensionLoader &loader) {
-	loader.RegisterFunction(ScalarFunction("pagerank", {LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::DOUBLE,
-	                                       PageRankFunction, PageRankFunctionData::PageRankBind));
+	/* 1. CSR ID
+	 * 2. source rowid
+	 * 3. <optional> damping factor
+	 * 4. <optional> convergence tolerance
+	 * 5. <optional> maximum number of iterations
+	 */
+	ScalarFunctionSet set("pagerank");
+	set.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::DOUBLE, PageRankFunction,
+	                               PageRankFunctionData::PageRankBind));
+	set.AddFunction(ScalarFunction(
+	    {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::BIGINT},
+	    LogicalType::DOUBLE, PageRankFunction, PageRankFunctionData::PageRankBind));
+	loader.RegisterFunction(set);
 }
 
 } // namespace duckdb
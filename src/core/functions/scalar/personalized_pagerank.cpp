@@ -0,0 +1,298 @@
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+#include "duckpgq/core/functions/function_data/pagerank_function_data.hpp"
+
+#include <array>
+#include <deque>
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq/core/utils/sparse_linear_algebra.hpp>
+
+namespace duckdb {
+
+//! Seeds ranked together by one power iteration, every vertex keeps one score per lane
+#define PERSONALIZED_PAGERANK_LANES 32
+
+using LaneScores = std::array<double, PERSONALIZED_PAGERANK_LANES>;
+
+//! Weight of every edge in the lane product, multiplying by it is free
+struct UnitLaneWeight {
+	UnitLaneWeight operator()(int64_t offset) const {
+		return UnitLaneWeight();
+	}
+};
+
+//! Plus-times over PERSONALIZED_PAGERANK_LANES independent walks at once
+struct LanePlusTimesSemiring {
+	using value_t = LaneScores;
+	static LaneScores Zero() {
+		LaneScores result;
+		result.fill(0.0);
+		return result;
+	}
+	static LaneScores Add(const LaneScores &a, const LaneScores &b) {
+		LaneScores result;
+		for (idx_t lane = 0; lane < PERSONALIZED_PAGERANK_LANES; lane++) {
+			result[lane] = a[lane] + b[lane];
+		}
+		return result;
+	}
+	static const LaneScores &Multiply(const LaneScores &a, UnitLaneWeight) {
+		return a;
+	}
+};
+
+struct ScoredVertex {
+	int64_t vertex;
+	double score;
+};
+
+//! The top_k highest scores, ties broken by the lower rowid
+static void KeepTopK(const CSR &csr, vector<ScoredVertex> &scores, idx_t top_k) {
+	for (auto &entry : scores) {
+		entry.vertex = csr.ToExternal(entry.vertex);
+	}
+	auto order = [](const ScoredVertex &a, const ScoredVertex &b) {
+		return a.score > b.score || (a.score == b.score && a.vertex < b.vertex);
+	};
+	if (scores.size() > top_k) {
+		std::partial_sort(scores.begin(), scores.begin() + static_cast<int64_t>(top_k), scores.end(), order);
+		scores.resize(top_k);
+	} else {
+		std::sort(scores.begin(), scores.end(), order);
+	}
+}
+
+//! Random walks with restart from up to PERSONALIZED_PAGERANK_LANES seeds, one lane each, by power iteration over
+//! the transpose. Walks that reach a vertex without out-edges restart at their seed. Stops once no lane moved more
+//! than epsilon in L1 distance.
+static void PowerIterationBatch(ClientContext &context, const CSR &csr, const SparseOptions &options,
+                                const vector<int64_t> &seeds, double alpha, double epsilon,
+                                vector<vector<ScoredVertex>> &results) {
+	auto vertex_count = csr.VertexCount();
+	auto lanes = seeds.size();
+	vector<LaneScores> rank(vertex_count, LanePlusTimesSemiring::Zero());
+	vector<LaneScores> contribution(vertex_count);
+	vector<LaneScores> next(vertex_count);
+	for (idx_t lane = 0; lane < lanes; lane++) {
+		rank[seeds[lane]][lane] = 1.0;
+	}
+	auto add_lanes = [](LaneScores a, const LaneScores &b) {
+		return LanePlusTimesSemiring::Add(a, b);
+	};
+	for (int64_t iteration = 0; iteration < PAGERANK_DEFAULT_MAX_ITERATIONS; iteration++) {
+		auto dangling = TraversalParallelReduce<LaneScores>(
+		    &context, vertex_count, LanePlusTimesSemiring::Zero(),
+		    [&](idx_t begin, idx_t end) {
+			    auto range_dangling = LanePlusTimesSemiring::Zero();
+			    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+				    auto degree = csr.Degree(vertex);
+				    if (degree == 0) {
+					    range_dangling = LanePlusTimesSemiring::Add(range_dangling, rank[vertex]);
+					    contribution[vertex] = LanePlusTimesSemiring::Zero();
+					    continue;
+				    }
+				    for (idx_t lane = 0; lane < PERSONALIZED_PAGERANK_LANES; lane++) {
+					    contribution[vertex][lane] = rank[vertex][lane] / static_cast<double>(degree);
+				    }
+			    }
+			    return range_dangling;
+		    },
+		    add_lanes);
+		VxM<LanePlusTimesSemiring>(csr, UnitLaneWeight(), contribution, next, options);
+		// walks restart at their seed with probability alpha, and always after reaching a vertex without out-edges
+		for (idx_t lane = 0; lane < lanes; lane++) {
+			next[seeds[lane]][lane] += dangling[lane] + alpha / (1 - alpha);
+		}
+		auto moved = TraversalParallelReduce<LaneScores>(
+		    &context, vertex_count, LanePlusTimesSemiring::Zero(),
+		    [&](idx_t begin, idx_t end) {
+			    auto range_moved = LanePlusTimesSemiring::Zero();
+			    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+				    for (idx_t lane = 0; lane < PERSONALIZED_PAGERANK_LANES; lane++) {
+					    auto score = (1 - alpha) * next[vertex][lane];
+					    range_moved[lane] += std::abs(score - rank[vertex][lane]);
+					    rank[vertex][lane] = score;
+				    }
+			    }
+			    return range_moved;
+		    },
+		    add_lanes);
+		double max_moved = 0.0;
+		for (idx_t lane = 0; lane < lanes; lane++) {
+			max_moved = MaxValue(max_moved, moved[lane]);
+		}
+		if (max_moved < epsilon) {
+			break;
+		}
+	}
+	for (idx_t lane = 0; lane < lanes; lane++) {
+		auto &result = results[lane];
+		for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+			if (rank[vertex][lane] > 0) {
+				result.push_back(ScoredVertex {vertex, rank[vertex][lane]});
+			}
+		}
+	}
+}
+
+//! Andersen-Chung-Lang push: settles the residual of every vertex until it is below epsilon times its out-degree.
+//! Only the vertices near the seed are touched, the error of every score is below epsilon times its degree.
+static void ApproximatePersonalizedPageRank(const CSR &csr, int64_t seed, double alpha, double epsilon,
+                                            vector<ScoredVertex> &result) {
+	unordered_map<int64_t, double> scores;
+	unordered_map<int64_t, double> residual;
+	std::deque<int64_t> queue;
+	auto threshold = [&](int64_t vertex) {
+		return epsilon * static_cast<double>(MaxValue<int64_t>(csr.Degree(vertex), 1));
+	};
+	auto add_residual = [&](int64_t vertex, double mass) {
+		auto &entry = residual[vertex];
+		auto below = entry < threshold(vertex);
+		entry += mass;
+		if (below && entry >= threshold(vertex)) {
+			queue.push_back(vertex);
+		}
+	};
+	add_residual(seed, 1.0);
+	while (!queue.empty()) {
+		auto vertex = queue.front();
+		queue.pop_front();
+		auto mass = residual[vertex];
+		residual[vertex] = 0.0;
+		scores[vertex] += alpha * mass;
+		auto degree = csr.Degree(vertex);
+		if (degree == 0) {
+			add_residual(seed, (1 - alpha) * mass);
+			continue;
+		}
+		auto share = (1 - alpha) * mass / static_cast<double>(degree);
+		csr.ForEachNeighbor(vertex, [&](int64_t neighbor) { add_residual(neighbor, share); });
+	}
+	for (auto &entry : scores) {
+		result.push_back(ScoredVertex {entry.first, entry.second});
+	}
+}
+
+static void PersonalizedPageRankFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	auto alpha = args.data[2].GetValue(0).GetValue<double>();
+	auto epsilon = args.data[3].GetValue(0).GetValue<double>();
+	auto top_k = args.data[4].GetValue(0).GetValue<int64_t>();
+	auto method = StringUtil::Lower(args.data[5].GetValue(0).ToString());
+	if (alpha <= 0 || alpha >= 1) {
+		throw InvalidInputException("Personalized PageRank alpha must be between 0 and 1 exclusive, got %f", alpha);
+	}
+	if (epsilon <= 0) {
+		throw InvalidInputException("Personalized PageRank epsilon must be positive, got %f", epsilon);
+	}
+	if (top_k <= 0) {
+		throw InvalidInputException("Personalized PageRank top_k must be positive, got %d", top_k);
+	}
+	if (method != "push" && method != "power") {
+		throw InvalidInputException("Unknown personalized PageRank method '%s', expected push or power", method);
+	}
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_e) {
+		throw ConstraintException("Need to initialize CSR before running personalized PageRank.");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	csr.Compact();
+	CSRReadGuard read_guard(csr);
+
+	UnifiedVectorFormat vdata_seed;
+	args.data[1].ToUnifiedFormat(args.size(), vdata_seed);
+	auto seed_data = UnifiedVectorFormat::GetData<int64_t>(vdata_seed);
+
+	// rows with a valid seed, and the seed of each as a vertex of the CSR
+	vector<idx_t> rows;
+	vector<int64_t> seeds;
+	for (idx_t row = 0; row < args.size(); row++) {
+		auto seed_pos = vdata_seed.sel->get_index(row);
+		if (!vdata_seed.validity.RowIsValid(seed_pos)) {
+			continue;
+		}
+		auto seed = csr.ToInternal(seed_data[seed_pos]);
+		if (seed < 0 || seed >= csr.VertexCount()) {
+			continue;
+		}
+		rows.push_back(row);
+		seeds.push_back(seed);
+	}
+
+	vector<vector<ScoredVertex>> scores(seeds.size());
+	if (method == "push") {
+		// every seed is an independent, mostly local computation
+		TraversalParallelTasks(&info.context, seeds.size(), [&](idx_t i) {
+			ApproximatePersonalizedPageRank(csr, seeds[i], alpha, epsilon, scores[i]);
+			KeepTopK(csr, scores[i], static_cast<idx_t>(top_k));
+		});
+	} else {
+		SparseOptions options;
+		options.context = &info.context;
+		options.transpose = &csr.GetTranspose();
+		for (idx_t batch_start = 0; batch_start < seeds.size(); batch_start += PERSONALIZED_PAGERANK_LANES) {
+			auto batch_end = MinValue<idx_t>(batch_start + PERSONALIZED_PAGERANK_LANES, seeds.size());
+			vector<int64_t> batch(seeds.begin() + static_cast<int64_t>(batch_start),
+			                      seeds.begin() + static_cast<int64_t>(batch_end));
+			vector<vector<ScoredVertex>> batch_scores(batch.size());
+			PowerIterationBatch(info.context, csr, options, batch, alpha, epsilon, batch_scores);
+			for (idx_t lane = 0; lane < batch.size(); lane++) {
+				KeepTopK(csr, batch_scores[lane], static_cast<idx_t>(top_k));
+				scores[batch_start + lane] = std::move(batch_scores[lane]);
+			}
+		}
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<list_entry_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t row = 0; row < args.size(); row++) {
+		result_validity.SetInvalid(row);
+	}
+	idx_t list_size = 0;
+	for (idx_t i = 0; i < rows.size(); i++) {
+		auto &seed_scores = scores[i];
+		ListVector::Reserve(result, list_size + seed_scores.size());
+		auto &children = StructVector::GetEntries(ListVector::GetEntry(result));
+		auto vertex_data = FlatVector::GetData<int64_t>(*children[0]);
+		auto score_data = FlatVector::GetData<double>(*children[1]);
+		for (idx_t j = 0; j < seed_scores.size(); j++) {
+			vertex_data[list_size + j] = seed_scores[j].vertex;
+			score_data[list_size + j] = seed_scores[j].score;
+		}
+		result_validity.SetValid(rows[i]);
+		result_data[rows[i]].offset = list_size;
+		result_data[rows[i]].length = seed_scores.size();
+		list_size += seed_scores.size();
+	}
+	ListVector::SetListSize(result, list_size);
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterPersonalizedPageRankScalarFunction(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. seed rowid
+	 * 3. restart probability alpha
+	 * 4. epsilon, residual bound of push or L1 tolerance of power
+	 * 5. number of highest scored vertices returned per seed
+	 * 6. method: push or power
+	 */
+	auto scored_vertex = LogicalType::STRUCT({{"vertex", LogicalType::BIGINT}, {"score", LogicalType::DOUBLE}});
+	loader.RegisterFunction(ScalarFunction("personalized_pagerank",
+	                                       {LogicalType::INTEGER, LogicalType::BIGINT, LogicalType::DOUBLE,
+	                                        LogicalType::DOUBLE, LogicalType::BIGINT, LogicalType::VARCHAR},
+	                                       LogicalType::LIST(scored_vertex), PersonalizedPageRankFunction,
+	                                       IterativeLengthFunctionData::IterativeLengthBind));
+}
+
+} // namespace duckdb
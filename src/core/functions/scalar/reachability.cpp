@@ -3,6 +3,7 @@
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckpgq/common.hpp"
 #include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
 #include <duckpgq_extension.hpp>
 
 #include <duckpgq/core/functions/scalar.hpp>
@@ -10,11 +11,9 @@
 
 namespace duckdb {
 
-typedef enum { NO_ARRAY, ARRAY, INTERMEDIATE } msbfs_modes_t;
-
-static int16_t InitialiseBfs(idx_t curr_batch, idx_t size, data_ptr_t src_data, const SelectionVector *src_sel,
-                             const ValidityMask &src_validity, vector<std::bitset<LANE_LIMIT>> &seen,
-                             vector<std::bitset<LANE_LIMIT>> &visit, vector<std::bitset<LANE_LIMIT>> &visit_next,
+template <class GRAPH>
+static int16_t InitialiseBfs(const GRAPH &graph, idx_t curr_batch, idx_t size, const int64_t *src_data,
+                             const SelectionVector *src_sel, const ValidityMask &src_validity, LaneBfs &bfs,
                              unordered_map<int64_t, pair<int16_t, vector<idx_t>>> &lane_map) {
 	int16_t lanes = 0;
 	int16_t curr_batch_size = 0;
@@ -23,12 +22,11 @@ static int16_t InitialiseBfs(idx_t curr_batch, idx_t size, data_ptr_t src_data,
 		auto src_index = src_sel->get_index(i);
 
 		if (src_validity.RowIsValid(src_index)) {
-			auto src_entry = src_data[src_index];
+			auto src_entry = graph.ToInternal(src_data[src_index]);
 			auto entry = lane_map.find(src_entry);
 			if (entry == lane_map.end()) {
 				lane_map[src_entry].first = lanes;
-				seen[src_entry][lanes] = true;
-				visit[src_entry][lanes] = true;
+				bfs.AddSource(src_entry, lanes, true);
 				lanes++;
 			}
 			lane_map[src_entry].second.push_back(i);
@@ -38,199 +36,35 @@ static int16_t InitialiseBfs(idx_t curr_batch, idx_t size, data_ptr_t src_data,
 	return curr_batch_size;
 }
 
-static bool BfsWithoutArrayVariant(bool exit_early, CSR *csr, int64_t input_size, vector<std::bitset<LANE_LIMIT>> &seen,
-                                   vector<std::bitset<LANE_LIMIT>> &visit, vector<std::bitset<LANE_LIMIT>> &visit_next,
-                                   vector<int64_t> &visit_list) {
-	for (int64_t i = 0; i < input_size; i++) {
-		if (!visit[i].any()) {
-			continue;
-		}
-
-		for (auto index = (int64_t)csr->v[i]; index < csr->v[i + 1]; index++) {
-			auto n = csr->e[index];
-			visit_next[n] = visit_next[n] | visit[i];
-		}
-	}
-
-	for (int64_t i = 0; i < input_size; i++) {
-		if (visit_next[i].none()) {
-			continue;
-		}
-		visit_next[i] = visit_next[i] & ~seen[i];
-		seen[i] = seen[i] | visit_next[i];
-		if (exit_early && visit_next[i].any()) {
-			exit_early = false;
-		}
-		if (visit_next[i].any()) {
-			visit_list.push_back(i);
-		}
-	}
-	return exit_early;
-}
-
-static bool BfsWithoutArray(bool exit_early, CSR *csr, int64_t input_size, vector<std::bitset<LANE_LIMIT>> &seen,
-                            vector<std::bitset<LANE_LIMIT>> &visit, vector<std::bitset<LANE_LIMIT>> &visit_next) {
-	for (int64_t i = 0; i < input_size; i++) {
-		if (!visit[i].any()) {
-			continue;
-		}
-
-		for (auto index = (int64_t)csr->v[i]; index < (int64_t)csr->v[i + 1]; index++) {
-			auto n = csr->e[index];
-			visit_next[n] = visit_next[n] | visit[i];
-		}
-	}
-
-	for (int64_t i = 0; i < input_size; i++) {
-		if (visit_next[i].none()) {
-			continue;
-		}
-		visit_next[i] = visit_next[i] & ~seen[i];
-		seen[i] = seen[i] | visit_next[i];
-		if (exit_early && visit_next[i].any()) {
-			exit_early = false;
-		}
-	}
-	return exit_early;
-}
-
-static pair<bool, size_t> BfsTempStateVariant(bool exit_early, CSR *csr, int64_t input_size,
-                                              vector<std::bitset<LANE_LIMIT>> &seen,
-                                              vector<std::bitset<LANE_LIMIT>> &visit,
-                                              vector<std::bitset<LANE_LIMIT>> &visit_next) {
-	size_t num_nodes_to_visit = 0;
-	for (int64_t i = 0; i < input_size; i++) {
-		if (!visit[i].any()) {
-			continue;
-		}
-
-		for (auto index = (int64_t)csr->v[i]; index < (int64_t)csr->v[i + 1]; index++) {
-			auto n = csr->e[index];
-			visit_next[n] = visit_next[n] | visit[i];
-		}
-	}
-
-	for (int64_t i = 0; i < input_size; i++) {
-		if (visit_next[i].none()) {
-			continue;
-		}
-		visit_next[i] = visit_next[i] & ~seen[i];
-		seen[i] = seen[i] | visit_next[i];
-		if (exit_early && visit_next[i].any()) {
-			exit_early = false;
-		}
-		if (visit_next[i].any()) {
-			num_nodes_to_visit++;
-		}
-	}
-	return pair<bool, size_t>(exit_early, num_nodes_to_visit);
-}
-
-static bool BfsWithArrayVariant(bool exit_early, CSR *csr, vector<std::bitset<LANE_LIMIT>> &seen,
-                                vector<std::bitset<LANE_LIMIT>> &visit, vector<std::bitset<LANE_LIMIT>> &visit_next,
-                                vector<int64_t> &visit_list) {
-	unordered_set<int64_t> neighbours_set;
-	for (int64_t i : visit_list) {
-		for (auto index = (int64_t)csr->v[i]; index < (int64_t)csr->v[i + 1]; index++) {
-			auto n = csr->e[index];
-			visit_next[n] = visit_next[n] | visit[i];
-			neighbours_set.insert(n);
-		}
-	}
-	visit_list.clear();
-	for (int64_t i : neighbours_set) {
-		visit_next[i] = visit_next[i] & ~seen[i];
-		seen[i] = seen[i] | visit_next[i];
-		if (exit_early && visit_next[i].any()) {
-			exit_early = false;
-		}
-		if (visit_next[i].any()) {
-			visit_list.push_back(i);
-		}
-	}
-	return exit_early;
-}
-
-static int FindMode(int mode, size_t visit_list_len, size_t visit_limit, size_t num_nodes_to_visit) {
-	if (mode == 0 && visit_list_len > 0) {
-		mode = 1;
-	} else if (mode == 1 && visit_list_len > visit_limit) {
-		mode = 2;
-	} else if (mode == 2 && num_nodes_to_visit < visit_limit) {
-		mode = 0;
-	}
-	return mode;
-}
-
-static void ReachabilityFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
-	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
-
-	bool is_variant = args.data[1].GetValue(0).GetValue<bool>();
-	int64_t input_size = args.data[2].GetValue(0).GetValue<int64_t>();
-
+template <class GRAPH>
+static void ReachabilitySearch(const GRAPH &graph, const TraversalOptions<GRAPH> &options, int64_t input_size,
+                               DataChunk &args, Vector &result) {
 	auto &src = args.data[3];
 
 	UnifiedVectorFormat vdata_src, vdata_target;
 	src.ToUnifiedFormat(args.size(), vdata_src);
 
-	auto src_data = vdata_src.data;
+	auto src_data = reinterpret_cast<int64_t *>(vdata_src.data);
 
 	auto &target = args.data[4];
 	target.ToUnifiedFormat(args.size(), vdata_target);
-	auto target_data = vdata_target.data;
+	auto target_data = reinterpret_cast<int64_t *>(vdata_target.data);
 
 	idx_t result_size = 0;
-	vector<int64_t> visit_list;
-	size_t visit_limit = input_size / VISIT_SIZE_DIVISOR;
-	size_t num_nodes_to_visit = 0;
 	result.SetVectorType(VectorType::FLAT_VECTOR);
 
 	auto result_data = FlatVector::GetData<bool>(result);
-	auto duckpgq_state = GetDuckPGQState(info.context);
-
-	CSR *csr = duckpgq_state->GetCSR(info.csr_id);
 
+	LaneBfs bfs(input_size);
 	while (result_size < args.size()) {
-		vector<std::bitset<LANE_LIMIT>> seen(input_size);
-		vector<std::bitset<LANE_LIMIT>> visit(input_size);
-		vector<std::bitset<LANE_LIMIT>> visit_next(input_size);
+		bfs.Reset();
 
 		//! mapping of src_value ->  (bfs_num/lane, vector of indices in src_data)
 		unordered_map<int64_t, pair<int16_t, vector<idx_t>>> lane_map;
-		auto curr_batch_size = InitialiseBfs(result_size, args.size(), src_data, vdata_src.sel, vdata_src.validity,
-		                                     seen, visit, visit_next, lane_map);
-		int mode = 0;
-		bool exit_early = false;
-		while (!exit_early) {
-			exit_early = true;
-			if (is_variant) {
-				mode = FindMode(mode, visit_list.size(), visit_limit, num_nodes_to_visit);
-				switch (mode) {
-				case 1:
-					exit_early = BfsWithArrayVariant(exit_early, csr, seen, visit, visit_next, visit_list);
-					break;
-				case 0:
-					exit_early =
-					    BfsWithoutArrayVariant(exit_early, csr, input_size, seen, visit, visit_next, visit_list);
-					break;
-				case 2: {
-					auto return_pair = BfsTempStateVariant(exit_early, csr, input_size, seen, visit, visit_next);
-					exit_early = return_pair.first;
-					num_nodes_to_visit = return_pair.second;
-					break;
-				}
-				default:
-					throw Exception(ExceptionType::INTERNAL, "Unknown reachability mode encountered");
-				}
-			} else {
-				exit_early = BfsWithoutArray(exit_early, csr, input_size, seen, visit, visit_next);
-			}
-
-			visit = visit_next;
-			for (auto i = 0; i < input_size; i++) {
-				visit_next[i] = 0;
-			}
+		auto curr_batch_size = InitialiseBfs(graph, result_size, args.size(), src_data, vdata_src.sel,
+		                                     vdata_src.validity, bfs, lane_map);
+		// EdgeMap switches between sparse and dense passes on its own
+		while (bfs.Step(graph, options)) {
 		}
 
 		for (const auto &iter : lane_map) {
@@ -239,9 +73,7 @@ static void ReachabilityFunction(DataChunk &args, ExpressionState &state, Vector
 			auto pos = iter.second.second;
 			for (auto index : pos) {
 				auto target_index = vdata_target.sel->get_index(index);
-				if (seen[target_data[target_index]][bfs_num] && seen[value][bfs_num]) {
-					// if(is_bit_set(seen[target_data[index]], bfs_num) &
-					// is_bit_set(seen[value], bfs_num) ) {
+				if (bfs.seen[graph.ToInternal(target_data[target_index])][bfs_num] && bfs.seen[value][bfs_num]) {
 					result_data[index] = true;
 				} else {
 					result_data[index] = false;
@@ -250,6 +82,29 @@ static void ReachabilityFunction(DataChunk &args, ExpressionState &state, Vector
 		}
 		result_size = result_size + curr_batch_size;
 	}
+}
+
+static void ReachabilityFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	// the variant flag in args.data[1] is ignored, EdgeMap picks sparse or dense passes per level
+	int64_t input_size = args.data[2].GetValue(0).GetValue<int64_t>();
+
+	if (duckpgq_state->csr_list.find(info.csr_id) == duckpgq_state->csr_list.end()) {
+		auto dynamic_graph = duckpgq_state->GetDynamicGraph(info.csr_id);
+		if (dynamic_graph) {
+			CSRReadGuard read_guard(dynamic_graph->access_lock);
+			ReachabilitySearch(*dynamic_graph, GetTraversalOptions(info.context, *dynamic_graph), input_size, args,
+			                   result);
+			return;
+		}
+	}
+	CSR *csr = duckpgq_state->GetCSR(info.csr_id);
+	ApplyVertexReordering(info.context, *duckpgq_state, *csr);
+	CSRReadGuard read_guard(*csr);
+	ReachabilitySearch(*csr, GetTraversalOptions(info.context, *csr), input_size, args, result);
 	duckpgq_state->csr_to_delete.insert(info.csr_id);
 }
 
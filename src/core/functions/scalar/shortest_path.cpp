@@ -2,43 +2,13 @@
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckpgq/common.hpp"
 #include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
 
 #include <duckpgq/core/functions/scalar.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
 
 namespace duckdb {
 
-static bool IterativeLength(int64_t v_size, int64_t *V, vector<int64_t> &E, vector<int64_t> &edge_ids,
-                            vector<std::vector<int64_t>> &parents_v, vector<std::vector<int64_t>> &parents_e,
-                            vector<std::bitset<LANE_LIMIT>> &seen, vector<std::bitset<LANE_LIMIT>> &visit,
-                            vector<std::bitset<LANE_LIMIT>> &next) {
-	bool change = false;
-	for (auto v = 0; v < v_size; v++) {
-		next[v] = 0;
-	}
-	//! Keep track of edge id through which the node was reached
-	for (auto v = 0; v < v_size; v++) {
-		if (visit[v].any()) {
-			for (auto e = V[v]; e < V[v + 1]; e++) {
-				auto n = E[e];
-				auto edge_id = edge_ids[e];
-				next[n] = next[n] | visit[v];
-				for (auto l = 0; l < LANE_LIMIT; l++) {
-					parents_v[n][l] = ((parents_v[n][l] == -1) && visit[v][l]) ? v : parents_v[n][l];
-					parents_e[n][l] = ((parents_e[n][l] == -1) && visit[v][l]) ? edge_id : parents_e[n][l];
-				}
-			}
-		}
-	}
-
-	for (auto v = 0; v < v_size; v++) {
-		next[v] = next[v] & ~seen[v];
-		seen[v] = seen[v] | next[v];
-		change |= next[v].any();
-	}
-	return change;
-}
-
 static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
 	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
@@ -54,11 +24,14 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 	if (!csr->initialized_v) {
 		throw ConstraintException("Need to initialize CSR before doing shortest path");
 	}
+	ApplyVertexReordering(info.context, *duckpgq_state, *csr);
+	CSRReadGuard read_guard(*csr);
 	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
 
-	auto *v = reinterpret_cast<int64_t *>(csr->v);
-	vector<int64_t> &e = csr->e;
-	vector<int64_t> &edge_ids = csr->edge_ids;
+	// pulling would pick other parents than the ascending push order, keep the paths stable
+	auto options = GetTraversalOptions(info.context, *csr);
+	options.in_graph = nullptr;
+	options.transpose_source = nullptr;
 
 	auto &src = args.data[2];
 	auto &target = args.data[3];
@@ -74,12 +47,16 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 	auto result_data = FlatVector::GetData<list_entry_t>(result);
 	ValidityMask &result_validity = FlatVector::Validity(result);
 
-	// create temp SIMD arrays
-	vector<std::bitset<LANE_LIMIT>> seen(v_size);
-	vector<std::bitset<LANE_LIMIT>> visit1(v_size);
-	vector<std::bitset<LANE_LIMIT>> visit2(v_size);
+	LaneBfs bfs(v_size);
+	//! Vertex through which a lane first reached a vertex, the edge is looked up when the path is built
 	vector<std::vector<int64_t>> parents_v(v_size, std::vector<int64_t>(LANE_LIMIT, -1));
-	vector<std::vector<int64_t>> parents_e(v_size, std::vector<int64_t>(LANE_LIMIT, -1));
+	auto record_parent = [&](int64_t src, int64_t dst, const std::bitset<LANE_LIMIT> &lanes) {
+		for (auto l = 0; l < LANE_LIMIT; l++) {
+			if (lanes[l] && parents_v[dst][l] == -1) {
+				parents_v[dst][l] = src;
+			}
+		}
+	};
 
 	// maps lane to search number
 	int64_t lane_to_num[LANE_LIMIT];
@@ -91,14 +68,9 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 	int64_t started_searches = 0;
 	while (started_searches < args.size()) {
 
-		// empty visit vectors
+		bfs.Reset();
 		for (auto i = 0; i < v_size; i++) {
-			seen[i] = 0;
-			visit1[i] = 0;
-			for (auto j = 0; j < LANE_LIMIT; j++) {
-				parents_v[i][j] = -1;
-				parents_e[i][j] = -1;
-			}
+			std::fill(parents_v[i].begin(), parents_v[i].end(), -1);
 		}
 
 		// add search jobs to free lanes
@@ -111,11 +83,10 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 				if (!vdata_src.validity.RowIsValid(src_pos)) {
 					result_validity.SetInvalid(search_num);
 				} else {
-					visit1[src_data[src_pos]][lane] = true;
-					parents_v[src_data[src_pos]][lane] = src_data[src_pos]; // Mark source with source id
-					parents_e[src_data[src_pos]][lane] = -2; // Mark the source with -2, there is no incoming edge for
-					                                         // the source.
-					lane_to_num[lane] = search_num;          // active lane
+					auto src_vertex = csr->ToInternal(src_data[src_pos]);
+					bfs.AddSource(src_vertex, lane, false);
+					parents_v[src_vertex][lane] = src_vertex; // Mark source with source id
+					lane_to_num[lane] = search_num;           // active lane
 					active++;
 					break;
 				}
@@ -125,8 +96,7 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 		//! make passes while a lane is still active
 		for (int64_t iter = 1; active; iter++) {
 			//! Perform one step of bfs exploration
-			if (!IterativeLength(v_size, v, e, edge_ids, parents_v, parents_e, seen, (iter & 1) ? visit1 : visit2,
-			                     (iter & 1) ? visit2 : visit1)) {
+			if (!bfs.Step(*csr, options, record_parent)) {
 				break;
 			}
 			int64_t finished_searches = 0;
@@ -136,12 +106,13 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 				if (search_num >= 0) { // active lane
 					//! Check if dst for a source has been seen
 					auto dst_pos = vdata_dst.sel->get_index(search_num);
-					if (seen[dst_data[dst_pos]][lane]) {
+					if (bfs.seen[csr->ToInternal(dst_data[dst_pos])][lane]) {
 						finished_searches++;
 					}
 				}
 			}
-			if (finished_searches == LANE_LIMIT) {
+			// later levels only add parents to vertices that are not on the paths found so far
+			if (finished_searches == static_cast<int64_t>(active)) {
 				break;
 			}
 		}
@@ -166,10 +137,11 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 			}
 			std::vector<int64_t> output_vector;
 			std::vector<int64_t> output_edge;
-			auto source_v = src_data[src_pos]; // Take the source
+			auto source_v = csr->ToInternal(src_data[src_pos]); // Take the source
+			auto dst_v = csr->ToInternal(dst_data[dst_pos]);
 
-			auto parent_vertex = parents_v[dst_data[dst_pos]][lane]; // Take the parent vertex of the destination vertex
-			auto parent_edge = parents_e[dst_data[dst_pos]][lane];   // Take the parent edge of the destination vertex
+			auto parent_vertex = parents_v[dst_v][lane]; // Take the parent vertex of the destination vertex
+			auto parent_edge = parent_vertex < 0 ? -1 : csr->FindEdgeId(parent_vertex, dst_v);
 
 			output_vector.push_back(dst_data[dst_pos]); // Add destination vertex
 			output_vector.push_back(parent_edge);
@@ -180,16 +152,17 @@ static void ShortestPathFunction(DataChunk &args, ExpressionState &state, Vector
 					result_validity.SetInvalid(search_num);
 					break;
 				}
-				output_vector.push_back(parent_vertex);
-				parent_edge = parents_e[parent_vertex][lane];
-				parent_vertex = parents_v[parent_vertex][lane];
+				output_vector.push_back(csr->ToExternal(parent_vertex));
+				auto child_vertex = parent_vertex;
+				parent_vertex = parents_v[child_vertex][lane];
+				parent_edge = parent_vertex < 0 ? -1 : csr->FindEdgeId(parent_vertex, child_vertex);
 				output_vector.push_back(parent_edge);
 			}
 
 			if (!result_validity.RowIsValid(search_num)) {
 				continue;
 			}
-			output_vector.push_back(source_v);
+			output_vector.push_back(src_data[src_pos]);
 			std::reverse(output_vector.begin(), output_vector.end());
 			auto output = make_uniq<Vector>(LogicalType::LIST(LogicalType::BIGINT));
 			for (auto val : output_vector) {
@@ -0,0 +1,371 @@
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/function_data/strongly_connected_component_function_data.hpp>
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq/core/utils/graph_traversal.hpp>
+
+#include <atomic>
+
+namespace duckdb {
+
+//! Trimming passes before the forward-backward search
+#define SCC_TRIM_ROUNDS 3
+#define SCC_UNASSIGNED -1
+
+// Multistep (Slota et al.): trim vertices without an active in- or out-neighbour, which are components of their own,
+// split off the component of a high-degree pivot with one forward and one backward search, usually the giant
+// component, and split the rest by colour propagation. Every pass runs on the task scheduler. scc[v] is set once v
+// is assigned, to a vertex of its component, and relabelled at the end.
+class StronglyConnectedComponents {
+public:
+	StronglyConnectedComponents(ClientContext &context, const CSR &csr, const CSRTranspose &transpose)
+	    : context(context), csr(csr), transpose(transpose), vertex_count(csr.VertexCount()),
+	      scc(new std::atomic<int64_t>[csr.VertexCount()]), color(new std::atomic<int64_t>[csr.VertexCount()]) {
+		ForEachVertex([&](int64_t vertex) { scc[vertex].store(SCC_UNASSIGNED, std::memory_order_relaxed); });
+	}
+
+	//! Component of every vertex, labelled by the smallest rowid in it, dictionary maps dense ids to rowids
+	vector<int64_t> Run(const VertexDictionary *dictionary) {
+		Trim();
+		SplitPivot();
+		while (SplitColors()) {
+		}
+		vector<int64_t> component(vertex_count);
+		ForEachVertex([&](int64_t vertex) { component[vertex] = scc[vertex].load(std::memory_order_relaxed); });
+		LabelComponentsBySmallestRowid(&context, &csr, dictionary, component);
+		return component;
+	}
+
+private:
+	template <class FUNC>
+	void ForEachVertex(FUNC &&fun) {
+		TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+			for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+				fun(vertex);
+			}
+		});
+	}
+	bool Active(int64_t vertex) const {
+		return scc[vertex].load(std::memory_order_relaxed) == SCC_UNASSIGNED;
+	}
+	//! Assigns vertex to the component of representative, false when it already has one
+	bool Claim(int64_t vertex, int64_t representative) {
+		int64_t expected = SCC_UNASSIGNED;
+		return scc[vertex].compare_exchange_strong(expected, representative);
+	}
+	template <class FUNC>
+	void ForEachInNeighbor(int64_t vertex, FUNC &&fun) const {
+		transpose.ForEachInEdge(vertex, [&](int64_t src, int64_t offset) { fun(src); });
+	}
+
+	//! Level-synchronous search from frontier along out-edges, or in-edges when forward is false. visit(u, w) is
+	//! called for the edges of every reached vertex u and returns true when it claimed w for the search.
+	template <class VISIT>
+	void Search(vector<int64_t> frontier, bool forward, VISIT &&visit) {
+		while (!frontier.empty()) {
+			vector<int64_t> next;
+			mutex next_lock;
+			TraversalParallelFor(&context, frontier.size(), [&](idx_t begin, idx_t end) {
+				vector<int64_t> reached;
+				for (auto i = begin; i < end; i++) {
+					auto vertex = frontier[i];
+					auto on_neighbor = [&](int64_t neighbor) {
+						if (visit(vertex, neighbor)) {
+							reached.push_back(neighbor);
+						}
+					};
+					if (forward) {
+						csr.ForEachNeighbor(vertex, on_neighbor);
+					} else {
+						ForEachInNeighbor(vertex, on_neighbor);
+					}
+				}
+				lock_guard<mutex> guard(next_lock);
+				next.insert(next.end(), reached.begin(), reached.end());
+			});
+			frontier = std::move(next);
+		}
+	}
+
+	void Trim() {
+		vector<uint8_t> trimmed(vertex_count, 0);
+		for (idx_t round = 0; round < SCC_TRIM_ROUNDS; round++) {
+			std::atomic<bool> any_trimmed(false);
+			ForEachVertex([&](int64_t vertex) {
+				if (!Active(vertex)) {
+					return;
+				}
+				bool has_out = false;
+				bool has_in = false;
+				csr.ForEachNeighbor(vertex, [&](int64_t neighbor) {
+					has_out = has_out || (neighbor != vertex && Active(neighbor));
+				});
+				ForEachInNeighbor(vertex, [&](int64_t neighbor) {
+					has_in = has_in || (neighbor != vertex && Active(neighbor));
+				});
+				if (!has_out || !has_in) {
+					trimmed[vertex] = 1;
+					any_trimmed.store(true, std::memory_order_relaxed);
+				}
+			});
+			if (!any_trimmed) {
+				return;
+			}
+			ForEachVertex([&](int64_t vertex) {
+				if (trimmed[vertex]) {
+					scc[vertex].store(vertex, std::memory_order_relaxed);
+					trimmed[vertex] = 0;
+				}
+			});
+		}
+	}
+
+	void SplitPivot() {
+		// the active vertex with the most in- times out-edges, ties to the smaller vertex
+		using Candidate = std::pair<int64_t, int64_t>;
+		auto pivot = TraversalParallelReduce<Candidate>(
+		    &context, vertex_count, Candidate(-1, -1),
+		    [&](idx_t begin, idx_t end) {
+			    Candidate best(-1, -1);
+			    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+				    auto score = (csr.Degree(vertex) + 1) * (transpose.Degree(vertex) + 1);
+				    if (Active(vertex) && score > best.first) {
+					    best = Candidate(score, vertex);
+				    }
+			    }
+			    return best;
+		    },
+		    [](const Candidate &a, const Candidate &b) { return b.first > a.first ? b : a; });
+		if (pivot.second < 0) {
+			return;
+		}
+		unique_ptr<std::atomic<uint8_t>[]> forward(new std::atomic<uint8_t>[vertex_count]);
+		ForEachVertex([&](int64_t vertex) { forward[vertex].store(0, std::memory_order_relaxed); });
+		forward[pivot.second].store(1);
+		Search({pivot.second}, true, [&](int64_t vertex, int64_t neighbor) {
+			return Active(neighbor) && !forward[neighbor].load(std::memory_order_relaxed) &&
+			       !forward[neighbor].exchange(1);
+		});
+		// the vertices that reach the pivot among those it reaches
+		scc[pivot.second].store(pivot.second);
+		Search({pivot.second}, false, [&](int64_t vertex, int64_t neighbor) {
+			return forward[neighbor].load(std::memory_order_relaxed) && Claim(neighbor, pivot.second);
+		});
+	}
+
+	//! Lowers colour[vertex] to value, true when it was higher
+	bool LowerColor(int64_t vertex, int64_t value) {
+		auto current = color[vertex].load(std::memory_order_relaxed);
+		while (value < current) {
+			if (color[vertex].compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//! Returns false once every vertex has a component
+	bool SplitColors() {
+		// colour[v] becomes the smallest active vertex that reaches v over active vertices. Every thread pushes the
+		// colours of its range along the out-edges and keeps going from each vertex it lowered, so a colour travels a
+		// whole path in one pass instead of one hop per sweep. Whoever lowers a vertex pushes it again, which makes the
+		// fixpoint independent of the schedule.
+		ForEachVertex([&](int64_t vertex) {
+			color[vertex].store(Active(vertex) ? vertex : SCC_UNASSIGNED, std::memory_order_relaxed);
+		});
+		TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+			vector<int64_t> stack;
+			// the smallest colours of the range are pushed first, they lower the most vertices
+			for (auto vertex = static_cast<int64_t>(end) - 1; vertex >= static_cast<int64_t>(begin); vertex--) {
+				if (Active(vertex)) {
+					stack.push_back(vertex);
+				}
+			}
+			while (!stack.empty()) {
+				auto vertex = stack.back();
+				stack.pop_back();
+				auto vertex_color = color[vertex].load(std::memory_order_relaxed);
+				csr.ForEachNeighbor(vertex, [&](int64_t neighbor) {
+					if (Active(neighbor) && LowerColor(neighbor, vertex_color)) {
+						stack.push_back(neighbor);
+					}
+				});
+			}
+		});
+		// a vertex that kept its own colour is the root of its colour, the vertices of that colour that reach it form
+		// its component
+		vector<int64_t> roots;
+		mutex roots_lock;
+		TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+			vector<int64_t> range_roots;
+			for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+				if (Active(vertex) && color[vertex].load(std::memory_order_relaxed) == vertex) {
+					range_roots.push_back(vertex);
+				}
+			}
+			lock_guard<mutex> guard(roots_lock);
+			roots.insert(roots.end(), range_roots.begin(), range_roots.end());
+		});
+		if (roots.empty()) {
+			return false;
+		}
+		for (auto root : roots) {
+			scc[root].store(root, std::memory_order_relaxed);
+		}
+		Search(std::move(roots), false, [&](int64_t vertex, int64_t neighbor) {
+			auto root = color[vertex].load(std::memory_order_relaxed);
+			return color[neighbor].load(std::memory_order_relaxed) == root && Claim(neighbor, root);
+		});
+		return true;
+	}
+
+	ClientContext &context;
+	const CSR &csr;
+	const CSRTranspose &transpose;
+	int64_t vertex_count;
+	unique_ptr<std::atomic<int64_t>[]> scc;
+	unique_ptr<std::atomic<int64_t>[]> color;
+};
+
+//! Distinct (source, destination) component pairs of the edges between components, sorted
+static vector<std::pair<int64_t, int64_t>> BuildCondensation(ClientContext &context, const CSR &csr,
+                                                             const vector<int64_t> &component) {
+	using Edges = vector<std::pair<int64_t, int64_t>>;
+	auto condensation = TraversalParallelReduce<Edges>(
+	    &context, csr.VertexCount(), Edges(),
+	    [&](idx_t begin, idx_t end) {
+		    Edges edges;
+		    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			    csr.ForEachNeighbor(vertex, [&](int64_t neighbor) {
+				    if (component[vertex] != component[neighbor]) {
+					    edges.emplace_back(component[vertex], component[neighbor]);
+				    }
+			    });
+		    }
+		    std::sort(edges.begin(), edges.end());
+		    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		    return edges;
+	    },
+	    [](Edges &a, Edges &b) {
+		    a.insert(a.end(), b.begin(), b.end());
+		    return std::move(a);
+	    });
+	std::sort(condensation.begin(), condensation.end());
+	condensation.erase(std::unique(condensation.begin(), condensation.end()), condensation.end());
+	return condensation;
+}
+
+//! The CSR of info, with its components (and condensation) computed by the first chunk
+static CSR &GetComponentCSR(StronglyConnectedComponentFunctionData &info) {
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_e) {
+		throw ConstraintException("Need to initialize CSR before doing strongly connected components.");
+	}
+	auto &csr = *csr_entry->second;
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	if (!info.state_converged) {
+		std::lock_guard<std::mutex> guard(info.scc_lock);
+		if (!info.state_converged) {
+			csr.Compact();
+			CSRReadGuard read_guard(csr);
+			StronglyConnectedComponents components(info.context, csr, csr.GetTranspose());
+			info.component = components.Run(duckpgq_state->GetRowidDictionary(info.csr_id, csr.VertexCount()));
+			if (info.build_condensation) {
+				info.condensation = BuildCondensation(info.context, csr, info.component);
+			}
+			info.state_converged = true;
+		}
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+	return csr;
+}
+
+static void StronglyConnectedComponentFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<StronglyConnectedComponentFunctionData>();
+	auto &csr = GetComponentCSR(info);
+
+	UnifiedVectorFormat vdata_src;
+	args.data[1].ToUnifiedFormat(args.size(), vdata_src);
+	auto src_data = UnifiedVectorFormat::GetData<int64_t>(vdata_src);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<int64_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < args.size(); i++) {
+		auto src_index = vdata_src.sel->get_index(i);
+		auto src_node = csr.ToInternal(src_data[src_index]);
+		if (vdata_src.validity.RowIsValid(src_index) && src_node >= 0 && src_node < csr.VertexCount()) {
+			result_data[i] = info.component[src_node];
+		} else {
+			result_validity.SetInvalid(i);
+		}
+	}
+}
+
+static void StronglyConnectedComponentSuccessorsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<StronglyConnectedComponentFunctionData>();
+	auto &csr = GetComponentCSR(info);
+	auto dictionary = GetDuckPGQState(info.context)->GetRowidDictionary(info.csr_id, csr.VertexCount());
+
+	UnifiedVectorFormat vdata_src;
+	args.data[1].ToUnifiedFormat(args.size(), vdata_src);
+	auto src_data = UnifiedVectorFormat::GetData<int64_t>(vdata_src);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<list_entry_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	idx_t list_size = 0;
+	for (idx_t i = 0; i < args.size(); i++) {
+		auto src_index = vdata_src.sel->get_index(i);
+		auto src_node = csr.ToInternal(src_data[src_index]);
+		if (!vdata_src.validity.RowIsValid(src_index) || src_node < 0 || src_node >= csr.VertexCount()) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i].offset = list_size;
+		result_data[i].length = 0;
+		// only the vertex that labels a component lists its successors, so every condensation edge appears once
+		auto label = info.component[src_node];
+		if (label != VertexRowid(dictionary, src_data[src_index])) {
+			continue;
+		}
+		using ComponentEdge = std::pair<int64_t, int64_t>;
+		auto successors =
+		    std::equal_range(info.condensation.begin(), info.condensation.end(), ComponentEdge(label, 0),
+		                     [](const ComponentEdge &a, const ComponentEdge &b) { return a.first < b.first; });
+		auto count = static_cast<idx_t>(successors.second - successors.first);
+		ListVector::Reserve(result, list_size + count);
+		auto successor_data = FlatVector::GetData<int64_t>(ListVector::GetEntry(result));
+		for (auto it = successors.first; it != successors.second; it++) {
+			successor_data[list_size++] = it->second;
+		}
+		result_data[i].length = count;
+	}
+	ListVector::SetListSize(result, list_size);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterStronglyConnectedComponentScalarFunctions(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. vertex rowid
+	 */
+	loader.RegisterFunction(ScalarFunction("strongly_connected_component", {LogicalType::INTEGER, LogicalType::BIGINT},
+	                                       LogicalType::BIGINT, StronglyConnectedComponentFunction,
+	                                       StronglyConnectedComponentFunctionData::StronglyConnectedComponentBind));
+
+	/* 1. CSR ID
+	 * 2. vertex rowid, returns the components the component labelled by it has edges into
+	 */
+	loader.RegisterFunction(ScalarFunction(
+	    "strongly_connected_component_successors", {LogicalType::INTEGER, LogicalType::BIGINT},
+	    LogicalType::LIST(LogicalType::BIGINT), StronglyConnectedComponentSuccessorsFunction,
+	    StronglyConnectedComponentFunctionData::StronglyConnectedComponentBind));
+}
+
+} // namespace duckdb
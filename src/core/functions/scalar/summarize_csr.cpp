@@ -0,0 +1,223 @@
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/summarize_csr_function_data.hpp"
+#include "duckpgq/core/utils/duckpgq_utils.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <duckpgq/core/functions/scalar.hpp>
+
+#include <cmath>
+
+namespace duckdb {
+
+//! Vertices per degree, only the distinct degrees are kept so ranges merge cheaply
+using DegreeHistogram = unordered_map<int64_t, int64_t>;
+
+struct LabelHistograms {
+	int64_t edge_count = 0;
+	int64_t self_loops = 0;
+	DegreeHistogram in_degrees;
+	DegreeHistogram out_degrees;
+};
+
+static CSRDegreeSummary SummarizeDegrees(const DegreeHistogram &histogram) {
+	vector<std::pair<int64_t, int64_t>> degrees(histogram.begin(), histogram.end());
+	std::sort(degrees.begin(), degrees.end());
+	CSRDegreeSummary result;
+	if (degrees.empty()) {
+		return result;
+	}
+	for (auto &entry : degrees) {
+		result.vertices += entry.second;
+		result.sum += entry.first * entry.second;
+	}
+	result.min = degrees.front().first;
+	result.max = degrees.back().first;
+	auto quantile = [&](double q) {
+		auto rank = static_cast<int64_t>(std::floor(q * static_cast<double>(result.vertices - 1)));
+		int64_t below = 0;
+		for (auto &entry : degrees) {
+			below += entry.second;
+			if (rank < below) {
+				return entry.first;
+			}
+		}
+		return result.max;
+	};
+	result.q25 = quantile(0.25);
+	result.q50 = quantile(0.5);
+	result.q75 = quantile(0.75);
+	return result;
+}
+
+//! Statistics of every edge label in one parallel pass over the vertices. Every vertex counts its out-edges per label
+//! in the CSR and its in-edges per label in the transpose, and adds its degrees to the histograms of its range.
+static vector<CSRLabelSummary> SummarizeCSR(ClientContext &context, CSR &csr) {
+	auto vertex_count = csr.VertexCount();
+	auto &transpose = csr.GetTranspose();
+	auto offsets = reinterpret_cast<int64_t *>(csr.v);
+	// a CSR built from a single edge table has no label tags, all its edges are label 0
+	auto label_of = [&](int64_t offset) -> idx_t {
+		return csr.edge_labels.empty() ? 0 : csr.edge_labels[offset];
+	};
+
+	auto labels = TraversalParallelReduce<vector<LabelHistograms>>(
+	    &context, vertex_count, vector<LabelHistograms>(CSR_MAX_EDGE_LABELS),
+	    [&](idx_t begin, idx_t end) {
+		    vector<LabelHistograms> range(CSR_MAX_EDGE_LABELS);
+		    vector<int64_t> out_degree(CSR_MAX_EDGE_LABELS, 0);
+		    vector<int64_t> in_degree(CSR_MAX_EDGE_LABELS, 0);
+		    // labels with edges at the current vertex, so only those are reset
+		    vector<idx_t> touched;
+		    auto touch = [&](idx_t label) {
+			    if (out_degree[label] == 0 && in_degree[label] == 0) {
+				    touched.push_back(label);
+			    }
+		    };
+		    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			    for (auto offset = offsets[vertex]; offset < offsets[vertex + 1]; offset++) {
+				    auto label = label_of(offset);
+				    touch(label);
+				    out_degree[label]++;
+				    range[label].self_loops += csr.e[offset] == vertex;
+			    }
+			    transpose.ForEachInEdge(vertex, [&](int64_t, int64_t offset) {
+				    auto label = label_of(offset);
+				    touch(label);
+				    in_degree[label]++;
+			    });
+			    for (auto label : touched) {
+				    if (out_degree[label] > 0) {
+					    range[label].edge_count += out_degree[label];
+					    range[label].out_degrees[out_degree[label]]++;
+				    }
+				    if (in_degree[label] > 0) {
+					    range[label].in_degrees[in_degree[label]]++;
+				    }
+				    out_degree[label] = 0;
+				    in_degree[label] = 0;
+			    }
+			    touched.clear();
+		    }
+		    return range;
+	    },
+	    [](vector<LabelHistograms> &result, vector<LabelHistograms> &range) {
+		    for (idx_t label = 0; label < result.size(); label++) {
+			    result[label].edge_count += range[label].edge_count;
+			    result[label].self_loops += range[label].self_loops;
+			    for (auto &entry : range[label].in_degrees) {
+				    result[label].in_degrees[entry.first] += entry.second;
+			    }
+			    for (auto &entry : range[label].out_degrees) {
+				    result[label].out_degrees[entry.first] += entry.second;
+			    }
+		    }
+		    return std::move(result);
+	    });
+
+	vector<CSRLabelSummary> summaries(CSR_MAX_EDGE_LABELS);
+	for (idx_t label = 0; label < CSR_MAX_EDGE_LABELS; label++) {
+		summaries[label].edge_count = labels[label].edge_count;
+		summaries[label].self_loops = labels[label].self_loops;
+		summaries[label].in_degree = SummarizeDegrees(labels[label].in_degrees);
+		summaries[label].out_degree = SummarizeDegrees(labels[label].out_degrees);
+	}
+	return summaries;
+}
+
+//! Writes the average, min, max and quartiles of degrees into the children from first on, NULL without vertices
+static void WriteDegreeSummary(vector<unique_ptr<Vector>> &children, idx_t first, idx_t row,
+                               const CSRDegreeSummary &degrees) {
+	if (degrees.vertices == 0) {
+		for (idx_t child = first; child < first + 6; child++) {
+			FlatVector::SetNull(*children[child], row, true);
+		}
+		return;
+	}
+	FlatVector::GetData<double>(*children[first])[row] =
+	    static_cast<double>(degrees.sum) / static_cast<double>(degrees.vertices);
+	FlatVector::GetData<int64_t>(*children[first + 1])[row] = degrees.min;
+	FlatVector::GetData<int64_t>(*children[first + 2])[row] = degrees.max;
+	FlatVector::GetData<int64_t>(*children[first + 3])[row] = degrees.q25;
+	FlatVector::GetData<int64_t>(*children[first + 4])[row] = degrees.q50;
+	FlatVector::GetData<int64_t>(*children[first + 5])[row] = degrees.q75;
+}
+
+static void SummarizeCSRFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<SummarizeCSRFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	if (!info.state_converged) {
+		std::lock_guard<std::mutex> guard(info.summary_lock);
+		if (!info.state_converged) {
+			// a graph without edges never creates its CSR, every label is empty
+			auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+			if (csr_entry == duckpgq_state->csr_list.end()) {
+				info.summaries.assign(CSR_MAX_EDGE_LABELS, CSRLabelSummary());
+			} else {
+				auto &csr = *csr_entry->second;
+				if (!(csr.initialized_v && csr.initialized_e)) {
+					throw ConstraintException("Need to initialize CSR before summarizing it.");
+				}
+				csr.Compact();
+				CSRReadGuard read_guard(csr);
+				info.summaries = SummarizeCSR(info.context, csr);
+			}
+			info.state_converged = true;
+		}
+	}
+
+	auto &label_vector = args.data[1];
+	UnifiedVectorFormat vdata_label;
+	label_vector.ToUnifiedFormat(args.size(), vdata_label);
+	auto label_data = reinterpret_cast<int64_t *>(vdata_label.data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto &children = StructVector::GetEntries(result);
+	auto edge_count_data = FlatVector::GetData<int64_t>(*children[0]);
+	auto source_count_data = FlatVector::GetData<int64_t>(*children[1]);
+	auto destination_count_data = FlatVector::GetData<int64_t>(*children[2]);
+	auto self_loops_data = FlatVector::GetData<int64_t>(*children[15]);
+	for (idx_t n = 0; n < args.size(); n++) {
+		auto label_sel = vdata_label.sel->get_index(n);
+		auto label = label_data[label_sel];
+		if (!vdata_label.validity.RowIsValid(label_sel) || label < 0 || label >= CSR_MAX_EDGE_LABELS) {
+			FlatVector::SetNull(result, n, true);
+			continue;
+		}
+		auto &summary = info.summaries[label];
+		edge_count_data[n] = summary.edge_count;
+		// every vertex with an out-edge is a distinct source, every vertex with an in-edge a distinct destination
+		source_count_data[n] = summary.out_degree.vertices;
+		destination_count_data[n] = summary.in_degree.vertices;
+		WriteDegreeSummary(children, 3, n, summary.in_degree);
+		WriteDegreeSummary(children, 9, n, summary.out_degree);
+		self_loops_data[n] = summary.self_loops;
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterSummarizeCSRScalarFunction(ExtensionLoader &loader) {
+	child_list_t<LogicalType> summary_fields {{"edge_count", LogicalType::BIGINT},
+	                                          {"unique_source_count", LogicalType::BIGINT},
+	                                          {"unique_destination_count", LogicalType::BIGINT}};
+	for (auto &direction : {"in", "out"}) {
+		summary_fields.emplace_back(StringUtil::Format("avg_%s_degree", direction), LogicalType::DOUBLE);
+		for (auto &statistic : {"min", "max", "q25", "q50", "q75"}) {
+			summary_fields.emplace_back(StringUtil::Format("%s_%s_degree", statistic, direction), LogicalType::BIGINT);
+		}
+	}
+	summary_fields.emplace_back("self_loops", LogicalType::BIGINT);
+	/* 1. CSR ID, of a multi-label CSR
+	 * 2. edge label, the position of the edge table in the CSR
+	 */
+	loader.RegisterFunction(ScalarFunction("summarize_csr", {LogicalType::INTEGER, LogicalType::BIGINT},
+	                                       LogicalType::STRUCT(summary_fields), SummarizeCSRFunction,
+	                                       SummarizeCSRFunctionData::SummarizeCSRBind));
+}
+
+} // namespace duckdb
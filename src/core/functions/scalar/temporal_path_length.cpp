@@ -0,0 +1,135 @@
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/functions/function_data/iterative_length_function_data.hpp"
+
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+//! Fewest hops from src to dst over edges with non-decreasing times inside [window_start, window_end].
+//! Level k holds the earliest arrival time at every vertex over journeys of at most k hops, a vertex is expanded
+//! again only when its arrival time improved, and only edges at or after that arrival time are scanned.
+static int64_t TemporalPathLength(const CSR &csr, int64_t v_size, int64_t src, int64_t dst, int64_t window_start,
+                                  int64_t window_end, vector<int64_t> &arrival, vector<int64_t> &frontier,
+                                  vector<int64_t> &next, vector<int64_t> &frontier_arrival) {
+	std::fill(arrival.begin(), arrival.end(), CSR_NO_EDGE_TIME);
+	frontier.clear();
+	arrival[src] = window_start;
+	frontier.push_back(src);
+	for (int64_t hops = 1; hops <= v_size && !frontier.empty(); hops++) {
+		// expand with the arrival times of the previous level, improvements made in this level need one more hop
+		frontier_arrival.clear();
+		for (auto vertex : frontier) {
+			frontier_arrival.push_back(arrival[vertex]);
+		}
+		next.clear();
+		for (idx_t i = 0; i < frontier.size(); i++) {
+			int64_t begin_offset;
+			int64_t end_offset;
+			csr.TimeWindow(frontier[i], frontier_arrival[i], window_end, begin_offset, end_offset);
+			for (auto offset = begin_offset; offset < end_offset; offset++) {
+				auto neighbor = csr.e[offset];
+				if (csr.edge_times[offset] < arrival[neighbor]) {
+					arrival[neighbor] = csr.edge_times[offset];
+					next.push_back(neighbor);
+				}
+			}
+		}
+		if (arrival[dst] != CSR_NO_EDGE_TIME) {
+			return hops;
+		}
+		// a vertex may have improved several times in this level
+		std::sort(next.begin(), next.end());
+		next.erase(std::unique(next.begin(), next.end()), next.end());
+		std::swap(frontier, next);
+	}
+	return -1;
+}
+
+static void TemporalPathLengthFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<IterativeLengthFunctionData>();
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	int64_t v_size = args.data[1].GetValue(0).GetValue<int64_t>();
+	auto window_start = GetTimeWindowBound(args.data[2].GetValue(0), true);
+	auto window_end = GetTimeWindowBound(args.data[3].GetValue(0), false);
+
+	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
+	if (csr_entry == duckpgq_state->csr_list.end() || !csr_entry->second->initialized_v) {
+		throw ConstraintException("Need to initialize CSR before doing shortest path");
+	}
+	auto &csr = *csr_entry->second;
+	if (!csr.initialized_times) {
+		throw ConstraintException("CSR %d has no temporal index, build it with csr_temporal_index", info.csr_id);
+	}
+	ApplyVertexReordering(info.context, *duckpgq_state, csr);
+	// the temporal index only covers the base arrays, compaction merges appended edges and rebuilds it
+	csr.Compact();
+	CSRReadGuard read_guard(csr);
+
+	UnifiedVectorFormat vdata_src;
+	UnifiedVectorFormat vdata_dst;
+	args.data[4].ToUnifiedFormat(args.size(), vdata_src);
+	args.data[5].ToUnifiedFormat(args.size(), vdata_dst);
+	auto src_data = UnifiedVectorFormat::GetData<int64_t>(vdata_src);
+	auto dst_data = UnifiedVectorFormat::GetData<int64_t>(vdata_dst);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<int64_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+
+	vector<int64_t> arrival(v_size);
+	vector<int64_t> frontier;
+	vector<int64_t> next;
+	vector<int64_t> frontier_arrival;
+	for (idx_t search_num = 0; search_num < args.size(); search_num++) {
+		auto src_pos = vdata_src.sel->get_index(search_num);
+		auto dst_pos = vdata_dst.sel->get_index(search_num);
+		if (!vdata_src.validity.RowIsValid(src_pos) || !vdata_dst.validity.RowIsValid(dst_pos)) {
+			result_validity.SetInvalid(search_num);
+			continue;
+		}
+		auto src = src_data[src_pos];
+		auto dst = dst_data[dst_pos];
+		if (src == dst) {
+			result_data[search_num] = 0;
+			continue;
+		}
+		if (window_start > window_end) {
+			result_validity.SetInvalid(search_num);
+			continue;
+		}
+		auto length = TemporalPathLength(csr, v_size, csr.ToInternal(src), csr.ToInternal(dst), window_start,
+		                                 window_end, arrival, frontier, next, frontier_arrival);
+		if (length < 0) {
+			result_validity.SetInvalid(search_num);
+		} else {
+			result_data[search_num] = length;
+		}
+	}
+	duckpgq_state->csr_to_delete.insert(info.csr_id);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterTemporalPathLengthScalarFunction(ExtensionLoader &loader) {
+	/* 1. CSR ID
+	 * 2. Vertex size
+	 * 3. Window start, inclusive
+	 * 4. Window end, inclusive
+	 * 5. source dense id
+	 * 6. destination dense id
+	 */
+	ScalarFunctionSet set("temporal_path_length");
+	for (auto &time_type : {LogicalType::BIGINT, LogicalType::TIMESTAMP}) {
+		set.AddFunction(ScalarFunction(
+		    {LogicalType::INTEGER, LogicalType::BIGINT, time_type, time_type, LogicalType::BIGINT, LogicalType::BIGINT},
+		    LogicalType::BIGINT, TemporalPathLengthFunction, IterativeLengthFunctionData::IterativeLengthBind));
+	}
+	loader.RegisterFunction(set);
+}
+
+} // namespace duckdb
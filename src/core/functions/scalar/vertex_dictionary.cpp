@@ -0,0 +1,202 @@
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckpgq/common.hpp"
+#include <duckpgq/core/functions/scalar.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <duckpgq_extension.hpp>
+
+namespace duckdb {
+
+static VertexDictionary &GetVertexDictionaryOrThrow(DuckPGQState &duckpgq_state, int32_t id) {
+	auto dictionary = duckpgq_state.GetVertexDictionary(id);
+	if (!dictionary) {
+		throw ConstraintException("Vertex dictionary not found with ID %d", id);
+	}
+	return *dictionary;
+}
+
+//! Keys are compared on their encoded bytes, so narrow integer keys are widened to BIGINT to let an INTEGER foreign
+//! key find its BIGINT primary key
+static unique_ptr<FunctionData> VertexDictionaryBind(ClientContext &context, ScalarFunction &bound_function,
+                                                     vector<unique_ptr<Expression>> &arguments) {
+	// the key columns follow the fixed arguments
+	if (arguments.size() <= bound_function.arguments.size()) {
+		throw InvalidInputException("%s needs at least one key column", bound_function.name);
+	}
+	for (idx_t i = 1; i < arguments.size(); i++) {
+		switch (arguments[i]->return_type.id()) {
+		case LogicalTypeId::TINYINT:
+		case LogicalTypeId::SMALLINT:
+		case LogicalTypeId::INTEGER:
+		case LogicalTypeId::UTINYINT:
+		case LogicalTypeId::USMALLINT:
+		case LogicalTypeId::UINTEGER:
+			arguments[i] = BoundCastExpression::AddCastToType(context, std::move(arguments[i]), LogicalType::BIGINT);
+			break;
+		default:
+			break;
+		}
+	}
+	return CSRFunctionData::CSRBind(context, bound_function, arguments);
+}
+
+//! with_rowid: the second argument is the rowid of the vertex, as the CSR builders pass it to map labels back to rows
+static void CreateVertexDictionary(DataChunk &args, ExpressionState &state, Vector &result, bool with_rowid) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	VertexDictionary *dictionary;
+	{
+		lock_guard<mutex> csr_init_lock(duckpgq_state->csr_lock);
+		auto &entry = duckpgq_state->vertex_dictionary_list[info.id];
+		// a user dictionary grows with every insert, a CSR builder dictionary holds the keys of the latest build only
+		auto query = info.context.transaction.GetActiveQuery();
+		if (!entry || (GetVertexDictionaryCSRId(info.id) >= 0 && entry->build_query != query)) {
+			entry = make_uniq<VertexDictionary>();
+			entry->build_query = query;
+		}
+		dictionary = entry.get();
+	}
+
+	vector<string> keys;
+	vector<bool> valid;
+	VertexDictionary::EncodeKeys(args, with_rowid ? 2 : 1, keys, valid);
+	vector<int64_t> rowids;
+	if (with_rowid) {
+		UnifiedVectorFormat rowid_data;
+		args.data[1].ToUnifiedFormat(args.size(), rowid_data);
+		auto rowid_values = UnifiedVectorFormat::GetData<int64_t>(rowid_data);
+		rowids.resize(args.size());
+		for (idx_t row = 0; row < args.size(); row++) {
+			rowids[row] = rowid_values[rowid_data.sel->get_index(row)];
+		}
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<bool>(result);
+	for (idx_t row = 0; row < args.size(); row++) {
+		if (!valid[row]) {
+			throw ConstraintException("Vertex keys cannot be NULL");
+		}
+		result_data[row] = true;
+	}
+	dictionary->Insert(keys, rowids);
+}
+
+static void CreateVertexDictionaryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	CreateVertexDictionary(args, state, result, false);
+}
+
+static void CreateVertexDictionaryWithRowidFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	CreateVertexDictionary(args, state, result, true);
+}
+
+static void VertexDictionaryLookupFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	auto &dictionary = GetVertexDictionaryOrThrow(*duckpgq_state, info.id);
+
+	vector<string> keys;
+	vector<bool> valid;
+	VertexDictionary::EncodeKeys(args, 1, keys, valid);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<int64_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	// the first lookup merges the inserted keys, after that the lookups only read the dictionary
+	dictionary.Finalize();
+	for (idx_t row = 0; row < args.size(); row++) {
+		auto dense_id = valid[row] ? dictionary.Lookup(keys[row]) : -1;
+		if (dense_id < 0) {
+			result_validity.SetInvalid(row);
+			continue;
+		}
+		result_data[row] = dense_id;
+	}
+}
+
+static void VertexDictionarySizeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+	auto &dictionary = GetVertexDictionaryOrThrow(*duckpgq_state, info.id);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int64_t>(result);
+	dictionary.Finalize();
+	auto size = static_cast<int64_t>(dictionary.Size());
+	// with the number of inserted rows, fewer distinct keys than rows means the vertex keys are not unique
+	if (args.ColumnCount() > 1 && args.data[1].GetValue(0).GetValue<int64_t>() != size) {
+		throw ConstraintException("Non-existent/non-unique vertices detected. Make sure all "
+		                          "vertices referred by edge tables exist and are unique for path-finding queries.");
+	}
+	result_data[0] = size;
+}
+
+static void DeleteVertexDictionaryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &info = func_expr.bind_info->Cast<CSRFunctionData>();
+
+	auto duckpgq_state = GetDuckPGQState(info.context);
+
+	idx_t flag;
+	{
+		lock_guard<mutex> csr_init_lock(duckpgq_state->csr_lock);
+		flag = duckpgq_state->vertex_dictionary_list.erase(info.id);
+	}
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<bool>(result);
+	result_data[0] = flag == 1;
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreScalarFunctions::RegisterVertexDictionaryScalarFunctions(ExtensionLoader &loader) {
+	/* 1. Dictionary ID
+	 * 2.. key columns of the vertex table
+	 */
+	ScalarFunction create("create_vertex_dictionary", {LogicalType::INTEGER}, LogicalType::BOOLEAN,
+	                      CreateVertexDictionaryFunction, VertexDictionaryBind);
+	create.varargs = LogicalType::ANY;
+	/* 1. Dictionary ID
+	 * 2. rowid of the vertex
+	 * 3.. key columns of the vertex table
+	 */
+	ScalarFunction create_with_rowid("create_vertex_dictionary_with_rowid", {LogicalType::INTEGER, LogicalType::BIGINT},
+	                                 LogicalType::BOOLEAN, CreateVertexDictionaryWithRowidFunction,
+	                                 VertexDictionaryBind);
+	create_with_rowid.varargs = LogicalType::ANY;
+	/* 1. Dictionary ID
+	 * 2.. key columns, e.g. the foreign key columns of an edge table
+	 */
+	ScalarFunction lookup("vertex_dictionary_lookup", {LogicalType::INTEGER}, LogicalType::BIGINT,
+	                      VertexDictionaryLookupFunction, VertexDictionaryBind);
+	lookup.varargs = LogicalType::ANY;
+	/* 1. Dictionary ID
+	 * 2. <optional> rows inserted into the dictionary, an error is raised if the dictionary has a different size
+	 */
+	ScalarFunctionSet size("vertex_dictionary_size");
+	size.AddFunction(ScalarFunction({LogicalType::INTEGER}, LogicalType::BIGINT, VertexDictionarySizeFunction,
+	                                CSRFunctionData::CSRBind));
+	size.AddFunction(ScalarFunction({LogicalType::INTEGER, LogicalType::BIGINT}, LogicalType::BIGINT,
+	                                VertexDictionarySizeFunction, CSRFunctionData::CSRBind));
+	for (auto &function : size.functions) {
+		function.stability = FunctionStability::VOLATILE;
+	}
+	ScalarFunction drop("delete_vertex_dictionary", {LogicalType::INTEGER}, LogicalType::BOOLEAN,
+	                    DeleteVertexDictionaryFunction, CSRFunctionData::CSRBind);
+	for (auto function : {&create, &create_with_rowid, &lookup, &drop}) {
+		function->stability = FunctionStability::VOLATILE;
+		loader.RegisterFunction(*function);
+	}
+	loader.RegisterFunction(size);
+}
+
+} // namespace duckdb
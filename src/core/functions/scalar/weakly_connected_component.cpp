@@ -4,33 +4,93 @@
 #include <duckpgq/core/functions/function_data/weakly_connected_component_function_data.hpp>
 #include <duckpgq/core/functions/scalar.hpp>
 #include <duckpgq/core/functions/table/weakly_connected_component.hpp>
+#include <duckpgq/core/utils/concurrent_union_find.hpp>
 #include <duckpgq/core/utils/duckpgq_bitmap.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
-#include <atomic>
-#include <vector>
+#include <duckpgq/core/utils/graph_traversal.hpp>
+#include <random>
 
 namespace duckdb {
 
-// Helper function to find the root of a node with path compression
-const static int64_t FindTreeRoot(std::vector<int64_t> &forest, int64_t node) {
-	while (true) {
-		int64_t parent = forest[node];
-		if (parent == node) {
-			return node; // Found the root
+//! Neighbours of every vertex linked before sampling the largest component
+#define AFFOREST_NEIGHBOR_ROUNDS 2
+//! Vertices sampled to find the largest component
+#define AFFOREST_SAMPLES 1024
+
+// Afforest (Sutton et al.): link the first few neighbours of every vertex, which already joins most of the graph,
+// then link the remaining edges of the vertices outside the largest component only. Skipping is only valid when every
+// edge is also stored in the other direction.
+static void LinkComponents(ClientContext &context, const CSR &csr, ConcurrentUnionFind &forest) {
+	auto vertex_count = csr.VertexCount();
+	auto offsets = reinterpret_cast<const int64_t *>(csr.v);
+	for (int64_t round = 0; round < AFFOREST_NEIGHBOR_ROUNDS; round++) {
+		TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+			for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+				if (offsets[vertex] + round < offsets[vertex + 1]) {
+					forest.Union(vertex, csr.e[offsets[vertex] + round]);
+				}
+			}
+		});
+		forest.Compress(&context);
+	}
+
+	int64_t largest = -1;
+	if (csr.symmetric && vertex_count > 0) {
+		std::mt19937_64 generator(0);
+		std::uniform_int_distribution<int64_t> distribution(0, vertex_count - 1);
+		unordered_map<int64_t, idx_t> sample_counts;
+		idx_t largest_count = 0;
+		for (idx_t i = 0; i < AFFOREST_SAMPLES; i++) {
+			auto root = forest.Find(distribution(generator));
+			auto sample_count = ++sample_counts[root];
+			if (sample_count > largest_count) {
+				largest_count = sample_count;
+				largest = root;
+			}
 		}
-		forest[node] = forest[parent];
-		node = parent;
 	}
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			if (largest >= 0 && forest.Find(vertex) == largest) {
+				continue;
+			}
+			for (auto offset = offsets[vertex] + AFFOREST_NEIGHBOR_ROUNDS; offset < offsets[vertex + 1]; offset++) {
+				forest.Union(vertex, csr.e[offset]);
+			}
+		}
+	});
+	csr.ForEachDeltaEdge([&](int64_t src, const CSRDeltaEdge &edge) { forest.Union(src, edge.dst); });
 }
 
-// Helper function to link two nodes in the same connected component
-const static void Link(std::vector<int64_t> &forest, int64_t nodeA, int64_t nodeB) {
-	int64_t rootA = FindTreeRoot(forest, nodeA);
-	int64_t rootB = FindTreeRoot(forest, nodeB);
+// Link every edge of the graph into the forest, vertices in parallel
+template <class GRAPH>
+static void LinkComponents(ClientContext &context, const GRAPH &graph, ConcurrentUnionFind &forest) {
+	TraversalParallelFor(&context, forest.Count(), [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			graph.ForEachNeighbor(vertex, [&](int64_t neighbor) { forest.Union(vertex, neighbor); });
+		}
+	});
+	graph.ForEachDeltaEdge([&](int64_t src, const CSRDeltaEdge &edge) { forest.Union(src, edge.dst); });
+}
 
-	if (rootA != rootB) {
-		forest[rootA] = rootB;
+//! Component of every vertex, labelled by the smallest rowid in it, dictionary maps the dense ids of csr to rowids
+static vector<int64_t> ComputeComponents(ClientContext &context, CSR *csr, const VertexDictionary *dictionary,
+                                         DynamicGraph *dynamic_graph, int64_t vertex_count) {
+	ConcurrentUnionFind forest(vertex_count);
+	if (csr) {
+		CSRReadGuard read_guard(*csr);
+		LinkComponents(context, *csr, forest);
+	} else {
+		CSRReadGuard read_guard(dynamic_graph->access_lock);
+		LinkComponents(context, *dynamic_graph, forest);
+	}
+	auto component = forest.Flatten(&context);
+	// without a permutation or a dictionary the root already is the smallest vertex of its set, which is the smallest
+	// rowid
+	if (csr && (!csr->inv_perm.empty() || dictionary)) {
+		LabelComponentsBySmallestRowid(&context, csr, dictionary, component);
 	}
+	return component;
 }
 
 static void WeaklyConnectedComponentFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -38,19 +98,22 @@ static void WeaklyConnectedComponentFunction(DataChunk &args, ExpressionState &s
 	auto &info = func_expr.bind_info->Cast<WeaklyConnectedComponentFunctionData>();
 	auto duckpgq_state = GetDuckPGQState(info.context);
 
+	CSR *csr = nullptr;
+	DynamicGraph *dynamic_graph = nullptr;
 	auto csr_entry = duckpgq_state->csr_list.find(info.csr_id);
-	if (csr_entry == duckpgq_state->csr_list.end()) {
-		throw ConstraintException("CSR not found. Is the graph populated?");
-	}
-
-	if (!(csr_entry->second->initialized_v && csr_entry->second->initialized_e)) {
-		throw ConstraintException("Need to initialize CSR before doing weakly connected components.");
+	if (csr_entry != duckpgq_state->csr_list.end()) {
+		csr = csr_entry->second.get();
+		if (!(csr->initialized_v && csr->initialized_e)) {
+			throw ConstraintException("Need to initialize CSR before doing weakly connected components.");
+		}
+		ApplyVertexReordering(info.context, *duckpgq_state, *csr);
+	} else {
+		dynamic_graph = duckpgq_state->GetDynamicGraph(info.csr_id);
+		if (!dynamic_graph) {
+			throw ConstraintException("CSR not found. Is the graph populated?");
+		}
 	}
-
-	// Retrieve CSR data
-	int64_t *v = reinterpret_cast<int64_t *>(duckpgq_state->csr_list[info.csr_id]->v);
-	vector<int64_t> &e = duckpgq_state->csr_list[info.csr_id]->e;
-	size_t v_size = duckpgq_state->csr_list[info.csr_id]->vsize;
+	int64_t vertex_count = csr ? csr->VertexCount() : dynamic_graph->VertexCount();
 
 	// Get source vector for searches
 	auto &src = args.data[1];
@@ -63,44 +126,29 @@ static void WeaklyConnectedComponentFunction(DataChunk &args, ExpressionState &s
 	result.SetVectorType(VectorType::FLAT_VECTOR);
 	auto result_data = FlatVector::GetData<int64_t>(result);
 
-	if (!info.state_initialized) {
-		std::lock_guard<std::mutex> guard(info.initialize_lock); // Thread safety
-		if (!info.state_converged) {
-			info.forest.resize(v_size);
-			info.state_initialized = true; // Initialize state
-		}
-	}
-
-	// Check if already converged
+	// The first chunk computes the components, later chunks only read them
 	if (!info.state_converged) {
-		std::lock_guard<std::mutex> guard(info.wcc_lock); // Thread safety
+		std::lock_guard<std::mutex> guard(info.wcc_lock);
 		if (!info.state_converged) {
-			// Initialize the forest for connected components
-			for (int64_t i = 0; i < v_size - 1; ++i) {
-				info.forest[i] = i; // Each node points to itself
-			}
-			// Process edges to link nodes
-			for (int64_t i = 0; i < v_size - 1; i++) {
-				for (int64_t edge_idx = v[i]; edge_idx < v[i + 1]; edge_idx++) {
-					int64_t neighbor = e[edge_idx];
-					Link(info.forest, i, neighbor);
-				}
-			}
+			auto dictionary = csr ? duckpgq_state->GetRowidDictionary(info.csr_id, vertex_count) : nullptr;
+			info.component = ComputeComponents(info.context, csr, dictionary, dynamic_graph, vertex_count);
 			info.state_converged = true;
 		}
 	}
-	// Assign component IDs for the source nodes
 	for (size_t i = 0; i < args.size(); i++) {
-		int64_t src_node = src_data[i];
-		if (src_node >= 0 && src_node < v_size) {
-			result_data[i] = FindTreeRoot(info.forest, src_node); // Assign component ID to the result
+		auto src_index = vdata_src.sel->get_index(i);
+		int64_t src_node = csr ? csr->ToInternal(src_data[src_index]) : src_data[src_index];
+		if (vdata_src.validity.RowIsValid(src_index) && src_node >= 0 && src_node < vertex_count) {
+			result_data[i] = info.component[src_node];
 		} else {
 			result_validity.SetInvalid(i);
 		}
 	}
 
 	// Mark CSR for deletion
-	duckpgq_state->csr_to_delete.insert(info.csr_id);
+	if (csr) {
+		duckpgq_state->csr_to_delete.insert(info.csr_id);
+	}
 }
 
 //------------------------------------------------------------------------------
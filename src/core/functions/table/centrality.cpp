@@ -0,0 +1,74 @@
+#include "duckpgq/core/functions/table/centrality.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+//! Calls the centrality scalar function_name for every vertex over the directed CSR of the edge label. The samples
+//! parameter is passed as a NULL BIGINT when not given, the scalar validates the parameters when it is bound.
+static unique_ptr<TableRef> CreateCentralityTableRef(ClientContext &context, TableFunctionBindInput &input,
+                                                     const string &function_name, bool has_normalized) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+
+	auto samples = Value(LogicalType::BIGINT);
+	auto normalized = Value::BOOLEAN(false);
+	for (auto &parameter : input.named_parameters) {
+		if (parameter.second.IsNull()) {
+			continue;
+		}
+		if (parameter.first == "samples") {
+			samples = Value::BIGINT(parameter.second.GetValue<int64_t>());
+		} else if (parameter.first == "normalized") {
+			normalized = Value::BOOLEAN(parameter.second.GetValue<bool>());
+		}
+	}
+	vector<Value> extra_arguments {samples};
+	if (has_normalized) {
+		extra_arguments.push_back(normalized);
+	}
+	auto select_node = CreateSelectNode(edge_pg_entry, function_name, function_name, extra_arguments);
+
+	select_node->cte_map.map["csr_cte"] = CreateDenseDirectedCSRCTE(edge_pg_entry, select_node);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = function_name;
+	return std::move(result);
+}
+
+unique_ptr<TableRef> BetweennessCentralityFunction::BetweennessCentralityBindReplace(ClientContext &context,
+                                                                                     TableFunctionBindInput &input) {
+	return CreateCentralityTableRef(context, input, "betweenness_centrality", true);
+}
+
+unique_ptr<TableRef> ClosenessCentralityFunction::ClosenessCentralityBindReplace(ClientContext &context,
+                                                                                 TableFunctionBindInput &input) {
+	return CreateCentralityTableRef(context, input, "closeness_centrality", false);
+}
+
+unique_ptr<TableRef> HarmonicCentralityFunction::HarmonicCentralityBindReplace(ClientContext &context,
+                                                                               TableFunctionBindInput &input) {
+	return CreateCentralityTableRef(context, input, "harmonic_centrality", false);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterCentralityTableFunctions(ExtensionLoader &loader) {
+	loader.RegisterFunction(BetweennessCentralityFunction());
+	loader.RegisterFunction(ClosenessCentralityFunction());
+	loader.RegisterFunction(HarmonicCentralityFunction());
+}
+
+} // namespace duckdb
@@ -0,0 +1,112 @@
+#include "duckpgq/core/functions/table/community_detection.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/tableref/joinref.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/function_data/community_detection_function_data.hpp>
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+//! Calls the community detection scalar function_name for every vertex and splits its result into the community,
+//! modularity and runtime_ms columns. The scalar validates the parameters when it is bound.
+static unique_ptr<TableRef> CreateCommunityTableRef(ClientContext &context, TableFunctionBindInput &input,
+                                                    const string &function_name) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+	auto &vertex_reference = edge_pg_entry->source_reference;
+	auto leiden = function_name == "leiden";
+
+	int64_t seed = COMMUNITY_DEFAULT_SEED;
+	double resolution = LEIDEN_DEFAULT_RESOLUTION;
+	int64_t max_iterations = leiden ? LEIDEN_DEFAULT_MAX_ITERATIONS : LABEL_PROPAGATION_DEFAULT_MAX_ITERATIONS;
+	string weight_column;
+	for (auto &parameter : input.named_parameters) {
+		if (parameter.second.IsNull()) {
+			continue;
+		}
+		if (parameter.first == "seed") {
+			seed = parameter.second.GetValue<int64_t>();
+		} else if (parameter.first == "resolution") {
+			resolution = parameter.second.GetValue<double>();
+		} else if (parameter.first == "max_iterations") {
+			max_iterations = parameter.second.GetValue<int64_t>();
+		} else if (parameter.first == "weight") {
+			weight_column = StringValue::Get(parameter.second);
+		}
+	}
+
+	auto community_node = make_uniq<SelectNode>();
+	community_node->select_list.push_back(
+	    make_uniq<ColumnRefExpression>(edge_pg_entry->source_pk[0], vertex_reference));
+	vector<unique_ptr<ParsedExpression>> vertex_children;
+	vertex_children.push_back(
+	    GetDenseVertexId(GetVertexDictionaryId(0, 0), edge_pg_entry->source_pk, vertex_reference));
+	vertex_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+	vector<unique_ptr<ParsedExpression>> function_children;
+	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	function_children.push_back(make_uniq<FunctionExpression>("add", std::move(vertex_children)));
+	function_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(seed)));
+	if (leiden) {
+		function_children.push_back(make_uniq<ConstantExpression>(Value::DOUBLE(resolution)));
+	}
+	function_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(max_iterations)));
+	auto function = make_uniq<FunctionExpression>(function_name, std::move(function_children));
+	function->alias = "result";
+	community_node->select_list.push_back(std::move(function));
+
+	auto cross_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	cross_join_ref->left = edge_pg_entry->source_pg_table->CreateBaseTableRef();
+	cross_join_ref->right = CreateCountCTESubquery();
+	community_node->from_table = std::move(cross_join_ref);
+	// undirected edges are taken from the directed CSR, which can carry the weights
+	community_node->cte_map.map["csr_cte"] =
+	    CreateDenseDirectedCSRCTE(edge_pg_entry, community_node, weight_column);
+
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(make_uniq<ColumnRefExpression>(edge_pg_entry->source_pk[0], "communities"));
+	for (auto &field : {"community", "modularity", "runtime_ms"}) {
+		vector<unique_ptr<ParsedExpression>> extract_children;
+		extract_children.push_back(make_uniq<ColumnRefExpression>("result", "communities"));
+		extract_children.push_back(make_uniq<ConstantExpression>(Value(field)));
+		auto extract = make_uniq<FunctionExpression>("struct_extract", std::move(extract_children));
+		extract->alias = field;
+		select_node->select_list.push_back(std::move(extract));
+	}
+	auto community_statement = make_uniq<SelectStatement>();
+	community_statement->node = std::move(community_node);
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(community_statement), "communities");
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = function_name;
+	return std::move(result);
+}
+
+unique_ptr<TableRef> LabelPropagationFunction::LabelPropagationBindReplace(ClientContext &context,
+                                                                           TableFunctionBindInput &input) {
+	return CreateCommunityTableRef(context, input, "label_propagation");
+}
+
+unique_ptr<TableRef> LeidenFunction::LeidenBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	return CreateCommunityTableRef(context, input, "leiden");
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterCommunityDetectionTableFunctions(ExtensionLoader &loader) {
+	loader.RegisterFunction(LabelPropagationFunction());
+	loader.RegisterFunction(LeidenFunction());
+}
+
+} // namespace duckdb
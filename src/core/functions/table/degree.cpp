@@ -0,0 +1,81 @@
+#include "duckpgq/core/functions/table/degree.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/query_node/select_node.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+//! SELECT pk, function_name(csr_id, rowid) FROM the vertex table, the degrees of a CSR the user built and keeps
+static unique_ptr<SelectNode> CreateCachedDegreeNode(const shared_ptr<PropertyGraphTable> &edge_pg_entry,
+                                                     const string &function_name, int32_t csr_id) {
+	auto &vertex_reference = edge_pg_entry->source_reference;
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(make_uniq<ColumnRefExpression>(edge_pg_entry->source_pk[0], vertex_reference));
+	vector<unique_ptr<ParsedExpression>> function_children;
+	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(csr_id)));
+	function_children.push_back(make_uniq<ColumnRefExpression>("rowid", vertex_reference));
+	auto function = make_uniq<FunctionExpression>(function_name, std::move(function_children));
+	function->alias = function_name;
+	select_node->select_list.push_back(std::move(function));
+	select_node->from_table = edge_pg_entry->source_pg_table->CreateBaseTableRef();
+	return select_node;
+}
+
+//! Calls the degree scalar function_name for every vertex, over the cached CSR csr_id when it is given and else over
+//! a directed CSR of the edge label built for this query
+static unique_ptr<TableRef> CreateDegreeTableRef(ClientContext &context, TableFunctionBindInput &input,
+                                                 const string &function_name) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+
+	unique_ptr<SelectNode> select_node;
+	auto csr_id = input.named_parameters.find("csr_id");
+	if (csr_id != input.named_parameters.end() && !csr_id->second.IsNull()) {
+		// the scalars read the offsets of the cached CSR, no edge is scanned
+		select_node = CreateCachedDegreeNode(edge_pg_entry, function_name, csr_id->second.GetValue<int32_t>());
+	} else {
+		select_node = CreateSelectNode(edge_pg_entry, function_name, function_name);
+		select_node->cte_map.map["csr_cte"] = CreateDenseDirectedCSRCTE(edge_pg_entry, select_node);
+		// the degree scalars leave cached CSRs in place, the one built here is dropped when the query ends
+		duckpgq_state->csr_to_delete.insert(0);
+	}
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = function_name;
+	return std::move(result);
+}
+
+unique_ptr<TableRef> DegreeFunction::DegreeBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	return CreateDegreeTableRef(context, input, "degree");
+}
+
+unique_ptr<TableRef> InDegreeFunction::InDegreeBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	return CreateDegreeTableRef(context, input, "in_degree");
+}
+
+unique_ptr<TableRef> OutDegreeFunction::OutDegreeBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	return CreateDegreeTableRef(context, input, "out_degree");
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterDegreeTableFunctions(ExtensionLoader &loader) {
+	loader.RegisterFunction(DegreeFunction());
+	loader.RegisterFunction(InDegreeFunction());
+	loader.RegisterFunction(OutDegreeFunction());
+}
+
+} // namespace duckdb
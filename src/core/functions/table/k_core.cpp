@@ -0,0 +1,41 @@
+#include "duckpgq/core/functions/table/k_core.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/query_node/select_node.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+// Main binding function
+unique_ptr<TableRef> KCoreFunction::KCoreBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+
+	auto select_node = CreateSelectNode(edge_pg_entry, "core_number", "core_number");
+
+	// the symmetric CSR, with reciprocal and parallel edges collapsed so they count as one neighbour
+	select_node->cte_map.map["csr_cte"] = CreateDenseUndirectedCSRCTE(edge_pg_entry, select_node);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "k_core";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterKCoreTableFunction(ExtensionLoader &loader) {
+	loader.RegisterFunction(KCoreFunction());
+}
+
+} // namespace duckdb
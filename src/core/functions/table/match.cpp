@@ -408,8 +408,7 @@ PGQMatchFunction::GenerateShortestPathCTE(CreatePropertyGraphInfo &pg_table, Sub
 
 	vector<unique_ptr<ParsedExpression>> pathfinding_children;
 	pathfinding_children.push_back(std::move(csr_id));
-	pathfinding_children.push_back(std::move(GetCountTable(
-	    edge_table->source_pg_table, previous_vertex_element->variable_binding, edge_table->source_pk[0])));
+	pathfinding_children.push_back(GetRowidRange(edge_table));
 	pathfinding_children.push_back(std::move(src_row_id));
 	pathfinding_children.push_back(std::move(dst_row_id));
 
@@ -630,8 +629,7 @@ PGQMatchFunction::AddPathQuantifierCondition(const string &prev_binding, const s
 
 	vector<unique_ptr<ParsedExpression>> pathfinding_children;
 	pathfinding_children.push_back(std::move(csr_id));
-	pathfinding_children.push_back(
-	    std::move(GetCountTable(edge_table->source_pg_table, prev_binding, edge_table->source_pk[0])));
+	pathfinding_children.push_back(GetRowidRange(edge_table));
 	pathfinding_children.push_back(std::move(src_row_id));
 	pathfinding_children.push_back(std::move(dst_row_id));
 
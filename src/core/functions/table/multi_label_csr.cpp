@@ -0,0 +1,87 @@
+#include "duckpgq/core/functions/table/multi_label_csr.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+static unique_ptr<ParsedExpression> UnnestList(vector<unique_ptr<ParsedExpression>> elements, const string &alias) {
+	vector<unique_ptr<ParsedExpression>> unnest_children;
+	unnest_children.push_back(make_uniq<FunctionExpression>("list_value", std::move(elements)));
+	auto result = make_uniq<FunctionExpression>("unnest", std::move(unnest_children));
+	result->alias = alias;
+	return std::move(result);
+}
+
+// Main binding function
+unique_ptr<TableRef> CreateMultiLabelCSRFunction::CreateMultiLabelCSRBindReplace(ClientContext &context,
+                                                                                 TableFunctionBindInput &input) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto csr_id = input.inputs[1].GetValue<int32_t>();
+	if (input.inputs[2].IsNull()) {
+		throw InvalidInputException("create_multi_label_csr needs a list of edge labels");
+	}
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+
+	vector<shared_ptr<PropertyGraphTable>> edge_tables;
+	for (auto &label_value : ListValue::GetChildren(input.inputs[2])) {
+		auto label = StringUtil::Lower(StringValue::Get(label_value));
+		auto edge_pg_entry = pg_info->GetTableByLabel(label, true, false);
+		if (edge_pg_entry->is_vertex_table) {
+			throw Exception(ExceptionType::INVALID, label + " is a vertex table, expected an edge table");
+		}
+		edge_tables.push_back(edge_pg_entry);
+	}
+
+	// one row per vertex table and key: (vertex_table, vertex_key, vertex_dictionary, vertex_offset, vertex_count)
+	auto vertex_tables = GetGraphVertexTables(*pg_info, edge_tables, csr_id);
+	vector<unique_ptr<ParsedExpression>> table_names;
+	vector<unique_ptr<ParsedExpression>> keys;
+	vector<unique_ptr<ParsedExpression>> dictionaries;
+	vector<unique_ptr<ParsedExpression>> offsets;
+	vector<unique_ptr<ParsedExpression>> counts;
+	for (idx_t i = 0; i < vertex_tables.size(); i++) {
+		table_names.push_back(make_uniq<ConstantExpression>(Value(vertex_tables[i].table->table_name)));
+		vector<Value> key_columns;
+		for (auto &column : vertex_tables[i].key_columns) {
+			key_columns.push_back(Value(column));
+		}
+		keys.push_back(make_uniq<ConstantExpression>(Value::LIST(LogicalType::VARCHAR, key_columns)));
+		dictionaries.push_back(make_uniq<ConstantExpression>(Value::INTEGER(vertex_tables[i].dictionary_id)));
+		vector<unique_ptr<ParsedExpression>> add_children;
+		add_children.push_back(GetVertexOffset(vertex_tables, i));
+		add_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+		offsets.push_back(make_uniq<FunctionExpression>("add", std::move(add_children)));
+		counts.push_back(GetDenseVertexCount(vertex_tables[i], i));
+	}
+
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(UnnestList(std::move(table_names), "vertex_table"));
+	select_node->select_list.push_back(UnnestList(std::move(keys), "vertex_key"));
+	select_node->select_list.push_back(UnnestList(std::move(dictionaries), "vertex_dictionary"));
+	select_node->select_list.push_back(UnnestList(std::move(offsets), "vertex_offset"));
+	select_node->select_list.push_back(UnnestList(std::move(counts), "vertex_count"));
+	select_node->from_table = CreateCountCTESubquery();
+	select_node->cte_map.map["csr_cte"] = CreateMultiLabelCSRCTE(*pg_info, edge_tables, csr_id, select_node);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "multi_label_csr";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterMultiLabelCSRTableFunction(ExtensionLoader &loader) {
+	loader.RegisterFunction(CreateMultiLabelCSRFunction());
+}
+
+} // namespace duckdb
@@ -2,6 +2,7 @@
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/parser/tableref/subqueryref.hpp"
 
+#include <duckpgq/core/functions/function_data/pagerank_function_data.hpp>
 #include <duckpgq/core/functions/table.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
 #include "duckdb/parser/tableref/basetableref.hpp"
@@ -18,9 +19,30 @@ unique_ptr<TableRef> PageRankFunction::PageRankBindReplace(ClientContext &contex
 	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
 	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
 
-	auto select_node = CreateSelectNode(edge_pg_entry, "pagerank", "pagerank");
-
-	select_node->cte_map.map["csr_cte"] = CreateDirectedCSRCTE(edge_pg_entry, "src", "edge", "dst");
+	double damping_factor = PAGERANK_DEFAULT_DAMPING;
+	double tolerance = PAGERANK_DEFAULT_TOLERANCE;
+	int64_t max_iterations = PAGERANK_DEFAULT_MAX_ITERATIONS;
+	string weight_column;
+	for (auto &parameter : input.named_parameters) {
+		if (parameter.second.IsNull()) {
+			continue;
+		}
+		if (parameter.first == "damping") {
+			damping_factor = parameter.second.GetValue<double>();
+		} else if (parameter.first == "tolerance") {
+			tolerance = parameter.second.GetValue<double>();
+		} else if (parameter.first == "max_iterations") {
+			max_iterations = parameter.second.GetValue<int64_t>();
+		} else if (parameter.first == "weight") {
+			weight_column = StringValue::Get(parameter.second);
+		}
+	}
+	// the pagerank scalar validates the parameters when it is bound
+	auto select_node =
+	    CreateSelectNode(edge_pg_entry, "pagerank", "pagerank",
+	                     {Value::DOUBLE(damping_factor), Value::DOUBLE(tolerance), Value::BIGINT(max_iterations)});
+
+	select_node->cte_map.map["csr_cte"] = CreateDenseDirectedCSRCTE(edge_pg_entry, select_node, weight_column);
 
 	auto subquery = make_uniq<SelectStatement>();
 	subquery->node = std::move(select_node);
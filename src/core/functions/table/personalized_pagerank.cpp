@@ -0,0 +1,153 @@
+#include "duckpgq/core/functions/table/personalized_pagerank.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/expression/comparison_expression.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/expression/operator_expression.hpp"
+#include "duckdb/parser/tableref/joinref.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+static unique_ptr<ParsedExpression> ExtractField(const string &column, const string &table, const string &field) {
+	vector<unique_ptr<ParsedExpression>> children;
+	children.push_back(make_uniq<ColumnRefExpression>(column, table));
+	children.push_back(make_uniq<ConstantExpression>(Value(field)));
+	return make_uniq<FunctionExpression>("struct_extract", std::move(children));
+}
+
+static unique_ptr<SubqueryRef> MakeSubquery(unique_ptr<SelectNode> node, const string &alias) {
+	auto statement = make_uniq<SelectStatement>();
+	statement->node = std::move(node);
+	return make_uniq<SubqueryRef>(std::move(statement), alias);
+}
+
+// Main binding function
+unique_ptr<TableRef>
+PersonalizedPageRankFunction::PersonalizedPageRankBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+	if (input.inputs[3].type().id() != LogicalTypeId::LIST || input.inputs[3].IsNull() ||
+	    ListValue::GetChildren(input.inputs[3]).empty()) {
+		throw InvalidInputException("personalized_pagerank needs a non-empty list of seed vertex keys");
+	}
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+
+	double alpha = PERSONALIZED_PAGERANK_DEFAULT_ALPHA;
+	double epsilon = PERSONALIZED_PAGERANK_DEFAULT_EPSILON;
+	int64_t top_k = PERSONALIZED_PAGERANK_DEFAULT_TOP_K;
+	string method = "push";
+	for (auto &parameter : input.named_parameters) {
+		if (parameter.second.IsNull()) {
+			continue;
+		}
+		if (parameter.first == "alpha") {
+			alpha = parameter.second.GetValue<double>();
+		} else if (parameter.first == "epsilon") {
+			epsilon = parameter.second.GetValue<double>();
+		} else if (parameter.first == "top_k") {
+			top_k = parameter.second.GetValue<int64_t>();
+		} else if (parameter.first == "method") {
+			method = StringValue::Get(parameter.second);
+		}
+	}
+
+	auto &pk = edge_pg_entry->source_pk[0];
+	auto &vertex_reference = edge_pg_entry->source_reference;
+
+	// the CSR and its vertex dictionary are defined on the outer query, so the scores can be mapped back to keys
+	auto select_node = make_uniq<SelectNode>();
+	select_node->cte_map.map["csr_cte"] = CreateDenseDirectedCSRCTE(edge_pg_entry, select_node);
+	auto dictionary_id = GetVertexDictionaryId(0, 0);
+
+	// one row per seed: (seed, list of scored dense vertex ids), the personalized_pagerank scalar validates the
+	// parameters
+	auto seed_node = make_uniq<SelectNode>();
+	auto seed_column = make_uniq<ColumnRefExpression>(pk, vertex_reference);
+	seed_column->alias = "seed";
+	seed_node->select_list.push_back(std::move(seed_column));
+	vector<unique_ptr<ParsedExpression>> vertex_children;
+	vertex_children.push_back(GetDenseVertexId(dictionary_id, edge_pg_entry->source_pk, vertex_reference));
+	vertex_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+	vector<unique_ptr<ParsedExpression>> function_children;
+	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	function_children.push_back(make_uniq<FunctionExpression>("add", std::move(vertex_children)));
+	function_children.push_back(make_uniq<ConstantExpression>(Value::DOUBLE(alpha)));
+	function_children.push_back(make_uniq<ConstantExpression>(Value::DOUBLE(epsilon)));
+	function_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(top_k)));
+	function_children.push_back(make_uniq<ConstantExpression>(Value(method)));
+	auto function = make_uniq<FunctionExpression>("personalized_pagerank", std::move(function_children));
+	function->alias = "scores";
+	seed_node->select_list.push_back(std::move(function));
+
+	auto cross_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	cross_join_ref->left = edge_pg_entry->source_pg_table->CreateBaseTableRef();
+	cross_join_ref->right = CreateCountCTESubquery();
+	seed_node->from_table = std::move(cross_join_ref);
+
+	auto seed_filter = make_uniq<OperatorExpression>(ExpressionType::COMPARE_IN);
+	seed_filter->children.push_back(make_uniq<ColumnRefExpression>(pk, vertex_reference));
+	for (auto &seed : ListValue::GetChildren(input.inputs[3])) {
+		seed_filter->children.push_back(make_uniq<ConstantExpression>(seed));
+	}
+	seed_node->where_clause = std::move(seed_filter);
+
+	// one row per scored vertex
+	auto unnest_node = make_uniq<SelectNode>();
+	unnest_node->select_list.push_back(make_uniq<ColumnRefExpression>("seed", "ppr_seeds"));
+	vector<unique_ptr<ParsedExpression>> unnest_children;
+	unnest_children.push_back(make_uniq<ColumnRefExpression>("scores", "ppr_seeds"));
+	auto unnest = make_uniq<FunctionExpression>("unnest", std::move(unnest_children));
+	unnest->alias = "entry";
+	unnest_node->select_list.push_back(std::move(unnest));
+	unnest_node->from_table = MakeSubquery(std::move(seed_node), "ppr_seeds");
+
+	// translate the dense vertex ids back into keys
+	auto vertex_node = make_uniq<SelectNode>();
+	vertex_node->select_list.push_back(make_uniq<ColumnRefExpression>(pk, vertex_reference));
+	auto dense_id = GetDenseVertexId(dictionary_id, edge_pg_entry->source_pk, vertex_reference);
+	dense_id->alias = "dense_id";
+	vertex_node->select_list.push_back(std::move(dense_id));
+	auto vertex_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	vertex_join_ref->left = edge_pg_entry->source_pg_table->CreateBaseTableRef();
+	vertex_join_ref->right = CreateBaseTableRef("vertex_dictionary_cte");
+	vertex_node->from_table = std::move(vertex_join_ref);
+
+	select_node->select_list.push_back(make_uniq<ColumnRefExpression>("seed", "ppr_entries"));
+	auto vertex_column = make_uniq<ColumnRefExpression>(pk, "ppr_vertex");
+	vertex_column->alias = "vertex";
+	select_node->select_list.push_back(std::move(vertex_column));
+	auto score = ExtractField("entry", "ppr_entries", "score");
+	score->alias = "score";
+	select_node->select_list.push_back(std::move(score));
+
+	auto join_ref = make_uniq<JoinRef>(JoinRefType::REGULAR);
+	join_ref->left = MakeSubquery(std::move(unnest_node), "ppr_entries");
+	join_ref->right = MakeSubquery(std::move(vertex_node), "ppr_vertex");
+	join_ref->condition = make_uniq<ComparisonExpression>(ExpressionType::COMPARE_EQUAL,
+	                                                      make_uniq<ColumnRefExpression>("dense_id", "ppr_vertex"),
+	                                                      ExtractField("entry", "ppr_entries", "vertex"));
+	select_node->from_table = std::move(join_ref);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "personalized_pagerank";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterPersonalizedPageRankTableFunction(ExtensionLoader &loader) {
+	loader.RegisterFunction(PersonalizedPageRankFunction());
+}
+
+} // namespace duckdb
@@ -23,6 +23,7 @@ static void ScanCSREFunction(ClientContext &context, TableFunctionInput &data_p,
 	auto duckpgq_state = GetDuckPGQState(context);
 	auto csr_id = data_p.bind_data->Cast<CSRScanEData>().csr_id;
 	CSR *csr = duckpgq_state->GetCSR(csr_id);
+	CSRReadGuard read_guard(*csr);
 
 	idx_t vector_size = state->csr_e_offset + DEFAULT_STANDARD_VECTOR_SIZE <= csr->e.size()
 	                        ? DEFAULT_STANDARD_VECTOR_SIZE
@@ -92,6 +93,7 @@ static void ScanCSRVFunction(ClientContext &context, TableFunctionInput &data_p,
 	auto duckpgq_state = GetDuckPGQState(context);
 	auto csr_id = data_p.bind_data->Cast<CSRScanVData>().csr_id;
 	CSR *csr = duckpgq_state->GetCSR(csr_id);
+	CSRReadGuard read_guard(*csr);
 
 	idx_t vector_size = state->csr_v_offset + DEFAULT_STANDARD_VECTOR_SIZE <= csr->vsize
 	                        ? DEFAULT_STANDARD_VECTOR_SIZE
@@ -122,6 +124,7 @@ static void ScanCSRWFunction(ClientContext &context, TableFunctionInput &data_p,
 	auto csr_scanw_data = data_p.bind_data->Cast<CSRScanWData>();
 	auto csr_id = csr_scanw_data.csr_id;
 	CSR *csr = duckpgq_state->GetCSR(csr_id);
+	CSRReadGuard read_guard(*csr);
 
 	size_t w_size = 0;
 	if (csr_scanw_data.is_double) {
@@ -0,0 +1,101 @@
+#include "duckpgq/core/functions/table/strongly_connected_component.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/tableref/joinref.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+// Main binding function
+unique_ptr<TableRef>
+StronglyConnectedComponentFunction::StronglyConnectedComponentBindReplace(ClientContext &context,
+                                                                          TableFunctionBindInput &input) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+
+	auto select_node = CreateSelectNode(edge_pg_entry, "strongly_connected_component", "componentId");
+
+	select_node->cte_map.map["csr_cte"] = CreateDenseDirectedCSRCTE(edge_pg_entry, select_node);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "scc";
+	return std::move(result);
+}
+
+unique_ptr<TableRef> StronglyConnectedComponentCondensationFunction::StronglyConnectedComponentCondensationBindReplace(
+    ClientContext &context, TableFunctionBindInput &input) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_table = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_table = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_table, edge_table);
+	auto &vertex_reference = edge_pg_entry->source_reference;
+
+	// one row per vertex: (rowid, components its component has edges into), the list is only filled for the vertex
+	// that labels its component, which is the vertex with the smallest rowid in it
+	auto successor_node = make_uniq<SelectNode>();
+	auto rowid = make_uniq<ColumnRefExpression>("rowid", vertex_reference);
+	rowid->alias = "component";
+	successor_node->select_list.push_back(std::move(rowid));
+	vector<unique_ptr<ParsedExpression>> vertex_children;
+	vertex_children.push_back(
+	    GetDenseVertexId(GetVertexDictionaryId(0, 0), edge_pg_entry->source_pk, vertex_reference));
+	vertex_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+	vector<unique_ptr<ParsedExpression>> function_children;
+	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	function_children.push_back(make_uniq<FunctionExpression>("add", std::move(vertex_children)));
+	auto function = make_uniq<FunctionExpression>("strongly_connected_component_successors",
+	                                              std::move(function_children));
+	function->alias = "successors";
+	successor_node->select_list.push_back(std::move(function));
+
+	auto cross_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	cross_join_ref->left = edge_pg_entry->source_pg_table->CreateBaseTableRef();
+	cross_join_ref->right = CreateCountCTESubquery();
+	successor_node->from_table = std::move(cross_join_ref);
+	successor_node->cte_map.map["csr_cte"] = CreateDenseDirectedCSRCTE(edge_pg_entry, successor_node);
+
+	// one row per condensation edge
+	auto select_node = make_uniq<SelectNode>();
+	auto source_column = make_uniq<ColumnRefExpression>("component", "scc_successors");
+	source_column->alias = "source_component";
+	select_node->select_list.push_back(std::move(source_column));
+	vector<unique_ptr<ParsedExpression>> unnest_children;
+	unnest_children.push_back(make_uniq<ColumnRefExpression>("successors", "scc_successors"));
+	auto unnest = make_uniq<FunctionExpression>("unnest", std::move(unnest_children));
+	unnest->alias = "destination_component";
+	select_node->select_list.push_back(std::move(unnest));
+	auto successor_statement = make_uniq<SelectStatement>();
+	successor_statement->node = std::move(successor_node);
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(successor_statement), "scc_successors");
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "scc_condensation";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterStronglyConnectedComponentTableFunctions(ExtensionLoader &loader) {
+	loader.RegisterFunction(StronglyConnectedComponentFunction());
+	loader.RegisterFunction(StronglyConnectedComponentCondensationFunction());
+}
+
+} // namespace duckdb
@@ -1,4 +1,5 @@
 #include "duckpgq/core/functions/table/summarize_property_graph.hpp"
+#include "duckdb/parser/expression/cast_expression.hpp"
 #include "duckdb/parser/expression/comparison_expression.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
@@ -10,11 +11,26 @@
 #include "duckdb/parser/statement/select_statement.hpp"
 #include "duckdb/parser/tableref/showref.hpp"
 #include "duckdb/parser/tableref/subqueryref.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
 #include <duckpgq/core/functions/table.hpp>
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
 
 namespace duckdb {
 
+SummarizeMode ParseSummarizeMode(const string &mode) {
+	auto lower_mode = StringUtil::Lower(mode);
+	if (lower_mode == "sql") {
+		return SummarizeMode::SQL;
+	}
+	if (lower_mode == "csr") {
+		return SummarizeMode::CSR;
+	}
+	if (lower_mode == "approximate") {
+		return SummarizeMode::APPROXIMATE;
+	}
+	throw InvalidInputException("Unknown summarize mode '%s', expected sql, csr or approximate", mode);
+}
+
 unique_ptr<ParsedExpression> GetTableNameConstantExpression(const string &table_name, const string &alias) {
 	auto table_name_column = make_uniq<ConstantExpression>(Value(table_name));
 	table_name_column->alias = alias;
@@ -258,6 +274,205 @@ SummarizePropertyGraphFunction::CreateEdgeTableCTE(shared_ptr<PropertyGraphTable
 	return cte_info;
 }
 
+//! CAST(map_values(histogram(column)) AS BIGINT[]), the number of edges of every distinct key of column
+static unique_ptr<ParsedExpression> GetDegreeList(const shared_ptr<PropertyGraphTable> &edge_table,
+                                                  const string &column, const string &alias) {
+	vector<unique_ptr<ParsedExpression>> histogram_children;
+	histogram_children.push_back(make_uniq<ColumnRefExpression>(column, edge_table->table_name));
+	vector<unique_ptr<ParsedExpression>> values_children;
+	values_children.push_back(make_uniq<FunctionExpression>("histogram", std::move(histogram_children)));
+	auto result = make_uniq<CastExpression>(LogicalType::LIST(LogicalType::BIGINT),
+	                                        make_uniq<FunctionExpression>("map_values", std::move(values_children)));
+	result->alias = alias;
+	return std::move(result);
+}
+
+//! function(degrees.list_column, extra), a statistic of one of the degree lists of GetDegreeList
+static unique_ptr<ParsedExpression> GetListStatistic(const string &function, const string &list_column,
+                                                     const string &alias, const Value &extra = Value()) {
+	vector<unique_ptr<ParsedExpression>> children;
+	children.push_back(make_uniq<ColumnRefExpression>(list_column, "degrees"));
+	if (function == "list_aggregate") {
+		children.push_back(make_uniq<ConstantExpression>(Value("approx_quantile")));
+	}
+	if (!extra.IsNull()) {
+		children.push_back(make_uniq<ConstantExpression>(extra));
+	}
+	auto result = make_uniq<FunctionExpression>(function, std::move(children));
+	result->alias = alias;
+	return std::move(result);
+}
+
+//! coalesce(len(degrees.out_degrees), 0), every distinct key has one entry in its degree list and an empty edge
+//! table has no list at all
+static unique_ptr<ParsedExpression> GetDistinctKeyCount(bool is_source, const string &alias) {
+	vector<unique_ptr<ParsedExpression>> coalesce_children;
+	coalesce_children.push_back(GetListStatistic("len", is_source ? "out_degrees" : "in_degrees", ""));
+	coalesce_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(0)));
+	auto result = make_uniq<OperatorExpression>(ExpressionType::OPERATOR_COALESCE, std::move(coalesce_children));
+	result->alias = alias;
+	return std::move(result);
+}
+
+unique_ptr<CommonTableExpressionInfo>
+SummarizePropertyGraphFunction::CreateApproximateEdgeTableCTE(const shared_ptr<PropertyGraphTable> &edge_table) {
+	// SELECT count_star() AS edge_count, <degree list of the source key>, <degree list of the destination key>
+	// FROM edge_table, a single scan that every statistic below is derived from
+	auto degrees_node = make_uniq<SelectNode>();
+	degrees_node->select_list.push_back(GetTableCount("edge_count"));
+	degrees_node->select_list.push_back(GetDegreeList(edge_table, edge_table->source_fk[0], "out_degrees"));
+	degrees_node->select_list.push_back(GetDegreeList(edge_table, edge_table->destination_fk[0], "in_degrees"));
+	degrees_node->from_table = make_uniq<BaseTableRef>(
+	    TableDescription(edge_table->catalog_name, edge_table->schema_name, edge_table->table_name));
+	auto degrees_statement = make_uniq<SelectStatement>();
+	degrees_statement->node = std::move(degrees_node);
+
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(GetTableNameConstantExpression(edge_table->table_name, "table_name"));
+	select_node->select_list.push_back(IsVertexTableConstantExpression(false, "is_vertex_table"));
+	select_node->select_list.push_back(GetTableNameConstantExpression(edge_table->source_reference, "source_table"));
+	select_node->select_list.push_back(
+	    GetTableNameConstantExpression(edge_table->destination_reference, "destination_table"));
+	select_node->select_list.push_back(GetConstantNullExpressionWithAlias("vertex_count"));
+	select_node->select_list.push_back(make_uniq<ColumnRefExpression>("edge_count", "degrees"));
+	for (auto is_source : {true, false}) {
+		select_node->select_list.push_back(
+		    GetDistinctKeyCount(is_source, is_source ? "unique_source_count" : "unique_destination_count"));
+	}
+	// the vertices minus the distinct keys of the edge table, without the anti-join of GetIsolatedNodes
+	for (auto is_source : {true, false}) {
+		auto vertex_table = is_source ? edge_table->source_pg_table : edge_table->destination_pg_table;
+		vector<unique_ptr<ParsedExpression>> subtract_children;
+		subtract_children.push_back(GetCountStarTable(vertex_table));
+		subtract_children.push_back(GetDistinctKeyCount(is_source, ""));
+		vector<unique_ptr<ParsedExpression>> greatest_children;
+		greatest_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(0)));
+		greatest_children.push_back(make_uniq<FunctionExpression>("subtract", std::move(subtract_children)));
+		auto isolated = make_uniq<FunctionExpression>("greatest", std::move(greatest_children));
+		isolated->alias = is_source ? "isolated_sources" : "isolated_destinations";
+		select_node->select_list.push_back(std::move(isolated));
+	}
+	for (auto &direction : {"in", "out"}) {
+		auto list_column = StringUtil::Format("%s_degrees", direction);
+		select_node->select_list.push_back(
+		    GetListStatistic("list_avg", list_column, StringUtil::Format("avg_%s_degree", direction)));
+		select_node->select_list.push_back(
+		    GetListStatistic("list_min", list_column, StringUtil::Format("min_%s_degree", direction)));
+		select_node->select_list.push_back(
+		    GetListStatistic("list_max", list_column, StringUtil::Format("max_%s_degree", direction)));
+		select_node->select_list.push_back(GetListStatistic(
+		    "list_aggregate", list_column, StringUtil::Format("q25_%s_degree", direction), Value::FLOAT(0.25)));
+		select_node->select_list.push_back(GetListStatistic(
+		    "list_aggregate", list_column, StringUtil::Format("q50_%s_degree", direction), Value::FLOAT(0.5)));
+		select_node->select_list.push_back(GetListStatistic(
+		    "list_aggregate", list_column, StringUtil::Format("q75_%s_degree", direction), Value::FLOAT(0.75)));
+	}
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(degrees_statement), "degrees");
+
+	auto cte_info = make_uniq<CommonTableExpressionInfo>();
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	cte_info->query = std::move(select_statement);
+	return cte_info;
+}
+
+//! list_value(elements)[label + 1], a value per edge table picked by the label of the summary row
+static unique_ptr<ParsedExpression> GetLabelElement(vector<unique_ptr<ParsedExpression>> elements,
+                                                    const string &alias) {
+	vector<unique_ptr<ParsedExpression>> add_children;
+	add_children.push_back(make_uniq<ColumnRefExpression>("label", "summaries"));
+	add_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(1)));
+	vector<unique_ptr<ParsedExpression>> extract_children;
+	extract_children.push_back(make_uniq<FunctionExpression>("list_value", std::move(elements)));
+	extract_children.push_back(make_uniq<FunctionExpression>("add", std::move(add_children)));
+	auto result = make_uniq<FunctionExpression>("list_extract", std::move(extract_children));
+	result->alias = alias;
+	return std::move(result);
+}
+
+static unique_ptr<ParsedExpression> GetSummaryField(const string &field) {
+	vector<unique_ptr<ParsedExpression>> extract_children;
+	extract_children.push_back(make_uniq<ColumnRefExpression>("summary", "summaries"));
+	extract_children.push_back(make_uniq<ConstantExpression>(Value(field)));
+	auto result = make_uniq<FunctionExpression>("struct_extract", std::move(extract_children));
+	result->alias = field;
+	return std::move(result);
+}
+
+unique_ptr<SelectNode> SummarizePropertyGraphFunction::CreateCSRSummaryNode(CreatePropertyGraphInfo &pg_info) {
+	auto &edge_tables = pg_info.edge_tables;
+	// SELECT labels.range AS label, summarize_csr(0, labels.range + __x.temp) AS summary
+	// FROM range(edge table count) labels, __x
+	auto summary_node = make_uniq<SelectNode>();
+	summary_node->select_list.emplace_back(CreateColumnRefExpression("range", "labels", "label"));
+	vector<unique_ptr<ParsedExpression>> label_children;
+	label_children.push_back(make_uniq<ColumnRefExpression>("range", "labels"));
+	label_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+	vector<unique_ptr<ParsedExpression>> summarize_children;
+	summarize_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	summarize_children.push_back(make_uniq<FunctionExpression>("add", std::move(label_children)));
+	auto summarize_function = make_uniq<FunctionExpression>("summarize_csr", std::move(summarize_children));
+	summarize_function->alias = "summary";
+	summary_node->select_list.push_back(std::move(summarize_function));
+
+	vector<unique_ptr<ParsedExpression>> range_children;
+	range_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(static_cast<int64_t>(edge_tables.size()))));
+	auto range_ref = make_uniq<TableFunctionRef>();
+	range_ref->function = make_uniq<FunctionExpression>("range", std::move(range_children));
+	range_ref->alias = "labels";
+	auto cross_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	cross_join_ref->left = std::move(range_ref);
+	cross_join_ref->right = CreateCountCTESubquery();
+	summary_node->from_table = std::move(cross_join_ref);
+	// the label of every edge is the position of its table in edge_tables
+	auto csr_cte = CreateMultiLabelCSRCTE(pg_info, edge_tables, 0, summary_node);
+	summary_node->cte_map.map["csr_cte"] = std::move(csr_cte);
+
+	vector<unique_ptr<ParsedExpression>> table_names;
+	vector<unique_ptr<ParsedExpression>> source_tables;
+	vector<unique_ptr<ParsedExpression>> destination_tables;
+	vector<unique_ptr<ParsedExpression>> source_counts;
+	vector<unique_ptr<ParsedExpression>> destination_counts;
+	for (auto &edge_table : edge_tables) {
+		table_names.push_back(make_uniq<ConstantExpression>(Value(edge_table->table_name)));
+		source_tables.push_back(make_uniq<ConstantExpression>(Value(edge_table->source_reference)));
+		destination_tables.push_back(make_uniq<ConstantExpression>(Value(edge_table->destination_reference)));
+		source_counts.push_back(GetCountStarTable(edge_table->source_pg_table));
+		destination_counts.push_back(GetCountStarTable(edge_table->destination_pg_table));
+	}
+
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(GetLabelElement(std::move(table_names), "table_name"));
+	select_node->select_list.push_back(IsVertexTableConstantExpression(false, "is_vertex_table"));
+	select_node->select_list.push_back(GetLabelElement(std::move(source_tables), "source_table"));
+	select_node->select_list.push_back(GetLabelElement(std::move(destination_tables), "destination_table"));
+	select_node->select_list.push_back(GetConstantNullExpressionWithAlias("vertex_count"));
+	select_node->select_list.push_back(GetSummaryField("edge_count"));
+	select_node->select_list.push_back(GetSummaryField("unique_source_count"));
+	select_node->select_list.push_back(GetSummaryField("unique_destination_count"));
+	// the vertices of the source and destination tables without an edge of this table
+	for (auto is_source : {true, false}) {
+		vector<unique_ptr<ParsedExpression>> subtract_children;
+		subtract_children.push_back(
+		    GetLabelElement(std::move(is_source ? source_counts : destination_counts), "vertex_count"));
+		subtract_children.push_back(GetSummaryField(is_source ? "unique_source_count" : "unique_destination_count"));
+		auto isolated = make_uniq<FunctionExpression>("subtract", std::move(subtract_children));
+		isolated->alias = is_source ? "isolated_sources" : "isolated_destinations";
+		select_node->select_list.push_back(std::move(isolated));
+	}
+	for (auto &direction : {"in", "out"}) {
+		for (auto &statistic : {"avg", "min", "max", "q25", "q50", "q75"}) {
+			select_node->select_list.push_back(GetSummaryField(StringUtil::Format("%s_%s_degree", statistic, direction)));
+		}
+	}
+	select_node->select_list.push_back(GetSummaryField("self_loops"));
+
+	auto summary_statement = make_uniq<SelectStatement>();
+	summary_statement->node = std::move(summary_node);
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(summary_statement), "summaries");
+	return select_node;
+}
+
 unique_ptr<TableRef>
 SummarizePropertyGraphFunction::HandleSingleVertexTable(const shared_ptr<PropertyGraphTable> &vertex_table,
                                                         const string &stat_table_alias) {
@@ -286,6 +501,33 @@ unique_ptr<SelectNode> CreateInnerSelectStatNode(const string &stat_table_alias)
 	return inner_select_node;
 }
 
+unique_ptr<TableRef> SummarizePropertyGraphFunction::SummarizePropertyGraphCSR(CreatePropertyGraphInfo &pg_info) {
+	vector<unique_ptr<QueryNode>> nodes;
+	for (auto &vertex_table : pg_info.vertex_tables) {
+		string stat_table_alias = vertex_table->table_name + "_stats";
+		auto inner_select_node = CreateInnerSelectStatNode(stat_table_alias);
+		inner_select_node->cte_map.map.insert(stat_table_alias, CreateVertexTableCTE(vertex_table));
+		inner_select_node->select_list.push_back(GetConstantNullExpressionWithAlias("self_loops"));
+		nodes.push_back(std::move(inner_select_node));
+	}
+	if (!pg_info.edge_tables.empty()) {
+		nodes.push_back(CreateCSRSummaryNode(pg_info));
+	}
+
+	auto select_stmt = make_uniq<SelectStatement>();
+	if (nodes.size() == 1) {
+		select_stmt->node = std::move(nodes[0]);
+	} else {
+		auto final_union_node = make_uniq<SetOperationNode>();
+		final_union_node->setop_type = SetOperationType::UNION;
+		final_union_node->setop_all = true;
+		final_union_node->children = std::move(nodes);
+		select_stmt->node = std::move(final_union_node);
+	}
+	auto subquery = make_uniq<SubqueryRef>(std::move(select_stmt));
+	return std::move(subquery);
+}
+
 unique_ptr<TableRef>
 SummarizePropertyGraphFunction::SummarizePropertyGraphBindReplace(ClientContext &context,
                                                                   TableFunctionBindInput &bind_input) {
@@ -294,6 +536,15 @@ SummarizePropertyGraphFunction::SummarizePropertyGraphBindReplace(ClientContext
 	string property_graph = bind_input.inputs[0].GetValue<string>();
 	auto pg_info = duckpgq_state->GetPropertyGraph(property_graph);
 
+	auto mode = SummarizeMode::SQL;
+	auto mode_entry = bind_input.named_parameters.find("mode");
+	if (mode_entry != bind_input.named_parameters.end() && !mode_entry->second.IsNull()) {
+		mode = ParseSummarizeMode(StringValue::Get(mode_entry->second));
+	}
+	if (mode == SummarizeMode::CSR) {
+		return SummarizePropertyGraphCSR(*pg_info);
+	}
+
 	if (pg_info->vertex_tables.size() == 1 && pg_info->edge_tables.empty()) {
 		// Special case where we don't want to create a union across the different
 		// tables
@@ -314,7 +565,11 @@ SummarizePropertyGraphFunction::SummarizePropertyGraphBindReplace(ClientContext
 		string stat_table_alias = edge_table->source_reference + "_" + edge_table->table_name + "_" +
 		                          edge_table->destination_reference + "_stats";
 		auto inner_select_node = CreateInnerSelectStatNode(stat_table_alias);
-		inner_select_node->cte_map.map.insert(stat_table_alias, CreateEdgeTableCTE(edge_table));
+		if (mode == SummarizeMode::APPROXIMATE) {
+			inner_select_node->cte_map.map.insert(stat_table_alias, CreateApproximateEdgeTableCTE(edge_table));
+		} else {
+			inner_select_node->cte_map.map.insert(stat_table_alias, CreateEdgeTableCTE(edge_table));
+		}
 		AddToUnionNode(final_union_node, inner_select_node);
 	}
 
@@ -0,0 +1,188 @@
+#include "duckpgq/core/functions/table/triangle_count.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/expression/cast_expression.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/tableref/joinref.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <duckpgq/core/functions/table.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+//! Per-vertex counts of the undirected CSR of the edge table, in the column triangles, and wedges when asked for.
+//! Both come from one local_triangle_wedge_count call, so the CSR is oriented once.
+static unique_ptr<SubqueryRef> CreateVertexCountsSubquery(ClientContext &context, TableFunctionBindInput &input,
+                                                          bool with_wedges) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_label = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_label = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_label, edge_label);
+
+	if (!with_wedges) {
+		auto select_node = CreateSelectNode(edge_pg_entry, "local_triangle_count", "triangles");
+		select_node->cte_map.map["csr_cte"] = CreateDenseUndirectedCSRCTE(edge_pg_entry, select_node);
+		auto subquery = make_uniq<SelectStatement>();
+		subquery->node = std::move(select_node);
+		return make_uniq<SubqueryRef>(std::move(subquery), "vertex_counts");
+	}
+
+	auto counts_node = make_uniq<SelectNode>();
+	vector<unique_ptr<ParsedExpression>> vertex_children;
+	vertex_children.push_back(GetDenseVertexId(GetVertexDictionaryId(0, 0), edge_pg_entry->source_pk,
+	                                           edge_pg_entry->source_reference));
+	vertex_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+	vector<unique_ptr<ParsedExpression>> function_children;
+	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	function_children.push_back(make_uniq<FunctionExpression>("add", std::move(vertex_children)));
+	auto function = make_uniq<FunctionExpression>("local_triangle_wedge_count", std::move(function_children));
+	function->alias = "counts";
+	counts_node->select_list.push_back(std::move(function));
+
+	auto cross_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	cross_join_ref->left = edge_pg_entry->source_pg_table->CreateBaseTableRef();
+	cross_join_ref->right = CreateCountCTESubquery();
+	counts_node->from_table = std::move(cross_join_ref);
+	counts_node->cte_map.map["csr_cte"] = CreateDenseUndirectedCSRCTE(edge_pg_entry, counts_node);
+
+	auto select_node = make_uniq<SelectNode>();
+	for (auto &field : {"triangles", "wedges"}) {
+		vector<unique_ptr<ParsedExpression>> extract_children;
+		extract_children.push_back(make_uniq<ColumnRefExpression>("counts", "vertex_triangles"));
+		extract_children.push_back(make_uniq<ConstantExpression>(Value(field)));
+		auto extract = make_uniq<FunctionExpression>("struct_extract", std::move(extract_children));
+		extract->alias = field;
+		select_node->select_list.push_back(std::move(extract));
+	}
+	auto counts_statement = make_uniq<SelectStatement>();
+	counts_statement->node = std::move(counts_node);
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(counts_statement), "vertex_triangles");
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+	return make_uniq<SubqueryRef>(std::move(subquery), "vertex_counts");
+}
+
+static unique_ptr<ParsedExpression> SumColumn(const string &column) {
+	vector<unique_ptr<ParsedExpression>> children;
+	children.push_back(make_uniq<ColumnRefExpression>(column, "vertex_counts"));
+	return make_uniq<FunctionExpression>("sum", std::move(children));
+}
+
+// Main binding function
+unique_ptr<TableRef> TriangleCountFunction::TriangleCountBindReplace(ClientContext &context,
+                                                                     TableFunctionBindInput &input) {
+	// every triangle is counted at each of its three corners
+	auto select_node = make_uniq<SelectNode>();
+	vector<unique_ptr<ParsedExpression>> div_children;
+	div_children.push_back(SumColumn("triangles"));
+	div_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(3)));
+	auto triangles = make_uniq<CastExpression>(LogicalType::BIGINT,
+	                                           make_uniq<FunctionExpression>("//", std::move(div_children)));
+	triangles->alias = "triangle_count";
+	select_node->select_list.push_back(std::move(triangles));
+	select_node->from_table = CreateVertexCountsSubquery(context, input, false);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "triangle_count";
+	return std::move(result);
+}
+
+unique_ptr<TableRef>
+GlobalClusteringCoefficientFunction::GlobalClusteringCoefficientBindReplace(ClientContext &context,
+                                                                            TableFunctionBindInput &input) {
+	// the corner counts sum to three times the triangles already
+	auto select_node = make_uniq<SelectNode>();
+	vector<unique_ptr<ParsedExpression>> div_children;
+	div_children.push_back(make_uniq<CastExpression>(LogicalType::DOUBLE, SumColumn("triangles")));
+	div_children.push_back(SumColumn("wedges"));
+	auto coefficient = make_uniq<FunctionExpression>("/", std::move(div_children));
+	coefficient->alias = "global_clustering_coefficient";
+	select_node->select_list.push_back(std::move(coefficient));
+	select_node->from_table = CreateVertexCountsSubquery(context, input, true);
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "global_clustering_coefficient";
+	return std::move(result);
+}
+
+unique_ptr<TableRef>
+ApproximateTriangleCountFunction::ApproximateTriangleCountBindReplace(ClientContext &context,
+                                                                      TableFunctionBindInput &input) {
+	auto pg_name = StringUtil::Lower(StringValue::Get(input.inputs[0]));
+	auto node_label = StringUtil::Lower(StringValue::Get(input.inputs[1]));
+	auto edge_label = StringUtil::Lower(StringValue::Get(input.inputs[2]));
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, node_label, edge_label);
+
+	double error = APPROXIMATE_TRIANGLE_DEFAULT_ERROR;
+	double confidence = APPROXIMATE_TRIANGLE_DEFAULT_CONFIDENCE;
+	for (auto &parameter : input.named_parameters) {
+		if (parameter.second.IsNull()) {
+			continue;
+		}
+		if (parameter.first == "error") {
+			error = parameter.second.GetValue<double>();
+		} else if (parameter.first == "confidence") {
+			confidence = parameter.second.GetValue<double>();
+		}
+	}
+
+	// the estimate is the same for every vertex, it is computed once over the single row of the CSR count. The
+	// approximate_triangle_count scalar validates the parameters.
+	auto estimate_node = make_uniq<SelectNode>();
+	vector<unique_ptr<ParsedExpression>> function_children;
+	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	function_children.push_back(make_uniq<ColumnRefExpression>("temp", "__x"));
+	function_children.push_back(make_uniq<ConstantExpression>(Value::DOUBLE(error)));
+	function_children.push_back(make_uniq<ConstantExpression>(Value::DOUBLE(confidence)));
+	auto function = make_uniq<FunctionExpression>("approximate_triangle_count", std::move(function_children));
+	function->alias = "estimate";
+	estimate_node->select_list.push_back(std::move(function));
+
+	estimate_node->from_table = CreateCountCTESubquery();
+	estimate_node->cte_map.map["csr_cte"] = CreateDenseUndirectedCSRCTE(edge_pg_entry, estimate_node);
+
+	auto select_node = make_uniq<SelectNode>();
+	for (auto &field : {"triangle_count", "lower_bound", "upper_bound", "global_clustering_coefficient", "samples",
+	                    "error_met"}) {
+		vector<unique_ptr<ParsedExpression>> extract_children;
+		extract_children.push_back(make_uniq<ColumnRefExpression>("estimate", "triangle_estimate"));
+		extract_children.push_back(make_uniq<ConstantExpression>(Value(field)));
+		auto extract = make_uniq<FunctionExpression>("struct_extract", std::move(extract_children));
+		extract->alias = field;
+		select_node->select_list.push_back(std::move(extract));
+	}
+	auto estimate_statement = make_uniq<SelectStatement>();
+	estimate_statement->node = std::move(estimate_node);
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(estimate_statement), "triangle_estimate");
+
+	auto subquery = make_uniq<SelectStatement>();
+	subquery->node = std::move(select_node);
+
+	auto result = make_uniq<SubqueryRef>(std::move(subquery));
+	result->alias = "approximate_triangle_count";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+// Register functions
+//------------------------------------------------------------------------------
+void CoreTableFunctions::RegisterTriangleCountTableFunctions(ExtensionLoader &loader) {
+	loader.RegisterFunction(TriangleCountFunction());
+	loader.RegisterFunction(GlobalClusteringCoefficientFunction());
+	loader.RegisterFunction(ApproximateTriangleCountFunction());
+}
+
+} // namespace duckdb
@@ -6,6 +6,7 @@
 #include "duckpgq/core/operator/duckpgq_operator.hpp"
 #include "duckpgq/core/parser/duckpgq_parser.hpp"
 #include "duckpgq/core/pragma/duckpgq_pragma.hpp"
+#include "duckdb/main/config.hpp"
 
 namespace duckdb {
 
@@ -15,6 +16,21 @@ void CoreModule::Register(ExtensionLoader &loader) {
 	CorePGQParser::Register(loader);
 	CorePGQPragma::Register(loader);
 	CorePGQOperator::Register(loader);
+
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption("duckpgq_vertex_reordering",
+	                          "Relabel the vertices of every CSR before the first traversal: none, degree or rcm",
+	                          LogicalType::VARCHAR, Value("none"));
+	config.AddExtensionOption("duckpgq_edge_map_mode",
+	                          "How path-finding levels visit the edges of their frontier: auto picks per level, sparse "
+	                          "and dense push from the frontier, pull scans the in-edges of the unvisited vertices",
+	                          LogicalType::VARCHAR, Value("auto"));
+	config.AddExtensionOption("duckpgq_hub_degree_threshold",
+	                          "Minimum degree of the vertices that get a neighbour bitmap next to their CSR adjacency "
+	                          "list, read by edge existence checks (csr_has_edge and the triangle estimator) but not by "
+	                          "path finding. 0 derives it from the vertex count, a negative value (the default) disables "
+	                          "bitmap rows",
+	                          LogicalType::BIGINT, Value::BIGINT(-1));
 }
 
 } // namespace duckdb
@@ -0,0 +1,119 @@
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/function/pragma_function.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include <duckpgq/core/pragma/duckpgq_pragma.hpp>
+#include <duckpgq/core/utils/duckpgq_utils.hpp>
+
+namespace duckdb {
+
+static string QualifiedTableName(const PropertyGraphTable &table) {
+	string result;
+	if (!table.catalog_name.empty()) {
+		result += KeywordHelper::WriteOptionallyQuoted(table.catalog_name) + ".";
+	}
+	if (!table.schema_name.empty()) {
+		result += KeywordHelper::WriteOptionallyQuoted(table.schema_name) + ".";
+	}
+	return result + KeywordHelper::WriteOptionallyQuoted(table.table_name);
+}
+
+static string JoinColumns(const vector<string> &columns) {
+	string result;
+	for (idx_t i = 0; i < columns.size(); i++) {
+		result += (i > 0 ? ", " : "") + KeywordHelper::WriteOptionallyQuoted(columns[i]);
+	}
+	return result;
+}
+
+//! EXISTS (...) that keeps an edge whose key columns reference a vertex of the projected vertex table
+static string ReferencesProjectedVertex(const string &vertex_table, const vector<string> &fk,
+                                        const vector<string> &pk) {
+	string result = "EXISTS (SELECT 1 FROM " + vertex_table + " __v WHERE ";
+	for (idx_t i = 0; i < fk.size(); i++) {
+		result += (i > 0 ? " AND " : "") + string("__v.") + KeywordHelper::WriteOptionallyQuoted(pk[i]) +
+		          " = __e." + KeywordHelper::WriteOptionallyQuoted(fk[i]);
+	}
+	return result + ")";
+}
+
+static string PragmaCreateProjection(ClientContext &context, const FunctionParameters &parameters) {
+	auto pg_name = StringUtil::Lower(parameters.values[0].GetValue<string>());
+	auto projection_name = StringUtil::Lower(parameters.values[1].GetValue<string>());
+	auto vertex_label = StringUtil::Lower(parameters.values[2].GetValue<string>());
+	auto edge_label = StringUtil::Lower(parameters.values[3].GetValue<string>());
+	auto vertex_predicate = parameters.values[4].IsNull() ? string() : parameters.values[4].GetValue<string>();
+	auto edge_predicate = parameters.values[5].IsNull() ? string() : parameters.values[5].GetValue<string>();
+	if (vertex_predicate.empty()) {
+		vertex_predicate = "true";
+	}
+	if (edge_predicate.empty()) {
+		edge_predicate = "true";
+	}
+
+	auto duckpgq_state = GetDuckPGQState(context);
+	auto pg_info = GetPropertyGraphInfo(duckpgq_state, pg_name);
+	auto edge_pg_entry = ValidateSourceNodeAndEdgeTable(pg_info, vertex_label, edge_label);
+	auto &vertex_pg_entry = *pg_info->GetTableByLabel(vertex_label, true, true);
+	if (!StringUtil::CIEquals(edge_pg_entry->destination_reference, vertex_pg_entry.table_name)) {
+		throw InvalidInputException("A projection needs an edge table that connects %s to itself, %s does not",
+		                            vertex_label, edge_label);
+	}
+
+	auto vertex_projection = projection_name + "_" + StringUtil::Lower(vertex_pg_entry.table_name);
+	auto edge_projection = projection_name + "_" + StringUtil::Lower(edge_pg_entry->table_name);
+	auto quoted_vertex_projection = KeywordHelper::WriteOptionallyQuoted(vertex_projection);
+	auto quoted_edge_projection = KeywordHelper::WriteOptionallyQuoted(edge_projection);
+	// a projection never replaces existing tables or graphs, checked up front so a collision creates nothing
+	if (duckpgq_state->registered_property_graphs.find(projection_name) !=
+	    duckpgq_state->registered_property_graphs.end()) {
+		throw InvalidInputException("Cannot create projection %s, a property graph with that name already exists",
+		                            projection_name);
+	}
+	for (auto &table_name : {vertex_projection, edge_projection}) {
+		if (Catalog::GetEntry<TableCatalogEntry>(context, INVALID_CATALOG, INVALID_SCHEMA, table_name,
+		                                         OnEntryNotFound::RETURN_NULL)) {
+			throw InvalidInputException("Cannot create projection %s, table %s already exists", projection_name,
+			                            table_name);
+		}
+	}
+
+	// The projection is a copy: the matching rows are copied into new tables, later changes to the property graph
+	// tables do not reach it. The copies are built in rowid order, so their rowids are dense ids of the subgraph and
+	// original_rowid maps them back to the rows of the property graph tables.
+	string result = "CREATE TABLE " + quoted_vertex_projection +
+	                " AS SELECT rowid AS original_rowid, * FROM " + QualifiedTableName(vertex_pg_entry) + " WHERE (" +
+	                vertex_predicate + ") ORDER BY rowid;\n";
+	result += "CREATE TABLE " + quoted_edge_projection +
+	          " AS SELECT __e.rowid AS original_rowid, __e.* FROM " + QualifiedTableName(*edge_pg_entry) +
+	          " __e WHERE (" + edge_predicate + ") AND " +
+	          ReferencesProjectedVertex(quoted_vertex_projection, edge_pg_entry->source_fk, edge_pg_entry->source_pk) +
+	          " AND " +
+	          ReferencesProjectedVertex(quoted_vertex_projection, edge_pg_entry->destination_fk,
+	                                    edge_pg_entry->destination_pk) +
+	          " ORDER BY __e.rowid;\n";
+	result += "-CREATE PROPERTY GRAPH " + KeywordHelper::WriteOptionallyQuoted(projection_name) +
+	          " VERTEX TABLES (" + quoted_vertex_projection + " LABEL " +
+	          KeywordHelper::WriteOptionallyQuoted(vertex_label) + ") EDGE TABLES (" + quoted_edge_projection +
+	          " SOURCE KEY (" + JoinColumns(edge_pg_entry->source_fk) + ") REFERENCES " + quoted_vertex_projection +
+	          " (" + JoinColumns(edge_pg_entry->source_pk) + ") DESTINATION KEY (" +
+	          JoinColumns(edge_pg_entry->destination_fk) + ") REFERENCES " + quoted_vertex_projection + " (" +
+	          JoinColumns(edge_pg_entry->destination_pk) + ") LABEL " + KeywordHelper::WriteOptionallyQuoted(edge_label) +
+	          ")";
+	return result;
+}
+
+void CorePGQPragma::RegisterCreateProjection(ExtensionLoader &loader) {
+	auto pragma_func = PragmaFunction::PragmaCall("create_projection", PragmaCreateProjection,
+	                                              {
+	                                                  LogicalType::VARCHAR, // Property graph
+	                                                  LogicalType::VARCHAR, // Projection name
+	                                                  LogicalType::VARCHAR, // Vertex label
+	                                                  LogicalType::VARCHAR, // Edge label
+	                                                  LogicalType::VARCHAR, // Vertex predicate
+	                                                  LogicalType::VARCHAR  // Edge predicate
+	                                              });
+	loader.RegisterFunction(pragma_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,258 @@
+#include "duckpgq/core/utils/centrality.hpp"
+#include "duckdb/common/bit_utils.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <numeric>
+#include <random>
+
+namespace duckdb {
+
+//! Calls fun(lane) for every set lane below lanes, a word at a time
+template <class FUNC>
+static void ForEachLane(const std::bitset<LANE_LIMIT> &bits, idx_t lanes, FUNC &&fun) {
+	static const std::bitset<LANE_LIMIT> word_mask(NumericLimits<uint64_t>::Maximum());
+	for (idx_t word_begin = 0; word_begin < lanes; word_begin += 64) {
+		auto word = static_cast<uint64_t>(((bits >> word_begin) & word_mask).to_ullong());
+		while (word) {
+			fun(word_begin + CountZeros<uint64_t>::Trailing(word));
+			word &= word - 1;
+		}
+	}
+}
+
+vector<int64_t> SelectCentralitySources(const CSR &csr, int64_t sample_count) {
+	auto vertex_count = csr.VertexCount();
+	vector<int64_t> sources(vertex_count);
+	std::iota(sources.begin(), sources.end(), 0);
+	if (sample_count > 0 && sample_count < vertex_count) {
+		// partial Fisher-Yates over the rowids, so the sample does not depend on the vertex order
+		std::mt19937_64 generator(CENTRALITY_SAMPLE_SEED);
+		for (int64_t i = 0; i < sample_count; i++) {
+			std::uniform_int_distribution<int64_t> pick(i, vertex_count - 1);
+			std::swap(sources[i], sources[pick(generator)]);
+		}
+		sources.resize(sample_count);
+	}
+	for (auto &source : sources) {
+		source = csr.ToInternal(source);
+	}
+	return sources;
+}
+
+//! Per-vertex state of the LaneBfs of a batch whatever its lane count: seen, visit and next, and the two frontiers
+static constexpr idx_t LANE_BFS_VERTEX_BYTES = 3 * sizeof(std::bitset<LANE_LIMIT>) + 2 * sizeof(int64_t);
+
+void ForEachSourceBatch(ClientContext &context, int64_t vertex_count, const vector<int64_t> &sources,
+                        idx_t vertex_bytes, idx_t lane_bytes, const std::function<void(const int64_t *, idx_t)> &fun) {
+	if (sources.empty()) {
+		return;
+	}
+	auto vertices = MaxValue<idx_t>(static_cast<idx_t>(vertex_count), 1);
+	auto fixed_bytes = vertices * (LANE_BFS_VERTEX_BYTES + vertex_bytes);
+	// every running batch holds its own state, so the budget is shared by the batches that run at the same time.
+	// Fewer batches run at once when even a single lane per batch would not fit the budget of every thread.
+	auto thread_count = NumericCast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+	auto single_lane_bytes = fixed_bytes + vertices * lane_bytes;
+	auto concurrent_batches =
+	    MinValue<idx_t>(thread_count, MaxValue<idx_t>(CENTRALITY_BATCH_BYTES / single_lane_bytes, 1));
+	auto batch_budget = CENTRALITY_BATCH_BYTES / concurrent_batches;
+	idx_t lanes = LANE_LIMIT;
+	if (lane_bytes > 0) {
+		auto lane_budget = batch_budget > fixed_bytes ? batch_budget - fixed_bytes : 0;
+		lanes = MinValue<idx_t>(LANE_LIMIT, MaxValue<idx_t>(lane_budget / (vertices * lane_bytes), 1));
+	}
+	// few sources are spread over the threads rather than filling a single batch
+	auto sources_per_thread = (sources.size() + concurrent_batches - 1) / concurrent_batches;
+	lanes = MinValue<idx_t>(lanes, MaxValue<idx_t>(sources_per_thread, CENTRALITY_MIN_BATCH_LANES));
+
+	// one task per concurrent batch, every task takes the next batch until none are left
+	auto batch_count = (sources.size() + lanes - 1) / lanes;
+	std::atomic<idx_t> next_batch {0};
+	TraversalParallelTasks(&context, MinValue<idx_t>(concurrent_batches, batch_count), [&](idx_t) {
+		for (auto batch = next_batch++; batch < batch_count; batch = next_batch++) {
+			auto begin = batch * lanes;
+			fun(sources.data() + begin, MinValue<idx_t>(lanes, sources.size() - begin));
+		}
+	});
+}
+
+//! Dependencies of every vertex on the sources of one batch, summed over the lanes
+static vector<double> BrandesBatch(const CSR &csr, const int64_t *sources, idx_t lanes) {
+	auto vertex_count = csr.VertexCount();
+	// per vertex and lane: shortest paths from the source, their length and the dependency of the source on the vertex
+	vector<double> paths(vertex_count * lanes, 0.0);
+	vector<int32_t> distance(vertex_count * lanes, -1);
+	vector<double> dependency(vertex_count * lanes, 0.0);
+
+	LaneBfs bfs(vertex_count);
+	for (idx_t lane = 0; lane < lanes; lane++) {
+		bfs.AddSource(sources[lane], lane, true);
+		paths[sources[lane] * lanes + lane] = 1.0;
+		distance[sources[lane] * lanes + lane] = 0;
+	}
+	// the batches already run in parallel, so the passes within one stay on its thread
+	TraversalOptions<CSR> options;
+	options.in_graph = csr.symmetric ? &csr : nullptr;
+
+	// vertices some lane reached at every level
+	vector<vector<int64_t>> levels;
+	levels.push_back(bfs.frontier.Vertices());
+	int32_t level = 1;
+	auto count_paths = [&](int64_t src, int64_t dst, const std::bitset<LANE_LIMIT> &reached) {
+		ForEachLane(reached, lanes, [&](idx_t lane) {
+			paths[dst * lanes + lane] += paths[src * lanes + lane];
+			distance[dst * lanes + lane] = level;
+		});
+	};
+	while (bfs.Step(csr, options, count_paths)) {
+		levels.push_back(bfs.frontier.Vertices());
+		level++;
+	}
+
+	auto lanes_at = [&](int64_t vertex, int32_t vertex_level) {
+		std::bitset<LANE_LIMIT> result;
+		auto vertex_distance = distance.data() + vertex * lanes;
+		for (idx_t lane = 0; lane < lanes; lane++) {
+			result[lane] = vertex_distance[lane] == vertex_level;
+		}
+		return result;
+	};
+	// every edge (v, w) on a shortest path from level - 1 to level adds paths(v) / paths(w) * (1 + dependency(w)) to
+	// the dependency of v, deepest level first so dependency(w) is complete when it is read
+	vector<std::bitset<LANE_LIMIT>> level_lanes(vertex_count);
+	for (auto child_level = static_cast<int32_t>(levels.size()) - 1; child_level > 0; child_level--) {
+		for (auto vertex : levels[child_level]) {
+			level_lanes[vertex] = lanes_at(vertex, child_level);
+		}
+		for (auto vertex : levels[child_level - 1]) {
+			auto parent_lanes = lanes_at(vertex, child_level - 1);
+			csr.ForEachNeighbor(vertex, [&](int64_t neighbor) {
+				ForEachLane(parent_lanes & level_lanes[neighbor], lanes, [&](idx_t lane) {
+					auto parent = vertex * lanes + lane;
+					auto child = neighbor * lanes + lane;
+					dependency[parent] += paths[parent] / paths[child] * (1.0 + dependency[child]);
+				});
+			});
+		}
+		for (auto vertex : levels[child_level]) {
+			level_lanes[vertex].reset();
+		}
+	}
+
+	// a source does not lie between itself and the others
+	vector<double> partial(vertex_count, 0.0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		for (idx_t lane = 0; lane < lanes; lane++) {
+			if (distance[vertex * lanes + lane] > 0) {
+				partial[vertex] += dependency[vertex * lanes + lane];
+			}
+		}
+	}
+	return partial;
+}
+
+vector<double> BetweennessCentrality(ClientContext &context, const CSR &csr, int64_t sample_count, bool normalized) {
+	auto vertex_count = csr.VertexCount();
+	auto sources = SelectCentralitySources(csr, sample_count);
+
+	vector<double> centrality(vertex_count, 0.0);
+	mutex centrality_lock;
+	// per vertex the level lanes and the partial centrality, per vertex and lane the path counts, dependencies,
+	// distances and at worst one level entry
+	idx_t vertex_bytes = sizeof(std::bitset<LANE_LIMIT>) + sizeof(double);
+	idx_t lane_bytes = 2 * sizeof(double) + sizeof(int32_t) + sizeof(int64_t);
+	auto add_batch = [&](const int64_t *batch, idx_t lanes) {
+		auto partial = BrandesBatch(csr, batch, lanes);
+		lock_guard<mutex> guard(centrality_lock);
+		for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+			centrality[vertex] += partial[vertex];
+		}
+	};
+	ForEachSourceBatch(context, vertex_count, sources, vertex_bytes, lane_bytes, add_batch);
+
+	auto scale = static_cast<double>(vertex_count) / static_cast<double>(MaxValue<idx_t>(sources.size(), 1));
+	if (normalized && vertex_count > 2) {
+		scale /= static_cast<double>(vertex_count - 1) * static_cast<double>(vertex_count - 2);
+	}
+	if (scale != 1.0) {
+		for (auto &score : centrality) {
+			score *= scale;
+		}
+	}
+	return centrality;
+}
+
+//! Per vertex: the sources that reach it, and the sum of their distances and inverse distances to it
+struct DistanceSums {
+	explicit DistanceSums(int64_t vertex_count)
+	    : reached(vertex_count, 0.0), distance(vertex_count, 0.0), inverse_distance(vertex_count, 0.0) {
+	}
+
+	vector<double> reached;
+	vector<double> distance;
+	vector<double> inverse_distance;
+};
+
+static DistanceSums SumDistances(ClientContext &context, const CSR &csr, int64_t sample_count) {
+	auto vertex_count = csr.VertexCount();
+	auto sources = SelectCentralitySources(csr, sample_count);
+
+	DistanceSums sums(vertex_count);
+	mutex sums_lock;
+	// a batch holds the bitsets of its BFS and three partial sums per vertex, nothing per lane
+	ForEachSourceBatch(context, vertex_count, sources, 3 * sizeof(double), 0, [&](const int64_t *batch, idx_t lanes) {
+		DistanceSums partial(vertex_count);
+		LaneBfs bfs(vertex_count);
+		for (idx_t lane = 0; lane < lanes; lane++) {
+			bfs.AddSource(batch[lane], lane, true);
+		}
+		TraversalOptions<CSR> options;
+		options.in_graph = csr.symmetric ? &csr : nullptr;
+		for (int64_t level = 1; bfs.Step(csr, options); level++) {
+			// the lanes that reached the vertex at this level are the sources at distance level
+			for (auto vertex : bfs.frontier.Vertices()) {
+				auto count = static_cast<double>(bfs.visit[vertex].count());
+				partial.reached[vertex] += count;
+				partial.distance[vertex] += count * static_cast<double>(level);
+				partial.inverse_distance[vertex] += count / static_cast<double>(level);
+			}
+		}
+		lock_guard<mutex> guard(sums_lock);
+		for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+			sums.reached[vertex] += partial.reached[vertex];
+			sums.distance[vertex] += partial.distance[vertex];
+			sums.inverse_distance[vertex] += partial.inverse_distance[vertex];
+		}
+	});
+
+	auto scale = static_cast<double>(vertex_count) / static_cast<double>(MaxValue<idx_t>(sources.size(), 1));
+	if (scale != 1.0) {
+		for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+			sums.reached[vertex] *= scale;
+			sums.distance[vertex] *= scale;
+			sums.inverse_distance[vertex] *= scale;
+		}
+	}
+	return sums;
+}
+
+vector<double> ClosenessCentrality(ClientContext &context, const CSR &csr, int64_t sample_count) {
+	auto vertex_count = csr.VertexCount();
+	auto sums = SumDistances(context, csr, sample_count);
+	vector<double> closeness(vertex_count, 0.0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		auto reached = sums.reached[vertex];
+		if (sums.distance[vertex] > 0) {
+			// scaled by the reached fraction, so a vertex reached by few close vertices does not score highest
+			closeness[vertex] = reached / sums.distance[vertex] * (reached / static_cast<double>(vertex_count - 1));
+		}
+	}
+	return closeness;
+}
+
+vector<double> HarmonicCentrality(ClientContext &context, const CSR &csr, int64_t sample_count) {
+	return SumDistances(context, csr, sample_count).inverse_distance;
+}
+
+} // namespace duckdb
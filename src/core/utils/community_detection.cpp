@@ -0,0 +1,468 @@
+#include "duckpgq/core/utils/community_detection.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace duckdb {
+
+//! splitmix64 of value under seed
+static uint64_t CommunityHash(uint64_t seed, uint64_t value) {
+	uint64_t x = (seed + 1) * 0x9E3779B97F4A7C15ULL + value;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+//! Sorts the (key, weight) pairs in [begin, end) by key and sums the weights of equal keys into the first of them,
+//! returns the number of distinct keys
+static idx_t MergeByKey(std::pair<int64_t, double> *begin, std::pair<int64_t, double> *end) {
+	std::sort(begin, end, [](const std::pair<int64_t, double> &a, const std::pair<int64_t, double> &b) {
+		return a.first < b.first;
+	});
+	idx_t size = 0;
+	for (auto pair = begin; pair != end; pair++) {
+		if (size > 0 && begin[size - 1].first == pair->first) {
+			begin[size - 1].second += pair->second;
+		} else {
+			begin[size++] = *pair;
+		}
+	}
+	return size;
+}
+static void MergeByKey(vector<std::pair<int64_t, double>> &pairs) {
+	pairs.resize(MergeByKey(pairs.data(), pairs.data() + pairs.size()));
+}
+
+//! Builds the graph from the unmerged list of every vertex, lists[offsets[v]...offsets[v + 1]) in place
+static CommunityGraph MergeLists(ClientContext &context, const vector<int64_t> &offsets,
+                                 vector<std::pair<int64_t, double>> &lists, double total_weight) {
+	auto vertex_count = static_cast<int64_t>(offsets.size()) - 1;
+	vector<int64_t> sizes(vertex_count);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			sizes[vertex] = static_cast<int64_t>(
+			    MergeByKey(lists.data() + offsets[vertex], lists.data() + offsets[vertex + 1]));
+		}
+	});
+
+	CommunityGraph graph;
+	graph.offsets.resize(vertex_count + 1, 0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		graph.offsets[vertex + 1] = graph.offsets[vertex] + sizes[vertex];
+	}
+	graph.targets.resize(graph.offsets[vertex_count]);
+	graph.weights.resize(graph.offsets[vertex_count]);
+	graph.degree.resize(vertex_count);
+	graph.total_weight = total_weight;
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			double degree = 0;
+			for (int64_t i = 0; i < sizes[vertex]; i++) {
+				auto &entry = lists[offsets[vertex] + i];
+				graph.targets[graph.offsets[vertex] + i] = entry.first;
+				graph.weights[graph.offsets[vertex] + i] = entry.second;
+				degree += entry.second;
+			}
+			graph.degree[vertex] = degree;
+		}
+	});
+	return graph;
+}
+
+CommunityGraph BuildCommunityGraph(ClientContext &context, const CSR &csr) {
+	auto vertex_count = csr.VertexCount();
+	auto offsets = reinterpret_cast<const int64_t *>(csr.v);
+	auto edge_weight = [&](int64_t offset) {
+		if (!csr.w_double.empty()) {
+			return csr.w_double[offset];
+		}
+		if (!csr.w.empty()) {
+			return static_cast<double>(csr.w[offset]);
+		}
+		return 1.0;
+	};
+
+	// every edge is listed at both of its endpoints, a self-loop twice at its vertex
+	vector<int64_t> list_offsets(vertex_count + 1, 0);
+	for (int64_t src = 0; src < vertex_count; src++) {
+		for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+			list_offsets[src + 1]++;
+			list_offsets[csr.e[offset] + 1]++;
+		}
+	}
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		list_offsets[vertex + 1] += list_offsets[vertex];
+	}
+	vector<std::pair<int64_t, double>> lists(list_offsets[vertex_count]);
+	vector<int64_t> fill(list_offsets.begin(), list_offsets.end() - 1);
+	double total_weight = 0;
+	for (int64_t src = 0; src < vertex_count; src++) {
+		for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+			auto weight = edge_weight(offset);
+			if (weight < 0) {
+				throw InvalidInputException("Community detection edge weights must not be negative, got %f", weight);
+			}
+			auto dst = csr.e[offset];
+			lists[fill[src]++] = std::make_pair(dst, weight);
+			lists[fill[dst]++] = std::make_pair(src, weight);
+			total_weight += 2 * weight;
+		}
+	}
+	return MergeLists(context, list_offsets, lists, total_weight);
+}
+
+vector<int64_t> LabelPropagation(ClientContext &context, const CommunityGraph &graph, uint64_t seed,
+                                 int64_t max_iterations) {
+	auto vertex_count = graph.VertexCount();
+	vector<int64_t> labels(vertex_count);
+	std::iota(labels.begin(), labels.end(), 0);
+	auto next_labels = labels;
+
+	for (int64_t iteration = 0; iteration < max_iterations; iteration++) {
+		auto iteration_seed = CommunityHash(seed, static_cast<uint64_t>(iteration));
+		idx_t changed = 0;
+		for (uint64_t half = 0; half < 2; half++) {
+			changed += TraversalParallelReduce<idx_t>(
+			    &context, vertex_count, 0,
+			    [&](idx_t begin, idx_t end) {
+				    idx_t range_changed = 0;
+				    vector<std::pair<int64_t, double>> label_weights;
+				    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+					    if ((CommunityHash(iteration_seed, static_cast<uint64_t>(vertex)) & 1) != half) {
+						    continue;
+					    }
+					    label_weights.clear();
+					    for (auto i = graph.offsets[vertex]; i < graph.offsets[vertex + 1]; i++) {
+						    if (graph.targets[i] != vertex) {
+							    label_weights.emplace_back(labels[graph.targets[i]], graph.weights[i]);
+						    }
+					    }
+					    MergeByKey(label_weights);
+					    double max_weight = 0;
+					    for (auto &entry : label_weights) {
+						    max_weight = MaxValue(max_weight, entry.second);
+					    }
+					    auto best = labels[vertex];
+					    auto keeps_label = std::any_of(
+					        label_weights.begin(), label_weights.end(), [&](const std::pair<int64_t, double> &entry) {
+						        return entry.first == best && entry.second == max_weight;
+					        });
+					    if (!keeps_label && max_weight > 0) {
+						    uint64_t best_hash = NumericLimits<uint64_t>::Maximum();
+						    for (auto &entry : label_weights) {
+							    auto hash = CommunityHash(seed, static_cast<uint64_t>(entry.first));
+							    if (entry.second == max_weight && hash < best_hash) {
+								    best_hash = hash;
+								    best = entry.first;
+							    }
+						    }
+					    }
+					    next_labels[vertex] = best;
+					    range_changed += best != labels[vertex];
+				    }
+				    return range_changed;
+			    },
+			    [](idx_t a, idx_t b) { return a + b; });
+			// the other half reads the labels of this one
+			labels = next_labels;
+		}
+		if (changed == 0) {
+			break;
+		}
+	}
+	return labels;
+}
+
+//! Renumbers the labels to [0, count) in the order their first vertex comes, returns count
+static int64_t Renumber(vector<int64_t> &labels) {
+	vector<int64_t> ids(labels.size(), -1);
+	int64_t count = 0;
+	for (auto &label : labels) {
+		if (ids[label] < 0) {
+			ids[label] = count++;
+		}
+		label = ids[label];
+	}
+	return count;
+}
+
+//! Leiden local moving: vertices move to the neighbouring community of the largest modularity gain, the vertices
+//! of one seeded phase at a time, each against the communities as they were before its phase
+static void MoveNodes(ClientContext &context, const CommunityGraph &graph, vector<int64_t> &community, uint64_t seed,
+                      double resolution) {
+	auto vertex_count = graph.VertexCount();
+	auto scale = resolution / graph.total_weight;
+	vector<double> community_degree(vertex_count, 0.0);
+	vector<int64_t> community_size(vertex_count, 0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		community_degree[community[vertex]] += graph.degree[vertex];
+		community_size[community[vertex]]++;
+	}
+
+	vector<int64_t> target(vertex_count, -1);
+	for (int64_t round = 0; round < LEIDEN_MAX_MOVE_ROUNDS; round++) {
+		auto round_seed = CommunityHash(seed, static_cast<uint64_t>(round));
+		idx_t moved = 0;
+		for (uint64_t phase = 0; phase < LEIDEN_MOVE_PHASES; phase++) {
+			TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+				vector<std::pair<int64_t, double>> community_weights;
+				for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+					if (CommunityHash(round_seed, static_cast<uint64_t>(vertex)) % LEIDEN_MOVE_PHASES != phase) {
+						continue;
+					}
+					community_weights.clear();
+					for (auto i = graph.offsets[vertex]; i < graph.offsets[vertex + 1]; i++) {
+						if (graph.targets[i] != vertex) {
+							community_weights.emplace_back(community[graph.targets[i]], graph.weights[i]);
+						}
+					}
+					MergeByKey(community_weights);
+
+					auto current = community[vertex];
+					auto degree = graph.degree[vertex];
+					double current_weight = 0;
+					for (auto &entry : community_weights) {
+						if (entry.first == current) {
+							current_weight = entry.second;
+						}
+					}
+					auto alone = community_size[current] == 1;
+					auto best = current;
+					auto best_gain = current_weight - scale * degree * (community_degree[current] - degree);
+					for (auto &entry : community_weights) {
+						// of two vertices alone in their communities only one joins the other, so they do not
+						// swap communities round after round
+						if (entry.first == current ||
+						    (alone && community_size[entry.first] == 1 && entry.first > current)) {
+							continue;
+						}
+						auto gain = entry.second - scale * degree * community_degree[entry.first];
+						if (gain > best_gain) {
+							best_gain = gain;
+							best = entry.first;
+						}
+					}
+					target[vertex] = best;
+				}
+			});
+			for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+				if (target[vertex] < 0) {
+					continue;
+				}
+				auto current = community[vertex];
+				if (target[vertex] != current) {
+					community_degree[current] -= graph.degree[vertex];
+					community_size[current]--;
+					community_degree[target[vertex]] += graph.degree[vertex];
+					community_size[target[vertex]]++;
+					community[vertex] = target[vertex];
+					moved++;
+				}
+				target[vertex] = -1;
+			}
+		}
+		if (moved == 0) {
+			break;
+		}
+	}
+}
+
+//! Leiden refinement: every community starts as singletons, which merge greedily into a well-connected
+//! subcommunity of the same community. Returns the subcommunity of every vertex, named by one of its vertices.
+static vector<int64_t> RefinePartition(ClientContext &context, const CommunityGraph &graph,
+                                       const vector<int64_t> &community, uint64_t seed, double resolution) {
+	auto vertex_count = graph.VertexCount();
+	auto scale = resolution / graph.total_weight;
+	vector<double> community_degree(vertex_count, 0.0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		community_degree[community[vertex]] += graph.degree[vertex];
+	}
+
+	// the vertices of every community, each in seeded order
+	vector<int64_t> members(vertex_count);
+	std::iota(members.begin(), members.end(), 0);
+	std::sort(members.begin(), members.end(), [&](int64_t a, int64_t b) {
+		if (community[a] != community[b]) {
+			return community[a] < community[b];
+		}
+		auto a_hash = CommunityHash(seed, static_cast<uint64_t>(a));
+		auto b_hash = CommunityHash(seed, static_cast<uint64_t>(b));
+		return a_hash < b_hash || (a_hash == b_hash && a < b);
+	});
+	vector<int64_t> community_begin;
+	for (int64_t i = 0; i < vertex_count; i++) {
+		if (i == 0 || community[members[i]] != community[members[i - 1]]) {
+			community_begin.push_back(i);
+		}
+	}
+	community_begin.push_back(vertex_count);
+
+	vector<int64_t> refined(vertex_count);
+	std::iota(refined.begin(), refined.end(), 0);
+	auto refined_degree = graph.degree;
+	vector<int64_t> refined_size(vertex_count, 1);
+	// weight between every subcommunity and the rest of its community
+	vector<double> external(vertex_count, 0.0);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			for (auto i = graph.offsets[vertex]; i < graph.offsets[vertex + 1]; i++) {
+				auto neighbor = graph.targets[i];
+				if (neighbor != vertex && community[neighbor] == community[vertex]) {
+					external[vertex] += graph.weights[i];
+				}
+			}
+		}
+	});
+
+	// communities only touch the state of their own vertices, so they are refined in parallel
+	TraversalParallelFor(&context, community_begin.size() - 1, [&](idx_t begin, idx_t end) {
+		vector<std::pair<int64_t, double>> subcommunity_weights;
+		for (auto c = begin; c < end; c++) {
+			for (auto i = community_begin[c]; i < community_begin[c + 1]; i++) {
+				auto vertex = members[i];
+				auto vertex_community = community[vertex];
+				auto rest_degree = community_degree[vertex_community];
+				// only singletons that are well connected to the rest of their community merge
+				if (refined_size[vertex] != 1 || refined[vertex] != vertex ||
+				    external[vertex] < scale * graph.degree[vertex] * (rest_degree - graph.degree[vertex])) {
+					continue;
+				}
+				subcommunity_weights.clear();
+				for (auto j = graph.offsets[vertex]; j < graph.offsets[vertex + 1]; j++) {
+					auto neighbor = graph.targets[j];
+					if (neighbor != vertex && community[neighbor] == vertex_community) {
+						subcommunity_weights.emplace_back(refined[neighbor], graph.weights[j]);
+					}
+				}
+				MergeByKey(subcommunity_weights);
+
+				auto best = vertex;
+				double best_gain = 0;
+				double best_weight = 0;
+				for (auto &entry : subcommunity_weights) {
+					auto subcommunity = entry.first;
+					if (external[subcommunity] <
+					    scale * refined_degree[subcommunity] * (rest_degree - refined_degree[subcommunity])) {
+						continue;
+					}
+					auto gain = entry.second - scale * graph.degree[vertex] * refined_degree[subcommunity];
+					if (gain > best_gain) {
+						best_gain = gain;
+						best = subcommunity;
+						best_weight = entry.second;
+					}
+				}
+				if (best != vertex) {
+					refined[vertex] = best;
+					refined_degree[best] += graph.degree[vertex];
+					refined_size[best]++;
+					refined_size[vertex] = 0;
+					external[best] += external[vertex] - 2 * best_weight;
+				}
+			}
+		}
+	});
+	return refined;
+}
+
+//! The graph of the nodes the vertices are mapped to, with the weights between and within nodes summed
+static CommunityGraph Aggregate(ClientContext &context, const CommunityGraph &graph, const vector<int64_t> &node,
+                                int64_t node_count) {
+	auto vertex_count = graph.VertexCount();
+	vector<int64_t> offsets(node_count + 1, 0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		offsets[node[vertex] + 1] += graph.offsets[vertex + 1] - graph.offsets[vertex];
+	}
+	for (int64_t i = 0; i < node_count; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+	vector<std::pair<int64_t, double>> lists(offsets[node_count]);
+	vector<int64_t> fill(offsets.begin(), offsets.end() - 1);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		for (auto i = graph.offsets[vertex]; i < graph.offsets[vertex + 1]; i++) {
+			lists[fill[node[vertex]]++] = std::make_pair(node[graph.targets[i]], graph.weights[i]);
+		}
+	}
+	return MergeLists(context, offsets, lists, graph.total_weight);
+}
+
+vector<int64_t> Leiden(ClientContext &context, const CommunityGraph &graph, uint64_t seed, double resolution,
+                       int64_t max_iterations) {
+	auto vertex_count = graph.VertexCount();
+	// the node of the current level every vertex belongs to, and the community of every node
+	vector<int64_t> node(vertex_count);
+	std::iota(node.begin(), node.end(), 0);
+	vector<int64_t> community(vertex_count);
+	std::iota(community.begin(), community.end(), 0);
+	if (graph.total_weight <= 0) {
+		return community;
+	}
+
+	const CommunityGraph *level_graph = &graph;
+	CommunityGraph aggregate;
+	for (int64_t level = 0; level < max_iterations; level++) {
+		auto level_seed = CommunityHash(seed, static_cast<uint64_t>(level));
+		auto node_count = level_graph->VertexCount();
+		MoveNodes(context, *level_graph, community, level_seed, resolution);
+		if (Renumber(community) == node_count) {
+			break;
+		}
+		auto refined = RefinePartition(context, *level_graph, community, level_seed, resolution);
+		auto refined_count = Renumber(refined);
+		if (refined_count == node_count) {
+			break;
+		}
+		// the aggregate graph starts from the unrefined communities
+		vector<int64_t> refined_community(refined_count);
+		for (int64_t i = 0; i < node_count; i++) {
+			refined_community[refined[i]] = community[i];
+		}
+		for (auto &vertex_node : node) {
+			vertex_node = refined[vertex_node];
+		}
+		auto next_graph = Aggregate(context, *level_graph, refined, refined_count);
+		aggregate = std::move(next_graph);
+		level_graph = &aggregate;
+		community = std::move(refined_community);
+	}
+
+	vector<int64_t> result(vertex_count);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		result[vertex] = community[node[vertex]];
+	}
+	return result;
+}
+
+double Modularity(ClientContext &context, const CommunityGraph &graph, const vector<int64_t> &community,
+                  double resolution) {
+	if (graph.total_weight <= 0) {
+		return 0;
+	}
+	auto vertex_count = graph.VertexCount();
+	auto internal_weight = TraversalParallelReduce<double>(
+	    &context, vertex_count, 0.0,
+	    [&](idx_t begin, idx_t end) {
+		    double weight = 0;
+		    for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			    for (auto i = graph.offsets[vertex]; i < graph.offsets[vertex + 1]; i++) {
+				    if (community[graph.targets[i]] == community[vertex]) {
+					    weight += graph.weights[i];
+				    }
+			    }
+		    }
+		    return weight;
+	    },
+	    [](double a, double b) { return a + b; });
+	vector<double> community_degree(vertex_count, 0.0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		community_degree[community[vertex]] += graph.degree[vertex];
+	}
+	double expected_weight = 0;
+	for (auto degree : community_degree) {
+		expected_weight += degree * degree;
+	}
+	return (internal_weight - resolution * expected_weight / graph.total_weight) / graph.total_weight;
+}
+
+} // namespace duckdb
@@ -1,6 +1,7 @@
 #include "duckpgq/core/utils/compressed_sparse_row.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/parser/expression/case_expression.hpp"
 #include "duckdb/parser/expression/comparison_expression.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/expression/star_expression.hpp"
@@ -8,6 +9,7 @@
 #include "duckdb/parser/tableref/subqueryref.hpp"
 
 #include <duckpgq/core/utils/duckpgq_utils.hpp>
+#include <numeric>
 
 namespace duckdb {
 
@@ -53,9 +55,524 @@ string CSR::ToString() const {
 		result << "w: W has not been initialized\n";
 	}
 
+	if (delta_size > 0) {
+		result << "\ndelta (" << delta_size.load() << " appended edges)\n";
+	}
+
 	return result.str();
 }
 
+idx_t CSR::AppendEdge(int64_t src, int64_t dst, int64_t edge_id, int64_t weight, double weight_double) {
+	auto vertex_count = static_cast<int64_t>(vsize) - 2;
+	if (src < 0 || src >= vertex_count || dst < 0 || dst >= vertex_count) {
+		throw ConstraintException("Appended edge (%d, %d) refers to a vertex outside the CSR, rebuild the CSR "
+		                          "to add new vertices",
+		                          src, dst);
+	}
+	CSRWriteGuard guard(access_lock);
+	delta[ToInternal(src)].push_back({ToInternal(dst), edge_id, weight, weight_double});
+	idx_t current_size = ++delta_size;
+	if (current_size >= compaction_threshold) {
+		CompactLocked();
+		return 0;
+	}
+	return current_size;
+}
+
+template <class T>
+static void GatherVector(vector<T> &values, const vector<int64_t> &source) {
+	if (values.empty()) {
+		return;
+	}
+	vector<T> new_values;
+	new_values.reserve(source.size());
+	for (auto offset : source) {
+		new_values.push_back(values[offset]);
+	}
+	values = std::move(new_values);
+}
+
+idx_t CSR::Compact() {
+	// nothing to merge, do not wait for the readers
+	if (!HasDelta()) {
+		return 0;
+	}
+	CSRWriteGuard guard(access_lock);
+	return CompactLocked();
+}
+
+idx_t CSR::CompactLocked() {
+	if (delta.empty()) {
+		return 0;
+	}
+	idx_t merged = delta_size;
+	auto new_e_size = e.size() + merged;
+
+	vector<int64_t> new_e;
+	vector<int64_t> new_edge_ids;
+	vector<int64_t> new_w;
+	vector<double> new_w_double;
+	vector<uint8_t> new_edge_labels;
+	new_e.reserve(new_e_size);
+	new_edge_ids.reserve(new_e_size);
+	if (!w.empty()) {
+		new_w.reserve(new_e_size);
+	}
+	if (!w_double.empty()) {
+		new_w_double.reserve(new_e_size);
+	}
+	if (!edge_labels.empty()) {
+		new_edge_labels.reserve(new_e_size);
+	}
+
+	vector<int64_t> source;
+	if (!edge_properties.empty()) {
+		source.reserve(new_e_size);
+	}
+
+	auto new_v = new std::atomic<int64_t>[vsize];
+	new_v[0] = 0;
+	for (idx_t i = 0; i + 1 < vsize; i++) {
+		for (auto offset = v[i].load(); offset < v[i + 1].load(); offset++) {
+			if (!edge_properties.empty()) {
+				source.push_back(offset);
+			}
+			new_e.push_back(e[offset]);
+			new_edge_ids.push_back(edge_ids[offset]);
+			if (!w.empty()) {
+				new_w.push_back(w[offset]);
+			}
+			if (!w_double.empty()) {
+				new_w_double.push_back(w_double[offset]);
+			}
+			if (!edge_labels.empty()) {
+				new_edge_labels.push_back(edge_labels[offset]);
+			}
+		}
+		auto entry = delta.find(static_cast<int64_t>(i));
+		if (entry != delta.end()) {
+			for (auto &edge : entry->second) {
+				if (!edge_properties.empty()) {
+					source.push_back(-1);
+				}
+				new_e.push_back(edge.dst);
+				new_edge_ids.push_back(edge.edge_id);
+				if (!w.empty()) {
+					new_w.push_back(edge.w);
+				}
+				if (!w_double.empty()) {
+					new_w_double.push_back(edge.w_double);
+				}
+				if (!edge_labels.empty()) {
+					new_edge_labels.push_back(0);
+				}
+			}
+		}
+		new_v[i + 1] = static_cast<int64_t>(new_e.size());
+	}
+
+	delete[] v;
+	v = new_v;
+	e = std::move(new_e);
+	edge_ids = std::move(new_edge_ids);
+	w = std::move(new_w);
+	w_double = std::move(new_w_double);
+	edge_labels = std::move(new_edge_labels);
+	delta.clear();
+	delta_size = 0;
+	ClearHubRows();
+	ResetTranspose();
+	GatherEdgeProperties(source);
+	if (initialized_times) {
+		// appended edges have no time property, they sort to the end of their adjacency lists
+		BuildTemporalIndexLocked(time_property);
+	}
+	return merged;
+}
+
+void CSR::ResetTranspose() {
+	lock_guard<mutex> guard(transpose_lock);
+	transpose.reset();
+}
+
+CSRReorderMethod ParseCSRReorderMethod(const string &method) {
+	auto lower_method = StringUtil::Lower(method);
+	if (lower_method == "none") {
+		return CSRReorderMethod::NONE;
+	}
+	if (lower_method == "degree") {
+		return CSRReorderMethod::DEGREE;
+	}
+	if (lower_method == "rcm") {
+		return CSRReorderMethod::RCM;
+	}
+	throw InvalidInputException("Unknown vertex reordering method '%s', expected none, degree or rcm", method);
+}
+
+// Returns the vertices in their new order, order[new_id] = old_id
+static vector<int64_t> ComputeVertexOrder(const CSR &csr, CSRReorderMethod method) {
+	auto vertex_count = csr.VertexCount();
+	auto offsets = reinterpret_cast<int64_t *>(csr.v);
+	auto degree = [&](int64_t vertex) {
+		return offsets[vertex + 1] - offsets[vertex];
+	};
+
+	vector<int64_t> order(vertex_count);
+	std::iota(order.begin(), order.end(), 0);
+	if (method == CSRReorderMethod::DEGREE) {
+		std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) { return degree(a) > degree(b); });
+		return order;
+	}
+
+	// Reverse Cuthill-McKee: BFS from the lowest degree vertex of every component, visiting neighbours by
+	// ascending degree, then reverse the visit order
+	std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) { return degree(a) < degree(b); });
+	vector<int64_t> result;
+	result.reserve(vertex_count);
+	vector<bool> visited(vertex_count, false);
+	vector<int64_t> neighbours;
+	for (auto start : order) {
+		if (visited[start]) {
+			continue;
+		}
+		visited[start] = true;
+		auto queue_head = result.size();
+		result.push_back(start);
+		while (queue_head < result.size()) {
+			auto vertex = result[queue_head++];
+			neighbours.clear();
+			csr.ForEachNeighbor(vertex, [&](int64_t neighbour) {
+				if (neighbour < vertex_count && !visited[neighbour]) {
+					visited[neighbour] = true;
+					neighbours.push_back(neighbour);
+				}
+			});
+			std::stable_sort(neighbours.begin(), neighbours.end(),
+			                 [&](int64_t a, int64_t b) { return degree(a) < degree(b); });
+			result.insert(result.end(), neighbours.begin(), neighbours.end());
+		}
+	}
+	std::reverse(result.begin(), result.end());
+	return result;
+}
+
+void CSR::Reorder(CSRReorderMethod method) {
+	if (method == CSRReorderMethod::NONE || !initialized_e) {
+		return;
+	}
+	CSRWriteGuard guard(access_lock);
+	CompactLocked();
+	auto vertex_count = VertexCount();
+	auto order = ComputeVertexOrder(*this, method);
+	vector<int64_t> position(vertex_count);
+	for (int64_t new_id = 0; new_id < vertex_count; new_id++) {
+		position[order[new_id]] = new_id;
+	}
+
+	vector<int64_t> new_e;
+	vector<int64_t> new_edge_ids;
+	vector<int64_t> new_w;
+	vector<double> new_w_double;
+	vector<uint8_t> new_edge_labels;
+	new_e.reserve(e.size());
+	new_edge_ids.reserve(edge_ids.size());
+	new_w.reserve(w.size());
+	new_w_double.reserve(w_double.size());
+	new_edge_labels.reserve(edge_labels.size());
+
+	// adjacency lists keep their internal order, so a temporal index stays sorted
+	bool track_source = !edge_properties.empty() || initialized_times;
+	vector<int64_t> source;
+	if (track_source) {
+		source.reserve(e.size());
+	}
+
+	auto new_v = new std::atomic<int64_t>[vsize];
+	new_v[0] = 0;
+	for (int64_t new_id = 0; new_id < vertex_count; new_id++) {
+		auto old_id = order[new_id];
+		for (auto offset = v[old_id].load(); offset < v[old_id + 1].load(); offset++) {
+			if (track_source) {
+				source.push_back(offset);
+			}
+			new_e.push_back(position[e[offset]]);
+			new_edge_ids.push_back(edge_ids[offset]);
+			if (!w.empty()) {
+				new_w.push_back(w[offset]);
+			}
+			if (!w_double.empty()) {
+				new_w_double.push_back(w_double[offset]);
+			}
+			if (!edge_labels.empty()) {
+				new_edge_labels.push_back(edge_labels[offset]);
+			}
+		}
+		new_v[new_id + 1] = static_cast<int64_t>(new_e.size());
+	}
+	// the padding entries past the last vertex keep pointing at the end of e
+	for (idx_t i = vertex_count + 1; i < vsize; i++) {
+		new_v[i] = static_cast<int64_t>(new_e.size());
+	}
+
+	delete[] v;
+	v = new_v;
+	e = std::move(new_e);
+	edge_ids = std::move(new_edge_ids);
+	w = std::move(new_w);
+	w_double = std::move(new_w_double);
+	edge_labels = std::move(new_edge_labels);
+	ClearHubRows();
+	ResetTranspose();
+	GatherEdgeProperties(source);
+	if (initialized_times) {
+		GatherVector(edge_times, source);
+	}
+
+	if (perm.empty()) {
+		perm = std::move(position);
+		inv_perm = std::move(order);
+		return;
+	}
+	for (int64_t rowid = 0; rowid < vertex_count; rowid++) {
+		perm[rowid] = position[perm[rowid]];
+		inv_perm[perm[rowid]] = rowid;
+	}
+}
+
+void CSR::BuildHubRows(int64_t degree_threshold) {
+	CSRWriteGuard guard(access_lock);
+	ClearHubRows();
+	auto vertex_count = VertexCount();
+	if (degree_threshold < 0 || !initialized_e || vertex_count <= 0) {
+		return;
+	}
+	if (degree_threshold == 0) {
+		// a bitmap row costs vertex_count bits, an adjacency list 64 bits per neighbour
+		degree_threshold = MaxValue<int64_t>(DEFAULT_HUB_MIN_DEGREE, vertex_count / 64);
+	}
+	auto offsets = reinterpret_cast<int64_t *>(v);
+	hub_slot.resize(vertex_count, -1);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		if (offsets[vertex + 1] - offsets[vertex] < degree_threshold) {
+			continue;
+		}
+		hub_slot[vertex] = static_cast<int64_t>(hub_rows.size());
+		hub_rows.emplace_back(vertex_count);
+		auto &row = hub_rows.back();
+		ForEachNeighbor(vertex, [&](int64_t neighbor) { row.set(neighbor); });
+	}
+	if (hub_rows.empty()) {
+		hub_slot.clear();
+	}
+}
+
+void CSR::ClearHubRows() {
+	hub_slot.clear();
+	hub_rows.clear();
+	hub_rows_checked = false;
+}
+
+const CSRTranspose &CSR::GetTranspose() {
+	lock_guard<mutex> guard(transpose_lock);
+	if (transpose) {
+		return *transpose;
+	}
+	auto vertex_count = VertexCount();
+	auto offsets = reinterpret_cast<int64_t *>(v);
+	auto result = make_uniq<CSRTranspose>();
+	result->v.assign(vertex_count + 1, 0);
+	for (int64_t offset = 0; offset < offsets[vertex_count]; offset++) {
+		result->v[e[offset] + 1]++;
+	}
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		result->v[vertex + 1] += result->v[vertex];
+	}
+	// counting sort by destination, scanning the sources in ascending order keeps every in-list sorted
+	auto fill = result->v;
+	result->e.resize(offsets[vertex_count]);
+	result->offsets.resize(offsets[vertex_count]);
+	for (int64_t src = 0; src < vertex_count; src++) {
+		for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+			auto position = fill[e[offset]]++;
+			result->e[position] = src;
+			result->offsets[position] = offset;
+		}
+	}
+	transpose = std::move(result);
+	return *transpose;
+}
+
+bool CSR::HasEdge(int64_t src, int64_t dst) const {
+	auto vertex_count = VertexCount();
+	if (src < 0 || src >= vertex_count || dst < 0 || dst >= vertex_count) {
+		return false;
+	}
+	auto row = GetHubRow(src);
+	if (row) {
+		if (row->test(dst)) {
+			return true;
+		}
+	} else {
+		auto offsets = reinterpret_cast<int64_t *>(v);
+		for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+			if (e[offset] == dst) {
+				return true;
+			}
+		}
+	}
+	auto delta_entry = delta.find(src);
+	if (delta_entry == delta.end()) {
+		return false;
+	}
+	for (auto &edge : delta_entry->second) {
+		if (edge.dst == dst) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int64_t CSR::FindEdgeId(int64_t src, int64_t dst) const {
+	auto offsets = reinterpret_cast<int64_t *>(v);
+	for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+		if (e[offset] == dst) {
+			return edge_ids[offset];
+		}
+	}
+	auto delta_entry = delta.find(src);
+	if (delta_entry != delta.end()) {
+		for (auto &edge : delta_entry->second) {
+			if (edge.dst == dst) {
+				return edge.edge_id;
+			}
+		}
+	}
+	return -1;
+}
+
+void CSR::BuildEdgeRowidIndex() {
+	int64_t max_rowid = -1;
+	for (auto rowid : edge_ids) {
+		max_rowid = MaxValue(max_rowid, rowid);
+	}
+	edge_rowid_offsets.assign(max_rowid + 2, 0);
+	for (auto rowid : edge_ids) {
+		edge_rowid_offsets[rowid + 1]++;
+	}
+	for (idx_t i = 1; i < edge_rowid_offsets.size(); i++) {
+		edge_rowid_offsets[i] += edge_rowid_offsets[i - 1];
+	}
+	edge_rowid_positions.resize(edge_ids.size());
+	auto fill = edge_rowid_offsets;
+	for (idx_t offset = 0; offset < edge_ids.size(); offset++) {
+		edge_rowid_positions[fill[edge_ids[offset]]++] = static_cast<int64_t>(offset);
+	}
+}
+
+void CSR::PermuteEdges(const vector<int64_t> &source) {
+	GatherVector(e, source);
+	GatherVector(edge_ids, source);
+	GatherVector(w, source);
+	GatherVector(w_double, source);
+	GatherVector(edge_labels, source);
+	GatherVector(edge_times, source);
+	GatherEdgeProperties(source);
+	ClearHubRows();
+	ResetTranspose();
+}
+
+void CSR::BuildTemporalIndex(const string &property) {
+	if (!initialized_e) {
+		throw ConstraintException("Need to initialize CSR before building a temporal index");
+	}
+	CSRWriteGuard guard(access_lock);
+	CompactLocked();
+	BuildTemporalIndexLocked(property);
+}
+
+void CSR::BuildTemporalIndexLocked(const string &property) {
+	auto &times_property = GetEdgeProperty(property);
+	if (!times_property.IsIntegral()) {
+		throw InvalidInputException("Edge property %s of type %s cannot be used as edge time", property,
+		                            times_property.type.ToString());
+	}
+	vector<int64_t> times(e.size());
+	for (idx_t offset = 0; offset < e.size(); offset++) {
+		if (!times_property.TryGetInteger(offset, times[offset])) {
+			times[offset] = CSR_NO_EDGE_TIME;
+		}
+	}
+	vector<int64_t> source(e.size());
+	std::iota(source.begin(), source.end(), 0);
+	auto offsets = reinterpret_cast<int64_t *>(v);
+	for (int64_t vertex = 0; vertex < VertexCount(); vertex++) {
+		std::stable_sort(source.begin() + offsets[vertex], source.begin() + offsets[vertex + 1],
+		                 [&](int64_t a, int64_t b) { return times[a] < times[b]; });
+	}
+	edge_times = std::move(times);
+	PermuteEdges(source);
+	initialized_times = true;
+	time_property = property;
+}
+
+void CSR::GatherEdgeProperties(const vector<int64_t> &source) {
+	// edges moved, the rowid index is rebuilt on the next load
+	edge_rowid_offsets.clear();
+	edge_rowid_positions.clear();
+	for (auto &property : edge_properties) {
+		property.second->Gather(source);
+	}
+}
+
+void CSR::SetEdgeProperty(const string &name, Vector &edge_rowids, Vector &values, idx_t count, bool *found) {
+	if (!initialized_e) {
+		throw ConstraintException("Need to initialize CSR before attaching edge properties");
+	}
+	// kernels read the property columns while they traverse
+	CSRWriteGuard guard(access_lock);
+	auto &property = edge_properties[name];
+	if (!property) {
+		property = make_uniq<CSREdgeProperty>(values.GetType(), e.size());
+	} else if (property->type != values.GetType()) {
+		throw InvalidInputException("Edge property %s has type %s, got values of type %s", name,
+		                            property->type.ToString(), values.GetType().ToString());
+	}
+	if (edge_rowid_offsets.empty()) {
+		BuildEdgeRowidIndex();
+	}
+
+	UnifiedVectorFormat rowid_format;
+	UnifiedVectorFormat value_format;
+	edge_rowids.ToUnifiedFormat(count, rowid_format);
+	values.ToUnifiedFormat(count, value_format);
+	auto rowid_data = UnifiedVectorFormat::GetData<int64_t>(rowid_format);
+	for (idx_t row = 0; row < count; row++) {
+		found[row] = false;
+		auto rowid_idx = rowid_format.sel->get_index(row);
+		if (!rowid_format.validity.RowIsValid(rowid_idx)) {
+			continue;
+		}
+		auto rowid = rowid_data[rowid_idx];
+		if (rowid < 0 || rowid + 1 >= static_cast<int64_t>(edge_rowid_offsets.size()) ||
+		    edge_rowid_offsets[rowid] == edge_rowid_offsets[rowid + 1]) {
+			continue;
+		}
+		auto value_idx = value_format.sel->get_index(row);
+		for (auto i = edge_rowid_offsets[rowid]; i < edge_rowid_offsets[rowid + 1]; i++) {
+			property->SetValue(edge_rowid_positions[i], value_format, value_idx);
+		}
+		found[row] = true;
+	}
+}
+
+const CSREdgeProperty &CSR::GetEdgeProperty(const string &name) const {
+	auto entry = edge_properties.find(name);
+	if (entry == edge_properties.end()) {
+		throw ConstraintException("Edge property %s is not attached to the CSR, load it with csr_edge_property", name);
+	}
+	return *entry->second;
+}
+
 CSRFunctionData::CSRFunctionData(ClientContext &context, int32_t id, const LogicalType &weight_type)
     : context(context), id(id), weight_type(weight_type) {
 }
@@ -105,56 +622,21 @@ unique_ptr<FunctionData> CSRFunctionData::CSRBind(ClientContext &context, Scalar
 	return make_uniq<CSRFunctionData>(context, id.GetValue<int32_t>(), LogicalType::BOOLEAN);
 }
 
-// Helper function to create a JoinRef
-unique_ptr<JoinRef> CreateJoin(const string &fk_column, const string &pk_column,
-                               const shared_ptr<PropertyGraphTable> &fk_table,
-                               const shared_ptr<PropertyGraphTable> &pk_table) {
-	auto join = make_uniq<JoinRef>(JoinRefType::REGULAR);
-	join->left = fk_table->CreateBaseTableRef();
-	join->right = pk_table->CreateBaseTableRef();
-	join->condition = make_uniq<ComparisonExpression>(ExpressionType::COMPARE_EQUAL,
-	                                                  make_uniq<ColumnRefExpression>(fk_column, fk_table->table_name),
-	                                                  make_uniq<ColumnRefExpression>(pk_column, pk_table->table_name));
-	return join;
-}
-
-// Helper function to setup SelectNode
-void SetupSelectNode(unique_ptr<SelectNode> &select_node, const shared_ptr<PropertyGraphTable> &edge_table,
-                     bool reverse) {
-	select_node = make_uniq<SelectNode>();
-
-	select_node->select_list.emplace_back(CreateColumnRefExpression("rowid", edge_table->source_reference, "dense_id"));
-
-	if (!reverse) {
-		select_node->select_list.emplace_back(
-		    CreateColumnRefExpression(edge_table->source_fk[0], edge_table->table_name, "outgoing_edges"));
-		select_node->select_list.emplace_back(
-		    CreateColumnRefExpression(edge_table->destination_fk[0], edge_table->table_name, "incoming_edges"));
-		select_node->from_table =
-		    CreateJoin(edge_table->source_fk[0], edge_table->source_pk[0], edge_table, edge_table->source_pg_table);
-	} else {
-		select_node->select_list.emplace_back(
-		    CreateColumnRefExpression(edge_table->destination_fk[0], edge_table->table_name, "outgoing_edges"));
-		select_node->select_list.emplace_back(
-		    CreateColumnRefExpression(edge_table->source_fk[0], edge_table->table_name, "incoming_edges"));
-		select_node->from_table = CreateJoin(edge_table->destination_fk[0], edge_table->source_pk[0], edge_table,
-		                                     edge_table->source_pg_table);
-	}
-}
-
-// Function to create a subquery expression for counting table entries
-unique_ptr<SubqueryExpression> GetCountTable(const shared_ptr<PropertyGraphTable> &table, const string &table_alias,
-                                             const string &primary_key) {
+// Function to create a subquery expression for the rowid range of a table: SELECT coalesce(max(rowid) + 1, 0)
+static unique_ptr<SubqueryExpression> GetRowidRangeTable(const shared_ptr<PropertyGraphTable> &table) {
 	auto select_count = make_uniq<SelectStatement>();
 	auto select_inner = make_uniq<SelectNode>();
-	auto ref = table->CreateBaseTableRef(table_alias);
-	select_inner->from_table = std::move(ref);
-
-	vector<unique_ptr<ParsedExpression>> children;
-	children.push_back(make_uniq<ColumnRefExpression>(primary_key, table_alias));
-
-	auto count_function = make_uniq<FunctionExpression>("count", std::move(children));
-	select_inner->select_list.push_back(std::move(count_function));
+	select_inner->from_table = table->CreateBaseTableRef();
+
+	vector<unique_ptr<ParsedExpression>> max_children;
+	max_children.push_back(make_uniq<ColumnRefExpression>("rowid"));
+	vector<unique_ptr<ParsedExpression>> add_children;
+	add_children.push_back(make_uniq<FunctionExpression>("max", std::move(max_children)));
+	add_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(1)));
+	vector<unique_ptr<ParsedExpression>> coalesce_children;
+	coalesce_children.push_back(make_uniq<FunctionExpression>("add", std::move(add_children)));
+	coalesce_children.push_back(make_uniq<ConstantExpression>(Value::BIGINT(0)));
+	select_inner->select_list.push_back(make_uniq<FunctionExpression>("coalesce", std::move(coalesce_children)));
 	select_count->node = std::move(select_inner);
 
 	auto result = make_uniq<SubqueryExpression>();
@@ -163,6 +645,64 @@ unique_ptr<SubqueryExpression> GetCountTable(const shared_ptr<PropertyGraphTable
 	return result;
 }
 
+// The vertex count of a CSR numbered by rowid. Deleted rows leave gaps in the rowids, so the count of the vertex
+// table can be smaller than the largest id, the range up to the largest rowid is used instead.
+unique_ptr<ParsedExpression> GetRowidRange(const shared_ptr<PropertyGraphTable> &edge_table) {
+	if (edge_table->destination_pg_table->table_name == edge_table->source_pg_table->table_name) {
+		return GetRowidRangeTable(edge_table->source_pg_table);
+	}
+	vector<unique_ptr<ParsedExpression>> greatest_children;
+	greatest_children.push_back(GetRowidRangeTable(edge_table->source_pg_table));
+	greatest_children.push_back(GetRowidRangeTable(edge_table->destination_pg_table));
+	return make_uniq<FunctionExpression>("greatest", std::move(greatest_children));
+}
+
+// CASE WHEN (SELECT count(key) = count(DISTINCT key) FROM table) THEN value ELSE error(...) END. Duplicate keys
+// would join one edge to several rowids.
+static unique_ptr<ParsedExpression> CheckUniqueVertexKeys(const shared_ptr<PropertyGraphTable> &table,
+                                                          const vector<string> &key_columns,
+                                                          unique_ptr<ParsedExpression> value) {
+	auto key = [&]() -> unique_ptr<ParsedExpression> {
+		if (key_columns.size() == 1) {
+			return make_uniq<ColumnRefExpression>(key_columns[0]);
+		}
+		vector<unique_ptr<ParsedExpression>> row_children;
+		for (auto &column : key_columns) {
+			row_children.push_back(make_uniq<ColumnRefExpression>(column));
+		}
+		return make_uniq<FunctionExpression>("row", std::move(row_children));
+	};
+	vector<unique_ptr<ParsedExpression>> count_children;
+	count_children.push_back(key());
+	vector<unique_ptr<ParsedExpression>> distinct_children;
+	distinct_children.push_back(key());
+	auto count_distinct = make_uniq<FunctionExpression>("count", std::move(distinct_children));
+	count_distinct->distinct = true;
+
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(make_uniq<ComparisonExpression>(
+	    ExpressionType::COMPARE_EQUAL, make_uniq<FunctionExpression>("count", std::move(count_children)),
+	    std::move(count_distinct)));
+	select_node->from_table = table->CreateBaseTableRef();
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	auto unique_keys = make_uniq<SubqueryExpression>();
+	unique_keys->subquery = std::move(select_statement);
+	unique_keys->subquery_type = SubqueryType::SCALAR;
+
+	vector<unique_ptr<ParsedExpression>> error_children;
+	error_children.push_back(make_uniq<ConstantExpression>(
+	    Value("Non-existent/non-unique vertices detected. Make sure all vertices referred by edge tables exist and "
+	          "are unique for path-finding queries.")));
+	auto case_expression = make_uniq<CaseExpression>();
+	CaseCheck check;
+	check.when_expr = std::move(unique_keys);
+	check.then_expr = std::move(value);
+	case_expression->case_checks.push_back(std::move(check));
+	case_expression->else_expr = make_uniq<FunctionExpression>("error", std::move(error_children));
+	return std::move(case_expression);
+}
+
 unique_ptr<JoinRef> GetJoinRef(const shared_ptr<PropertyGraphTable> &edge_table, const string &edge_binding,
                                const string &prev_binding, const string &next_binding) {
 	auto first_join_ref = make_uniq<JoinRef>(JoinRefType::REGULAR);
@@ -189,7 +729,7 @@ unique_ptr<JoinRef> GetJoinRef(const shared_ptr<PropertyGraphTable> &edge_table,
 
 unique_ptr<SubqueryExpression> CreateDirectedCSRVertexSubquery(const shared_ptr<PropertyGraphTable> &edge_table,
                                                                const string &prev_binding) {
-	auto count_create_vertex_expr = GetCountTable(edge_table->source_pg_table, prev_binding, edge_table->source_pk[0]);
+	auto count_create_vertex_expr = GetRowidRange(edge_table);
 
 	vector<unique_ptr<ParsedExpression>> csr_vertex_children;
 	csr_vertex_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
@@ -247,81 +787,31 @@ unique_ptr<SubqueryExpression> CreateDirectedCSRVertexSubquery(const shared_ptr<
 	return cast_subquery_expr;
 }
 
-// Helper function to create CSR Vertex Subquery
-unique_ptr<SubqueryExpression> CreateUndirectedCSRVertexSubquery(const shared_ptr<PropertyGraphTable> &edge_table,
-                                                                 const string &binding) {
-	auto count_create_vertex_expr = GetCountTable(edge_table->source_pg_table, binding, edge_table->source_pk[0]);
-
+// Helper function to create the degree pass of the symmetric CSR build, counting both endpoints of every edge
+unique_ptr<SubqueryExpression> CreateSymmetricCSRVertexSubquery(unique_ptr<ParsedExpression> vertex_count) {
 	vector<unique_ptr<ParsedExpression>> csr_vertex_children;
 	csr_vertex_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
-	csr_vertex_children.push_back(std::move(count_create_vertex_expr));
-	csr_vertex_children.push_back(make_uniq<ColumnRefExpression>("dense_id", "sub"));
-	csr_vertex_children.push_back(make_uniq<ColumnRefExpression>("cnt", "sub"));
+	csr_vertex_children.push_back(std::move(vertex_count));
+	csr_vertex_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	csr_vertex_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	auto create_vertex_function =
+	    make_uniq<FunctionExpression>("create_csr_vertex_symmetric", std::move(csr_vertex_children));
 
-	auto create_vertex_function = make_uniq<FunctionExpression>("create_csr_vertex", std::move(csr_vertex_children));
 	vector<unique_ptr<ParsedExpression>> sum_children;
 	sum_children.push_back(std::move(create_vertex_function));
 	auto sum_function = make_uniq<FunctionExpression>("sum", std::move(sum_children));
 
-	vector<unique_ptr<ParsedExpression>> multiply_csr_vertex_children;
-	auto two_constant = make_uniq<ConstantExpression>(Value::INTEGER(2));
-	multiply_csr_vertex_children.push_back(std::move(two_constant));
-	multiply_csr_vertex_children.push_back(std::move(sum_function));
-
-	auto multiply_function = make_uniq<FunctionExpression>("multiply", std::move(multiply_csr_vertex_children));
-
-	auto inner_select_statement = make_uniq<SelectStatement>();
-	auto inner_select_node = make_uniq<SelectNode>();
-
-	auto dense_id_ref = make_uniq<ColumnRefExpression>("dense_id");
-
-	auto count_create_inner_expr = make_uniq<SubqueryExpression>();
-	count_create_inner_expr->subquery_type = SubqueryType::SCALAR;
-	auto outgoing_edges_ref = make_uniq<ColumnRefExpression>("outgoing_edges");
-	vector<unique_ptr<ParsedExpression>> inner_count_children;
-	inner_count_children.push_back(std::move(outgoing_edges_ref));
-	auto inner_count_function = make_uniq<FunctionExpression>("count", std::move(inner_count_children));
-	inner_count_function->alias = "cnt";
-
-	inner_select_node->select_list.push_back(std::move(dense_id_ref));
-	inner_select_node->select_list.push_back(std::move(inner_count_function));
-
-	auto dense_id_colref = make_uniq<ColumnRefExpression>("dense_id");
-	inner_select_node->groups.group_expressions.push_back(std::move(dense_id_colref));
-	GroupingSet grouping_set = {0};
-	inner_select_node->groups.grouping_sets.push_back(grouping_set);
-
-	unique_ptr<SelectNode> unique_edges_select_node, unique_edges_select_node_reverse;
-
-	SetupSelectNode(unique_edges_select_node, edge_table, false);
-	SetupSelectNode(unique_edges_select_node_reverse, edge_table, true);
-
-	auto union_all_node = make_uniq<SetOperationNode>();
-	union_all_node->setop_type = SetOperationType::UNION_BY_NAME;
-	union_all_node->children.push_back(std::move(unique_edges_select_node));
-	union_all_node->children.push_back(std::move(unique_edges_select_node_reverse));
-
-	auto subquery_select_statement = make_uniq<SelectStatement>();
-	subquery_select_statement->node = std::move(union_all_node);
-	auto unique_edges_subquery = make_uniq<SubqueryRef>(std::move(subquery_select_statement), "unique_edges");
-
-	inner_select_node->from_table = std::move(unique_edges_subquery);
-	inner_select_statement->node = std::move(inner_select_node);
-
-	auto inner_from_subquery = make_uniq<SubqueryRef>(std::move(inner_select_statement), "sub");
-
-	auto cast_select_node = make_uniq<SelectNode>();
-	cast_select_node->from_table = std::move(inner_from_subquery);
-	cast_select_node->select_list.push_back(std::move(multiply_function));
-
-	auto cast_select_stmt = make_uniq<SelectStatement>();
-	cast_select_stmt->node = std::move(cast_select_node);
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(std::move(sum_function));
+	select_node->from_table = CreateBaseTableRef("undirected_edges_cte");
 
-	auto cast_subquery_expr = make_uniq<SubqueryExpression>();
-	cast_subquery_expr->subquery = std::move(cast_select_stmt);
-	cast_subquery_expr->subquery_type = SubqueryType::SCALAR;
+	auto select_stmt = make_uniq<SelectStatement>();
+	select_stmt->node = std::move(select_node);
 
-	return cast_subquery_expr;
+	auto result = make_uniq<SubqueryExpression>();
+	result->subquery = std::move(select_stmt);
+	result->subquery_type = SubqueryType::SCALAR;
+	return result;
 }
 
 // Helper function to create outer select edges node
@@ -402,68 +892,59 @@ unique_ptr<CommonTableExpressionInfo> MakeEdgesCTE(const shared_ptr<PropertyGrap
 	return result;
 }
 
-// Function to create the CTE for the Undirected CSR
-unique_ptr<CommonTableExpressionInfo> CreateUndirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
-                                                             const unique_ptr<SelectNode> &select_node) {
-	if (select_node->cte_map.map.find("edges_cte") == select_node->cte_map.map.end()) {
-		select_node->cte_map.map["edges_cte"] = MakeEdgesCTE(edge_table);
-	}
-
-	auto csr_edge_id_constant = make_uniq<ConstantExpression>(Value::INTEGER(0));
-	auto count_create_edge_select =
-	    GetCountTable(edge_table->source_pg_table, edge_table->source_reference, edge_table->source_pk[0]);
+// Function to create the CTE holding every undirected edge once, as (src, dst, edge)
+unique_ptr<CommonTableExpressionInfo> MakeUndirectedEdgesCTE() {
+	auto inner_select_node = make_uniq<SelectNode>();
+	inner_select_node->from_table = CreateBaseTableRef("edges_cte");
+
+	// Normalise every edge to (least, greatest) so reciprocal pairs and parallel edges collapse into one
+	vector<unique_ptr<ParsedExpression>> least_children;
+	least_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	least_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	auto least_function = make_uniq<FunctionExpression>("least", std::move(least_children));
+	least_function->alias = "src";
+	vector<unique_ptr<ParsedExpression>> greatest_children;
+	greatest_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	greatest_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	auto greatest_function = make_uniq<FunctionExpression>("greatest", std::move(greatest_children));
+	greatest_function->alias = "dst";
+	inner_select_node->select_list.push_back(std::move(least_function));
+	inner_select_node->select_list.push_back(std::move(greatest_function));
+	inner_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("edges"));
 
-	auto count_edges_subquery = GetCountUndirectedEdgeTable();
+	auto inner_select_statement = make_uniq<SelectStatement>();
+	inner_select_statement->node = std::move(inner_select_node);
 
-	auto cast_subquery_expr = CreateUndirectedCSRVertexSubquery(edge_table, edge_table->source_reference);
+	auto select_node = CreateOuterSelectEdgesNode();
+	select_node->from_table = make_uniq<SubqueryRef>(std::move(inner_select_statement));
 
-	auto src_rowid_colref = make_uniq<ColumnRefExpression>("src");
-	auto dst_rowid_colref = make_uniq<ColumnRefExpression>("dst");
-	auto edge_rowid_colref = make_uniq<ColumnRefExpression>("edge");
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	auto result = make_uniq<CommonTableExpressionInfo>();
+	result->query = std::move(select_statement);
+	return result;
+}
 
+// Function to create the CSR CTE over undirected_edges_cte
+// Both directions are emitted natively by create_csr_vertex_symmetric / create_csr_edge_symmetric from a single
+// stream of undirected edges, instead of unioning the forward and reverse edge streams in SQL.
+static unique_ptr<CommonTableExpressionInfo> CreateSymmetricCSRCTE(unique_ptr<ParsedExpression> vertex_count) {
+	auto csr_edge_id_constant = make_uniq<ConstantExpression>(Value::INTEGER(0));
+	auto cast_subquery_expr = CreateSymmetricCSRVertexSubquery(vertex_count->Copy());
 	auto cast_expression = make_uniq<CastExpression>(LogicalType::BIGINT, std::move(cast_subquery_expr));
 
 	vector<unique_ptr<ParsedExpression>> csr_edge_children;
 	csr_edge_children.push_back(std::move(csr_edge_id_constant));
-	csr_edge_children.push_back(std::move(count_create_edge_select));
+	csr_edge_children.push_back(std::move(vertex_count));
 	csr_edge_children.push_back(std::move(cast_expression));
-	csr_edge_children.push_back(std::move(count_edges_subquery));
-	csr_edge_children.push_back(std::move(src_rowid_colref));
-	csr_edge_children.push_back(std::move(dst_rowid_colref));
-	csr_edge_children.push_back(std::move(edge_rowid_colref));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("edge"));
 
-	auto create_csr_edge_function = make_uniq<FunctionExpression>("create_csr_edge", std::move(csr_edge_children));
+	auto create_csr_edge_function =
+	    make_uniq<FunctionExpression>("create_csr_edge_symmetric", std::move(csr_edge_children));
 	auto outer_select_node = CreateOuterSelectNode(std::move(create_csr_edge_function));
-
-	auto outer_select_edges_node = CreateOuterSelectEdgesNode();
-
-	auto outer_union_all_node = make_uniq<SetOperationNode>();
-	outer_union_all_node->setop_all = true;
-	outer_union_all_node->setop_type = SetOperationType::UNION;
-
-	auto src_dst_select_node = make_uniq<SelectNode>();
-
-	src_dst_select_node->from_table = std::move(CreateBaseTableRef("edges_cte"));
-	src_dst_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("src"));
-	src_dst_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("dst"));
-	src_dst_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("edges"));
-
-	auto dst_src_select_node = make_uniq<SelectNode>();
-	dst_src_select_node->from_table = std::move(CreateBaseTableRef("edges_cte"));
-	dst_src_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("dst"));
-	dst_src_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("src"));
-	dst_src_select_node->select_list.push_back(make_uniq<ColumnRefExpression>("edges"));
-
-	outer_union_all_node->children.push_back(std::move(src_dst_select_node));
-	outer_union_all_node->children.push_back(std::move(dst_src_select_node));
-
-	auto outer_union_select_statement = make_uniq<SelectStatement>();
-	outer_union_select_statement->node = std::move(outer_union_all_node);
-	outer_select_edges_node->from_table = make_uniq<SubqueryRef>(std::move(outer_union_select_statement));
-
-	auto outer_select_edges_select_statement = make_uniq<SelectStatement>();
-	outer_select_edges_select_statement->node = std::move(outer_select_edges_node);
-	outer_select_node->from_table = make_uniq<SubqueryRef>(std::move(outer_select_edges_select_statement));
+	outer_select_node->from_table = CreateBaseTableRef("undirected_edges_cte");
 
 	auto outer_select_statement = make_uniq<SelectStatement>();
 	outer_select_statement->node = std::move(outer_select_node);
@@ -472,44 +953,45 @@ unique_ptr<CommonTableExpressionInfo> CreateUndirectedCSRCTE(const shared_ptr<Pr
 	return info;
 }
 
-unique_ptr<SubqueryExpression> GetCountUndirectedEdgeTable() {
-	auto count_edges_select_statement = make_uniq<SelectStatement>();
-	auto count_edges_select_node = make_uniq<SelectNode>();
-	vector<unique_ptr<ParsedExpression>> count_children;
-	auto count_function = make_uniq<FunctionExpression>("count", std::move(count_children));
-	vector<unique_ptr<ParsedExpression>> multiply_children;
-	auto constant_two = make_uniq<ConstantExpression>(Value::BIGINT(2));
-	multiply_children.push_back(std::move(constant_two));
-	multiply_children.push_back(std::move(count_function));
-	auto multiply_function = make_uniq<FunctionExpression>("multiply", std::move(multiply_children));
-	count_edges_select_node->select_list.emplace_back(std::move(multiply_function));
-
-	auto inner_select_statement = make_uniq<SelectStatement>();
+// Function to create the CTE for the Undirected CSR
+unique_ptr<CommonTableExpressionInfo> CreateUndirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
+                                                             const unique_ptr<SelectNode> &select_node) {
+	if (select_node->cte_map.map.find("edges_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["edges_cte"] = MakeEdgesCTE(edge_table);
+	}
+	if (select_node->cte_map.map.find("undirected_edges_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["undirected_edges_cte"] = MakeUndirectedEdgesCTE();
+	}
+	// the edges are joined to their endpoints by key, so the keys have to be unique
+	auto vertex_count = CheckUniqueVertexKeys(edge_table->source_pg_table, edge_table->source_pk,
+	                                          GetRowidRange(edge_table));
+	if (edge_table->destination_pg_table->table_name != edge_table->source_pg_table->table_name ||
+	    edge_table->destination_pk != edge_table->source_pk) {
+		vertex_count = CheckUniqueVertexKeys(edge_table->destination_pg_table, edge_table->destination_pk,
+		                                     std::move(vertex_count));
+	}
+	return CreateSymmetricCSRCTE(std::move(vertex_count));
+}
 
-	auto src_dst_select_node = make_uniq<SelectNode>();
-	src_dst_select_node->select_list.emplace_back(CreateColumnRefExpression("src"));
-	src_dst_select_node->select_list.emplace_back(CreateColumnRefExpression("dst"));
-
-	src_dst_select_node->from_table = std::move(CreateBaseTableRef("edges_cte"));
-
-	auto dst_src_select_node = make_uniq<SelectNode>();
-	dst_src_select_node->select_list.emplace_back(CreateColumnRefExpression("dst", "", "src"));
-	dst_src_select_node->select_list.emplace_back(CreateColumnRefExpression("src", "", "dst"));
-	dst_src_select_node->from_table = CreateBaseTableRef("edges_cte");
-
-	auto union_by_name_node = make_uniq<SetOperationNode>();
-	union_by_name_node->setop_all = false;
-	union_by_name_node->setop_type = SetOperationType::UNION_BY_NAME;
-	union_by_name_node->children.push_back(std::move(src_dst_select_node));
-	union_by_name_node->children.push_back(std::move(dst_src_select_node));
-	inner_select_statement->node = std::move(union_by_name_node);
-	auto inner_from_subquery = make_uniq<SubqueryRef>(std::move(inner_select_statement));
-	count_edges_select_node->from_table = std::move(inner_from_subquery);
-	count_edges_select_statement->node = std::move(count_edges_select_node);
-	auto result = make_uniq<SubqueryExpression>();
-	result->subquery = std::move(count_edges_select_statement);
-	result->subquery_type = SubqueryType::SCALAR;
-	return result;
+// Function to create the CTE for the Undirected CSR over the dense ids of vertex dictionaries
+unique_ptr<CommonTableExpressionInfo> CreateDenseUndirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
+                                                                  const unique_ptr<SelectNode> &select_node) {
+	idx_t destination_index;
+	auto vertex_tables = GetEdgeVertexTables(edge_table, 0, destination_index);
+	if (select_node->cte_map.map.find("vertex_dictionary_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["vertex_dictionary_cte"] = MakeVertexDictionaryCTE(vertex_tables);
+	}
+	if (select_node->cte_map.map.find("edges_cte") == select_node->cte_map.map.end()) {
+		auto edges_statement = make_uniq<SelectStatement>();
+		edges_statement->node = CreateDenseEdgesNode(edge_table, vertex_tables, 0, destination_index);
+		auto edges_cte = make_uniq<CommonTableExpressionInfo>();
+		edges_cte->query = std::move(edges_statement);
+		select_node->cte_map.map["edges_cte"] = std::move(edges_cte);
+	}
+	if (select_node->cte_map.map.find("undirected_edges_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["undirected_edges_cte"] = MakeUndirectedEdgesCTE();
+	}
+	return CreateSymmetricCSRCTE(GetDenseVertexCount(vertex_tables));
 }
 
 unique_ptr<SubqueryExpression> GetCountEdgeTable(const shared_ptr<PropertyGraphTable> &edge_table) {
@@ -543,9 +1025,9 @@ unique_ptr<SubqueryExpression> GetCountEdgeTable(const shared_ptr<PropertyGraphT
 // Function to create the CTE for the Directed CSR
 unique_ptr<CommonTableExpressionInfo> CreateDirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
                                                            const string &prev_binding, const string &edge_binding,
-                                                           const string &next_binding) {
+                                                           const string &next_binding, const string &weight_column) {
 	auto csr_edge_id_constant = make_uniq<ConstantExpression>(Value::INTEGER(0));
-	auto count_create_edge_select = GetCountTable(edge_table->source_pg_table, prev_binding, edge_table->source_pk[0]);
+	auto count_create_edge_select = GetRowidRange(edge_table);
 
 	auto cast_subquery_expr = CreateDirectedCSRVertexSubquery(edge_table, prev_binding);
 	auto count_edge_table = GetCountEdgeTable(edge_table); // Count the number of edges
@@ -564,6 +1046,10 @@ unique_ptr<CommonTableExpressionInfo> CreateDirectedCSRCTE(const shared_ptr<Prop
 	csr_edge_children.push_back(std::move(src_rowid_colref));
 	csr_edge_children.push_back(std::move(dst_rowid_colref));
 	csr_edge_children.push_back(std::move(edge_rowid_colref));
+	if (!weight_column.empty()) {
+		csr_edge_children.push_back(make_uniq<CastExpression>(
+		    LogicalType::DOUBLE, make_uniq<ColumnRefExpression>(weight_column, edge_binding)));
+	}
 
 	auto create_csr_edge_function = make_uniq<FunctionExpression>("create_csr_edge", std::move(csr_edge_children));
 	auto outer_select_node = CreateOuterSelectNode(std::move(create_csr_edge_function));
@@ -578,6 +1064,404 @@ unique_ptr<CommonTableExpressionInfo> CreateDirectedCSRCTE(const shared_ptr<Prop
 	return info;
 }
 
+// Function to create the CTE for the Directed CSR over the dense ids of vertex dictionaries
+unique_ptr<CommonTableExpressionInfo> CreateDenseDirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
+                                                                const unique_ptr<SelectNode> &select_node,
+                                                                const string &weight_column) {
+	idx_t destination_index;
+	auto vertex_tables = GetEdgeVertexTables(edge_table, 0, destination_index);
+	if (select_node->cte_map.map.find("vertex_dictionary_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["vertex_dictionary_cte"] = MakeVertexDictionaryCTE(vertex_tables);
+	}
+
+	// WITH dense_edges_cte AS (SELECT src, dst, edges[, weight] FROM edge, vertex_dictionary_cte)
+	// SELECT create_csr_edge(0, V, (degree pass), (edge count), src, dst, edges[, weight]) FROM dense_edges_cte
+	auto edges_statement = make_uniq<SelectStatement>();
+	edges_statement->node = CreateDenseEdgesNode(edge_table, vertex_tables, 0, destination_index, weight_column);
+	auto edges_cte = make_uniq<CommonTableExpressionInfo>();
+	edges_cte->query = std::move(edges_statement);
+
+	auto vertex_count = GetDenseVertexCount(vertex_tables);
+	auto degree_subquery = CreateDenseCSRVertexSubquery(0, vertex_count->Copy(), "dense_edges_cte");
+
+	vector<unique_ptr<ParsedExpression>> csr_edge_children;
+	csr_edge_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
+	csr_edge_children.push_back(std::move(vertex_count));
+	csr_edge_children.push_back(make_uniq<CastExpression>(LogicalType::BIGINT, std::move(degree_subquery)));
+	csr_edge_children.push_back(GetCountDenseEdges("dense_edges_cte"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("edges"));
+	if (!weight_column.empty()) {
+		csr_edge_children.push_back(make_uniq<ColumnRefExpression>("weight"));
+	}
+
+	auto create_csr_edge_function = make_uniq<FunctionExpression>("create_csr_edge", std::move(csr_edge_children));
+	auto outer_select_node = CreateOuterSelectNode(std::move(create_csr_edge_function));
+	outer_select_node->from_table = CreateBaseTableRef("dense_edges_cte");
+	outer_select_node->cte_map.map["dense_edges_cte"] = std::move(edges_cte);
+
+	auto outer_select_statement = make_uniq<SelectStatement>();
+	outer_select_statement->node = std::move(outer_select_node);
+	auto info = make_uniq<CommonTableExpressionInfo>();
+	info->query = std::move(outer_select_statement);
+	return info;
+}
+
+// Function to create a subquery counting all rows of a table
+unique_ptr<SubqueryExpression> GetCountStarTable(const shared_ptr<PropertyGraphTable> &table) {
+	auto select_node = make_uniq<SelectNode>();
+	vector<unique_ptr<ParsedExpression>> children;
+	select_node->select_list.push_back(make_uniq<FunctionExpression>("count_star", std::move(children)));
+	select_node->from_table = table->CreateBaseTableRef();
+
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	auto result = make_uniq<SubqueryExpression>();
+	result->subquery = std::move(select_statement);
+	result->subquery_type = SubqueryType::SCALAR;
+	return result;
+}
+
+int32_t GetVertexDictionaryId(int32_t csr_id, idx_t vertex_table_index) {
+	if (vertex_table_index >= CSR_MAX_VERTEX_TABLES) {
+		throw ConstraintException("A CSR can number the vertices of at most %d vertex tables", CSR_MAX_VERTEX_TABLES);
+	}
+	if (csr_id < 0 || csr_id > (NumericLimits<int32_t>::Maximum() - 1) / CSR_MAX_VERTEX_TABLES - 1) {
+		throw ConstraintException("CSR ID %d has no vertex dictionary ids, use an ID between 0 and %d", csr_id,
+		                          (NumericLimits<int32_t>::Maximum() - 1) / CSR_MAX_VERTEX_TABLES - 1);
+	}
+	return -1 - static_cast<int32_t>(csr_id * CSR_MAX_VERTEX_TABLES + static_cast<int32_t>(vertex_table_index));
+}
+
+int32_t GetVertexDictionaryCSRId(int32_t dictionary_id) {
+	if (dictionary_id >= 0) {
+		return -1;
+	}
+	return (-1 - dictionary_id) / CSR_MAX_VERTEX_TABLES;
+}
+
+unique_ptr<ParsedExpression> GetDenseVertexId(int32_t dictionary_id, const vector<string> &key_columns,
+                                              const string &binding) {
+	vector<unique_ptr<ParsedExpression>> lookup_children;
+	lookup_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(dictionary_id)));
+	for (auto &column : key_columns) {
+		lookup_children.push_back(make_uniq<ColumnRefExpression>(column, binding));
+	}
+	return make_uniq<FunctionExpression>("vertex_dictionary_lookup", std::move(lookup_children));
+}
+
+vector<CSRVertexTable> GetEdgeVertexTables(const shared_ptr<PropertyGraphTable> &edge_table, int32_t csr_id,
+                                           idx_t &destination_index) {
+	vector<CSRVertexTable> result;
+	result.push_back(CSRVertexTable {edge_table->source_pg_table, edge_table->source_pk,
+	                                 GetVertexDictionaryId(csr_id, 0)});
+	destination_index = 0;
+	if (edge_table->destination_pg_table->table_name != edge_table->source_pg_table->table_name ||
+	    edge_table->destination_pk != edge_table->source_pk) {
+		result.push_back(CSRVertexTable {edge_table->destination_pg_table, edge_table->destination_pk,
+		                                 GetVertexDictionaryId(csr_id, 1)});
+		destination_index = 1;
+	}
+	return result;
+}
+
+static string GetVertexCountColumn(idx_t vertex_table_index) {
+	return "vertex_count_" + std::to_string(vertex_table_index);
+}
+
+// Function to create the CTE filling the vertex dictionaries, one column with the inserted key count per table. The
+// dictionaries keep the rowid of every key, so component labels can name rows. It is materialized, so every query
+// that scans it runs after all keys are in the dictionaries.
+unique_ptr<CommonTableExpressionInfo> MakeVertexDictionaryCTE(const vector<CSRVertexTable> &vertex_tables) {
+	auto select_node = make_uniq<SelectNode>();
+	for (idx_t i = 0; i < vertex_tables.size(); i++) {
+		auto &vertex_table = vertex_tables[i];
+		vector<unique_ptr<ParsedExpression>> create_children;
+		create_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(vertex_table.dictionary_id)));
+		create_children.push_back(make_uniq<ColumnRefExpression>("rowid"));
+		for (auto &column : vertex_table.key_columns) {
+			create_children.push_back(make_uniq<ColumnRefExpression>(column));
+		}
+		vector<unique_ptr<ParsedExpression>> count_children;
+		count_children.push_back(
+		    make_uniq<FunctionExpression>("create_vertex_dictionary_with_rowid", std::move(create_children)));
+
+		auto count_node = make_uniq<SelectNode>();
+		count_node->select_list.push_back(make_uniq<FunctionExpression>("count", std::move(count_children)));
+		count_node->from_table = vertex_table.table->CreateBaseTableRef();
+		auto count_statement = make_uniq<SelectStatement>();
+		count_statement->node = std::move(count_node);
+		auto count_subquery = make_uniq<SubqueryExpression>();
+		count_subquery->subquery = std::move(count_statement);
+		count_subquery->subquery_type = SubqueryType::SCALAR;
+		count_subquery->alias = GetVertexCountColumn(i);
+		select_node->select_list.push_back(std::move(count_subquery));
+	}
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	auto result = make_uniq<CommonTableExpressionInfo>();
+	result->query = std::move(select_statement);
+	result->materialized = CTEMaterialize::CTE_MATERIALIZE_ALWAYS;
+	return result;
+}
+
+unique_ptr<ParsedExpression> GetDenseVertexCount(const CSRVertexTable &vertex_table, idx_t vertex_table_index) {
+	// SELECT vertex_dictionary_size(id, vertex_count_i) FROM vertex_dictionary_cte
+	vector<unique_ptr<ParsedExpression>> size_children;
+	size_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(vertex_table.dictionary_id)));
+	size_children.push_back(make_uniq<ColumnRefExpression>(GetVertexCountColumn(vertex_table_index)));
+
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(
+	    make_uniq<FunctionExpression>("vertex_dictionary_size", std::move(size_children)));
+	select_node->from_table = CreateBaseTableRef("vertex_dictionary_cte");
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	auto result = make_uniq<SubqueryExpression>();
+	result->subquery = std::move(select_statement);
+	result->subquery_type = SubqueryType::SCALAR;
+	return std::move(result);
+}
+
+unique_ptr<ParsedExpression> GetDenseVertexCount(const vector<CSRVertexTable> &vertex_tables) {
+	if (vertex_tables.size() == 1) {
+		return GetDenseVertexCount(vertex_tables[0], 0);
+	}
+	// the source and destination ids of an edge between two tables share one range, like their rowids do
+	vector<unique_ptr<ParsedExpression>> greatest_children;
+	for (idx_t i = 0; i < vertex_tables.size(); i++) {
+		greatest_children.push_back(GetDenseVertexCount(vertex_tables[i], i));
+	}
+	return make_uniq<FunctionExpression>("greatest", std::move(greatest_children));
+}
+
+unique_ptr<SelectNode> CreateDenseEdgesNode(const shared_ptr<PropertyGraphTable> &edge_table,
+                                            const vector<CSRVertexTable> &vertex_tables, idx_t source_index,
+                                            idx_t destination_index, const string &weight_column,
+                                            unique_ptr<ParsedExpression> source_offset,
+                                            unique_ptr<ParsedExpression> destination_offset) {
+	auto &binding = edge_table->table_name_alias;
+	auto select_node = make_uniq<SelectNode>();
+	auto endpoint = [&](idx_t index, const vector<string> &foreign_key, unique_ptr<ParsedExpression> offset,
+	                    const string &alias) {
+		auto dense_id = GetDenseVertexId(vertex_tables[index].dictionary_id, foreign_key, binding);
+		if (offset) {
+			vector<unique_ptr<ParsedExpression>> add_children;
+			add_children.push_back(std::move(dense_id));
+			add_children.push_back(std::move(offset));
+			dense_id = make_uniq<FunctionExpression>("add", std::move(add_children));
+		}
+		dense_id->alias = alias;
+		select_node->select_list.push_back(std::move(dense_id));
+	};
+	endpoint(source_index, edge_table->source_fk, std::move(source_offset), "src");
+	endpoint(destination_index, edge_table->destination_fk, std::move(destination_offset), "dst");
+	select_node->select_list.emplace_back(CreateColumnRefExpression("rowid", binding, "edges"));
+	if (!weight_column.empty()) {
+		auto weight =
+		    make_uniq<CastExpression>(LogicalType::DOUBLE, make_uniq<ColumnRefExpression>(weight_column, binding));
+		weight->alias = "weight";
+		select_node->select_list.push_back(std::move(weight));
+	}
+
+	// the lookups run above the scan of the materialized dictionaries, so only once all keys are inserted
+	auto cross_join_ref = make_uniq<JoinRef>(JoinRefType::CROSS);
+	cross_join_ref->left = edge_table->CreateBaseTableRef(binding);
+	cross_join_ref->right = CreateBaseTableRef("vertex_dictionary_cte");
+	select_node->from_table = std::move(cross_join_ref);
+	return select_node;
+}
+
+//! count(src + dst): an edge whose source or destination key has no vertex has a NULL endpoint and is left out, like
+//! the inner join with the vertex tables leaves it out of the rowid builders. create_csr_edge skips its row.
+static unique_ptr<FunctionExpression> GetCountDenseEdgeRows() {
+	vector<unique_ptr<ParsedExpression>> add_children;
+	add_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	add_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	vector<unique_ptr<ParsedExpression>> count_children;
+	count_children.push_back(make_uniq<FunctionExpression>("add", std::move(add_children)));
+	return make_uniq<FunctionExpression>("count", std::move(count_children));
+}
+
+unique_ptr<SubqueryExpression> CreateDenseCSRVertexSubquery(int32_t csr_id, unique_ptr<ParsedExpression> vertex_count,
+                                                            const string &edges_cte) {
+	// SELECT sum(create_csr_vertex(id, V, sub.dense_id, sub.cnt))
+	// FROM (SELECT src AS dense_id, count(src + dst) AS cnt FROM edges_cte GROUP BY src) sub
+	auto degree_select_node = make_uniq<SelectNode>();
+	degree_select_node->select_list.emplace_back(CreateColumnRefExpression("src", "", "dense_id"));
+	auto degree_count_function = GetCountDenseEdgeRows();
+	degree_count_function->alias = "cnt";
+	degree_select_node->select_list.push_back(std::move(degree_count_function));
+	degree_select_node->from_table = CreateBaseTableRef(edges_cte);
+	degree_select_node->groups.group_expressions.push_back(make_uniq<ColumnRefExpression>("src"));
+	GroupingSet grouping_set = {0};
+	degree_select_node->groups.grouping_sets.push_back(grouping_set);
+	auto degree_select_statement = make_uniq<SelectStatement>();
+	degree_select_statement->node = std::move(degree_select_node);
+
+	vector<unique_ptr<ParsedExpression>> csr_vertex_children;
+	csr_vertex_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(csr_id)));
+	csr_vertex_children.push_back(std::move(vertex_count));
+	csr_vertex_children.push_back(make_uniq<ColumnRefExpression>("dense_id", "sub"));
+	csr_vertex_children.push_back(make_uniq<ColumnRefExpression>("cnt", "sub"));
+	vector<unique_ptr<ParsedExpression>> sum_children;
+	sum_children.push_back(make_uniq<FunctionExpression>("create_csr_vertex", std::move(csr_vertex_children)));
+
+	auto vertex_select_node = make_uniq<SelectNode>();
+	vertex_select_node->select_list.push_back(make_uniq<FunctionExpression>("sum", std::move(sum_children)));
+	vertex_select_node->from_table = make_uniq<SubqueryRef>(std::move(degree_select_statement), "sub");
+	auto vertex_select_statement = make_uniq<SelectStatement>();
+	vertex_select_statement->node = std::move(vertex_select_node);
+	auto result = make_uniq<SubqueryExpression>();
+	result->subquery = std::move(vertex_select_statement);
+	result->subquery_type = SubqueryType::SCALAR;
+	return result;
+}
+
+unique_ptr<SubqueryExpression> GetCountDenseEdges(const string &edges_cte) {
+	// SELECT count(src + dst) FROM edges_cte
+	auto select_node = make_uniq<SelectNode>();
+	select_node->select_list.push_back(GetCountDenseEdgeRows());
+	select_node->from_table = CreateBaseTableRef(edges_cte);
+	auto select_statement = make_uniq<SelectStatement>();
+	select_statement->node = std::move(select_node);
+	auto result = make_uniq<SubqueryExpression>();
+	result->subquery = std::move(select_statement);
+	result->subquery_type = SubqueryType::SCALAR;
+	return result;
+}
+
+vector<CSRVertexTable> GetGraphVertexTables(CreatePropertyGraphInfo &pg_info,
+                                            const vector<shared_ptr<PropertyGraphTable>> &edge_tables,
+                                            int32_t csr_id) {
+	// one entry per key the edge tables reference a vertex table by, a vertex table without edges is numbered by
+	// rowid. A table referenced by two keys gets two id ranges, as its edges cannot be matched up across keys.
+	vector<CSRVertexTable> result;
+	for (auto &vertex_table : pg_info.vertex_tables) {
+		auto first_entry = result.size();
+		for (auto &edge_table : edge_tables) {
+			for (auto is_source : {true, false}) {
+				auto &endpoint_table = is_source ? edge_table->source_pg_table : edge_table->destination_pg_table;
+				auto &endpoint_key = is_source ? edge_table->source_pk : edge_table->destination_pk;
+				if (endpoint_table->table_name != vertex_table->table_name ||
+				    FindVertexTable(result, vertex_table->table_name, endpoint_key) != DConstants::INVALID_INDEX) {
+					continue;
+				}
+				result.push_back(
+				    CSRVertexTable {vertex_table, endpoint_key, GetVertexDictionaryId(csr_id, result.size())});
+			}
+		}
+		if (result.size() == first_entry) {
+			result.push_back(CSRVertexTable {vertex_table, {"rowid"}, GetVertexDictionaryId(csr_id, result.size())});
+		}
+	}
+	return result;
+}
+
+idx_t FindVertexTable(const vector<CSRVertexTable> &vertex_tables, const string &table_name,
+                      const vector<string> &key_columns) {
+	for (idx_t i = 0; i < vertex_tables.size(); i++) {
+		if (vertex_tables[i].table->table_name == table_name && vertex_tables[i].key_columns == key_columns) {
+			return i;
+		}
+	}
+	return DConstants::INVALID_INDEX;
+}
+
+// Offset of a vertex table in the global dense id space: the number of vertices of all vertex tables before it
+unique_ptr<ParsedExpression> GetVertexOffset(const vector<CSRVertexTable> &vertex_tables, idx_t vertex_table_index) {
+	unique_ptr<ParsedExpression> result = make_uniq<ConstantExpression>(Value::BIGINT(0));
+	for (idx_t i = 0; i < vertex_table_index; i++) {
+		vector<unique_ptr<ParsedExpression>> add_children;
+		add_children.push_back(std::move(result));
+		add_children.push_back(GetDenseVertexCount(vertex_tables[i], i));
+		result = make_uniq<FunctionExpression>("add", std::move(add_children));
+	}
+	return result;
+}
+
+unique_ptr<ParsedExpression> GetGlobalVertexCount(const vector<CSRVertexTable> &vertex_tables) {
+	return GetVertexOffset(vertex_tables, vertex_tables.size());
+}
+
+// Function to create the CTE with the edges of all edge tables as (src, dst, edges, label) in global dense ids
+unique_ptr<CommonTableExpressionInfo>
+MakeMultiLabelEdgesCTE(const vector<CSRVertexTable> &vertex_tables,
+                       const vector<shared_ptr<PropertyGraphTable>> &edge_tables) {
+	vector<unique_ptr<QueryNode>> label_nodes;
+	for (idx_t label = 0; label < edge_tables.size(); label++) {
+		auto &edge_table = edge_tables[label];
+		auto source_index =
+		    FindVertexTable(vertex_tables, edge_table->source_pg_table->table_name, edge_table->source_pk);
+		auto destination_index =
+		    FindVertexTable(vertex_tables, edge_table->destination_pg_table->table_name, edge_table->destination_pk);
+		auto select_node =
+		    CreateDenseEdgesNode(edge_table, vertex_tables, source_index, destination_index, "",
+		                         GetVertexOffset(vertex_tables, source_index),
+		                         GetVertexOffset(vertex_tables, destination_index));
+		auto label_constant = make_uniq<ConstantExpression>(Value::INTEGER(static_cast<int32_t>(label)));
+		label_constant->alias = "label";
+		select_node->select_list.push_back(std::move(label_constant));
+		label_nodes.push_back(std::move(select_node));
+	}
+
+	auto select_statement = make_uniq<SelectStatement>();
+	if (label_nodes.size() == 1) {
+		select_statement->node = std::move(label_nodes[0]);
+	} else {
+		auto union_all_node = make_uniq<SetOperationNode>();
+		union_all_node->setop_all = true;
+		union_all_node->setop_type = SetOperationType::UNION;
+		union_all_node->children = std::move(label_nodes);
+		select_statement->node = std::move(union_all_node);
+	}
+	auto result = make_uniq<CommonTableExpressionInfo>();
+	result->query = std::move(select_statement);
+	return result;
+}
+
+// Function to create the CTE for a CSR spanning several edge tables
+unique_ptr<CommonTableExpressionInfo>
+CreateMultiLabelCSRCTE(CreatePropertyGraphInfo &pg_info, const vector<shared_ptr<PropertyGraphTable>> &edge_tables,
+                       int32_t csr_id, const unique_ptr<SelectNode> &select_node) {
+	if (edge_tables.empty() || edge_tables.size() > CSR_MAX_EDGE_LABELS) {
+		throw ConstraintException("A multi-label CSR needs between 1 and %d edge tables, got %d", CSR_MAX_EDGE_LABELS,
+		                          edge_tables.size());
+	}
+	auto vertex_tables = GetGraphVertexTables(pg_info, edge_tables, csr_id);
+	if (select_node->cte_map.map.find("vertex_dictionary_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["vertex_dictionary_cte"] = MakeVertexDictionaryCTE(vertex_tables);
+	}
+	if (select_node->cte_map.map.find("multi_label_edges_cte") == select_node->cte_map.map.end()) {
+		select_node->cte_map.map["multi_label_edges_cte"] = MakeMultiLabelEdgesCTE(vertex_tables, edge_tables);
+	}
+
+	auto vertex_subquery =
+	    CreateDenseCSRVertexSubquery(csr_id, GetGlobalVertexCount(vertex_tables), "multi_label_edges_cte");
+
+	vector<unique_ptr<ParsedExpression>> csr_edge_children;
+	csr_edge_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(csr_id)));
+	csr_edge_children.push_back(GetGlobalVertexCount(vertex_tables));
+	csr_edge_children.push_back(make_uniq<CastExpression>(LogicalType::BIGINT, std::move(vertex_subquery)));
+	csr_edge_children.push_back(GetCountDenseEdges("multi_label_edges_cte"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("src"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("dst"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("edges"));
+	csr_edge_children.push_back(make_uniq<ColumnRefExpression>("label"));
+
+	auto create_csr_edge_function =
+	    make_uniq<FunctionExpression>("create_csr_edge_labeled", std::move(csr_edge_children));
+	auto outer_select_node = CreateOuterSelectNode(std::move(create_csr_edge_function));
+	outer_select_node->from_table = CreateBaseTableRef("multi_label_edges_cte");
+
+	auto outer_select_statement = make_uniq<SelectStatement>();
+	outer_select_statement->node = std::move(outer_select_node);
+	auto info = make_uniq<CommonTableExpressionInfo>();
+	info->query = std::move(outer_select_statement);
+	return info;
+}
+
 // Function to create a subquery for counting with CTE
 unique_ptr<SubqueryRef> CreateCountCTESubquery() {
 	auto temp_cte_select_node = make_uniq<SelectNode>();
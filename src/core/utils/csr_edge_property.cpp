@@ -0,0 +1,250 @@
+#include "duckpgq/core/utils/csr_edge_property.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+CSREdgeFilterType CSREdgeFilter::ParseType(const string &op) {
+	auto lower_op = StringUtil::Lower(op);
+	if (lower_op == "=" || lower_op == "==") {
+		return CSREdgeFilterType::EQUAL;
+	}
+	if (lower_op == "<>" || lower_op == "!=") {
+		return CSREdgeFilterType::NOT_EQUAL;
+	}
+	if (lower_op == "<") {
+		return CSREdgeFilterType::LESS_THAN;
+	}
+	if (lower_op == "<=") {
+		return CSREdgeFilterType::LESS_THAN_OR_EQUAL;
+	}
+	if (lower_op == ">") {
+		return CSREdgeFilterType::GREATER_THAN;
+	}
+	if (lower_op == ">=") {
+		return CSREdgeFilterType::GREATER_THAN_OR_EQUAL;
+	}
+	if (lower_op == "between") {
+		return CSREdgeFilterType::BETWEEN;
+	}
+	if (lower_op == "in") {
+		return CSREdgeFilterType::IN;
+	}
+	throw InvalidInputException("Unknown edge filter operator '%s', expected =, <>, <, <=, >, >=, between or in", op);
+}
+
+bool CSREdgeFilter::operator==(const CSREdgeFilter &other) const {
+	return property == other.property && type == other.type && constants == other.constants;
+}
+
+static bool IsIntegerStorage(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+	case PhysicalType::INT16:
+	case PhysicalType::INT32:
+	case PhysicalType::INT64:
+	case PhysicalType::UINT8:
+	case PhysicalType::UINT16:
+	case PhysicalType::UINT32:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static int64_t ReadInteger(PhysicalType type, const UnifiedVectorFormat &format, idx_t idx) {
+	switch (type) {
+	case PhysicalType::BOOL:
+		return UnifiedVectorFormat::GetData<bool>(format)[idx];
+	case PhysicalType::INT8:
+		return UnifiedVectorFormat::GetData<int8_t>(format)[idx];
+	case PhysicalType::INT16:
+		return UnifiedVectorFormat::GetData<int16_t>(format)[idx];
+	case PhysicalType::INT32:
+		return UnifiedVectorFormat::GetData<int32_t>(format)[idx];
+	case PhysicalType::INT64:
+		return UnifiedVectorFormat::GetData<int64_t>(format)[idx];
+	case PhysicalType::UINT8:
+		return UnifiedVectorFormat::GetData<uint8_t>(format)[idx];
+	case PhysicalType::UINT16:
+		return UnifiedVectorFormat::GetData<uint16_t>(format)[idx];
+	case PhysicalType::UINT32:
+		return UnifiedVectorFormat::GetData<uint32_t>(format)[idx];
+	default:
+		throw InternalException("Unexpected physical type for an integer edge property");
+	}
+}
+
+//! Physical value of a constant that was cast to the property type
+static int64_t ConstantToInteger(const Value &value) {
+	switch (value.type().InternalType()) {
+	case PhysicalType::BOOL:
+		return value.GetValueUnsafe<bool>();
+	case PhysicalType::INT8:
+		return value.GetValueUnsafe<int8_t>();
+	case PhysicalType::INT16:
+		return value.GetValueUnsafe<int16_t>();
+	case PhysicalType::INT32:
+		return value.GetValueUnsafe<int32_t>();
+	case PhysicalType::INT64:
+		return value.GetValueUnsafe<int64_t>();
+	case PhysicalType::UINT8:
+		return value.GetValueUnsafe<uint8_t>();
+	case PhysicalType::UINT16:
+		return value.GetValueUnsafe<uint16_t>();
+	case PhysicalType::UINT32:
+		return value.GetValueUnsafe<uint32_t>();
+	default:
+		throw InternalException("Unexpected physical type for an integer edge property");
+	}
+}
+
+template <class T>
+static bool CompareValue(CSREdgeFilterType type, const T &value, const vector<T> &constants) {
+	switch (type) {
+	case CSREdgeFilterType::EQUAL:
+		return value == constants[0];
+	case CSREdgeFilterType::NOT_EQUAL:
+		return value != constants[0];
+	case CSREdgeFilterType::LESS_THAN:
+		return value < constants[0];
+	case CSREdgeFilterType::LESS_THAN_OR_EQUAL:
+		return value <= constants[0];
+	case CSREdgeFilterType::GREATER_THAN:
+		return value > constants[0];
+	case CSREdgeFilterType::GREATER_THAN_OR_EQUAL:
+		return value >= constants[0];
+	case CSREdgeFilterType::BETWEEN:
+		return value >= constants[0] && value <= constants[1];
+	case CSREdgeFilterType::IN:
+		return std::find(constants.begin(), constants.end(), value) != constants.end();
+	default:
+		throw InternalException("Unknown edge filter type");
+	}
+}
+
+template <class T>
+static void EvaluateValues(const vector<T> &values, const vector<uint8_t> &valid, CSREdgeFilterType type,
+                           const vector<T> &constants, DuckPGQBitmap &mask) {
+	for (idx_t i = 0; i < values.size(); i++) {
+		if (valid[i] && CompareValue(type, values[i], constants)) {
+			mask.set(i);
+		}
+	}
+}
+
+template <class T>
+static void GatherValues(vector<T> &values, const vector<int64_t> &source) {
+	vector<T> new_values(source.size());
+	for (idx_t i = 0; i < source.size(); i++) {
+		if (source[i] >= 0) {
+			new_values[i] = std::move(values[source[i]]);
+		}
+	}
+	values = std::move(new_values);
+}
+
+CSREdgeProperty::CSREdgeProperty(LogicalType type_p, idx_t edge_count) : type(std::move(type_p)) {
+	auto physical_type = type.InternalType();
+	if (IsIntegerStorage(physical_type)) {
+		storage = StorageType::INTEGER;
+		int_values.resize(edge_count);
+	} else if (physical_type == PhysicalType::FLOAT || physical_type == PhysicalType::DOUBLE) {
+		storage = StorageType::DOUBLE;
+		double_values.resize(edge_count);
+	} else if (physical_type == PhysicalType::VARCHAR) {
+		storage = StorageType::VARCHAR;
+		string_values.resize(edge_count);
+	} else {
+		throw InvalidInputException("Edge properties of type %s are not supported", type.ToString());
+	}
+	valid.resize(edge_count, 0);
+}
+
+void CSREdgeProperty::SetValue(idx_t position, const UnifiedVectorFormat &format, idx_t idx) {
+	if (!format.validity.RowIsValid(idx)) {
+		valid[position] = 0;
+		return;
+	}
+	valid[position] = 1;
+	switch (storage) {
+	case StorageType::INTEGER:
+		int_values[position] = ReadInteger(type.InternalType(), format, idx);
+		break;
+	case StorageType::DOUBLE:
+		double_values[position] = type.InternalType() == PhysicalType::FLOAT
+		                              ? UnifiedVectorFormat::GetData<float>(format)[idx]
+		                              : UnifiedVectorFormat::GetData<double>(format)[idx];
+		break;
+	case StorageType::VARCHAR:
+		string_values[position] = UnifiedVectorFormat::GetData<string_t>(format)[idx].GetString();
+		break;
+	}
+}
+
+void CSREdgeProperty::Gather(const vector<int64_t> &source) {
+	vector<uint8_t> new_valid(source.size(), 0);
+	for (idx_t i = 0; i < source.size(); i++) {
+		if (source[i] >= 0) {
+			new_valid[i] = valid[source[i]];
+		}
+	}
+	valid = std::move(new_valid);
+	switch (storage) {
+	case StorageType::INTEGER:
+		GatherValues(int_values, source);
+		break;
+	case StorageType::DOUBLE:
+		GatherValues(double_values, source);
+		break;
+	case StorageType::VARCHAR:
+		GatherValues(string_values, source);
+		break;
+	}
+}
+
+void CSREdgeProperty::Evaluate(const CSREdgeFilter &filter, DuckPGQBitmap &mask) const {
+	vector<Value> constants;
+	for (auto &constant : filter.constants) {
+		if (constant.IsNull()) {
+			// a comparison with NULL passes no edge, a NULL in an IN list matches nothing
+			if (filter.type != CSREdgeFilterType::IN) {
+				return;
+			}
+			continue;
+		}
+		constants.push_back(constant.DefaultCastAs(type));
+	}
+	if (constants.empty()) {
+		return;
+	}
+	switch (storage) {
+	case StorageType::INTEGER: {
+		vector<int64_t> integer_constants;
+		for (auto &constant : constants) {
+			integer_constants.push_back(ConstantToInteger(constant));
+		}
+		EvaluateValues(int_values, valid, filter.type, integer_constants, mask);
+		break;
+	}
+	case StorageType::DOUBLE: {
+		vector<double> double_constants;
+		for (auto &constant : constants) {
+			double_constants.push_back(constant.GetValue<double>());
+		}
+		EvaluateValues(double_values, valid, filter.type, double_constants, mask);
+		break;
+	}
+	case StorageType::VARCHAR: {
+		vector<string> string_constants;
+		for (auto &constant : constants) {
+			string_constants.push_back(StringValue::Get(constant));
+		}
+		EvaluateValues(string_values, valid, filter.type, string_constants, mask);
+		break;
+	}
+	}
+}
+
+} // namespace duckdb
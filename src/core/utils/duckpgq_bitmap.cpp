@@ -1,5 +1,7 @@
 #include "duckpgq/core/utils/duckpgq_bitmap.hpp"
 
+#include <bitset>
+
 namespace duckdb {
 
 DuckPGQBitmap::DuckPGQBitmap(size_t size) {
@@ -18,4 +20,13 @@ void DuckPGQBitmap::reset() {
 	fill(bitmap.begin(), bitmap.end(), 0);
 }
 
+idx_t DuckPGQBitmap::IntersectCount(const DuckPGQBitmap &other) const {
+	idx_t count = 0;
+	auto words = MinValue(bitmap.size(), other.bitmap.size());
+	for (idx_t i = 0; i < words; i++) {
+		count += std::bitset<64>(bitmap[i] & other.bitmap[i]).count();
+	}
+	return count;
+}
+
 } // namespace duckdb
@@ -59,7 +59,8 @@ shared_ptr<PropertyGraphTable> ValidateSourceNodeAndEdgeTable(CreatePropertyGrap
 
 // Function to create the SELECT node
 unique_ptr<SelectNode> CreateSelectNode(const shared_ptr<PropertyGraphTable> &edge_pg_entry,
-                                        const string &function_name, const string &function_alias) {
+                                        const string &function_name, const string &function_alias,
+                                        const vector<Value> &extra_arguments) {
 	auto select_node = make_uniq<SelectNode>();
 	std::vector<unique_ptr<ParsedExpression>> select_expression;
 
@@ -70,7 +71,12 @@ unique_ptr<SelectNode> CreateSelectNode(const shared_ptr<PropertyGraphTable> &ed
 
 	vector<unique_ptr<ParsedExpression>> function_children;
 	function_children.push_back(make_uniq<ConstantExpression>(Value::INTEGER(0)));
-	function_children.push_back(make_uniq<ColumnRefExpression>("rowid", edge_pg_entry->source_reference));
+	// the dense id the CSR builders give the vertex, see CreateDenseDirectedCSRCTE and CreateDenseUndirectedCSRCTE
+	function_children.push_back(GetDenseVertexId(GetVertexDictionaryId(0, 0), edge_pg_entry->source_pk,
+	                                             edge_pg_entry->source_reference));
+	for (auto &argument : extra_arguments) {
+		function_children.push_back(make_uniq<ConstantExpression>(argument));
+	}
 	auto function = make_uniq<FunctionExpression>(function_name, std::move(function_children));
 
 	std::vector<unique_ptr<ParsedExpression>> addition_children;
@@ -95,6 +101,47 @@ unique_ptr<SelectNode> CreateSelectNode(const shared_ptr<PropertyGraphTable> &ed
 	return select_node;
 }
 
+void ApplyVertexReordering(ClientContext &context, DuckPGQState &duckpgq_state, CSR &csr) {
+	if (csr.reorder_checked) {
+		return;
+	}
+	lock_guard<mutex> csr_reorder_lock(duckpgq_state.csr_lock);
+	if (csr.reorder_checked) {
+		return;
+	}
+	Value method;
+	if (context.TryGetCurrentSetting("duckpgq_vertex_reordering", method) && !method.IsNull()) {
+		csr.Reorder(ParseCSRReorderMethod(method.ToString()));
+	}
+	csr.reorder_checked = true;
+}
+
+void ApplyHubRows(ClientContext &context, DuckPGQState &duckpgq_state, CSR &csr) {
+	if (csr.hub_rows_checked) {
+		return;
+	}
+	lock_guard<mutex> csr_hub_lock(duckpgq_state.csr_lock);
+	if (csr.hub_rows_checked) {
+		return;
+	}
+	// bitmap rows are opt-in, only edge existence checks read them
+	Value threshold;
+	if (context.TryGetCurrentSetting("duckpgq_hub_degree_threshold", threshold) && !threshold.IsNull()) {
+		csr.BuildHubRows(threshold.GetValue<int64_t>());
+	} else {
+		csr.BuildHubRows(-1);
+	}
+	csr.hub_rows_checked = true;
+}
+
+int64_t GetTimeWindowBound(const Value &bound, bool is_start) {
+	if (bound.IsNull()) {
+		// CSR_NO_EDGE_TIME stays outside an open window
+		return is_start ? NumericLimits<int64_t>::Minimum() : CSR_NO_EDGE_TIME - 1;
+	}
+	return bound.GetValueUnsafe<int64_t>();
+}
+
 unique_ptr<BaseTableRef> CreateBaseTableRef(const string &table_name, const string &alias) {
 	auto base_table_ref = make_uniq<BaseTableRef>();
 	base_table_ref->table_name = table_name;
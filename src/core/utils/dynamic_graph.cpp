@@ -0,0 +1,94 @@
+#include "duckpgq/core/utils/dynamic_graph.hpp"
+
+namespace duckdb {
+
+DynamicGraph::DynamicGraph(int64_t vertex_count) : vertex_count(vertex_count) {
+	degree.resize(vertex_count, 0);
+	head.resize(vertex_count, INVALID_BLOCK);
+	tail.resize(vertex_count, INVALID_BLOCK);
+}
+
+void DynamicGraph::CheckVertex(int64_t vertex) const {
+	if (vertex < 0 || vertex >= vertex_count) {
+		throw ConstraintException("Vertex %d is outside of the dynamic graph with %d vertices", vertex, vertex_count);
+	}
+}
+
+int64_t DynamicGraph::AllocateBlock() {
+	if (!free_blocks.empty()) {
+		auto block = free_blocks.back();
+		free_blocks.pop_back();
+		next_block[block] = INVALID_BLOCK;
+		prev_block[block] = INVALID_BLOCK;
+		return block;
+	}
+	auto block = static_cast<int64_t>(next_block.size());
+	neighbors.resize(neighbors.size() + DYNAMIC_GRAPH_BLOCK_SIZE);
+	next_block.push_back(INVALID_BLOCK);
+	prev_block.push_back(INVALID_BLOCK);
+	return block;
+}
+
+void DynamicGraph::FreeBlock(int64_t block) {
+	free_blocks.push_back(block);
+}
+
+void DynamicGraph::InsertEdge(int64_t src, int64_t dst) {
+	CheckVertex(src);
+	CheckVertex(dst);
+	auto slot = degree[src] % DYNAMIC_GRAPH_BLOCK_SIZE;
+	if (slot == 0) {
+		// tail block is full (or there is none yet)
+		auto block = AllocateBlock();
+		if (tail[src] == INVALID_BLOCK) {
+			head[src] = block;
+		} else {
+			next_block[tail[src]] = block;
+			prev_block[block] = tail[src];
+		}
+		tail[src] = block;
+	}
+	neighbors[tail[src] * DYNAMIC_GRAPH_BLOCK_SIZE + slot] = dst;
+	degree[src]++;
+	edge_count++;
+}
+
+bool DynamicGraph::DeleteEdge(int64_t src, int64_t dst) {
+	CheckVertex(src);
+	CheckVertex(dst);
+	int64_t position = -1;
+	auto remaining = degree[src];
+	for (auto block = head[src]; block != INVALID_BLOCK && remaining > 0 && position < 0; block = next_block[block]) {
+		auto base = block * DYNAMIC_GRAPH_BLOCK_SIZE;
+		auto count = MinValue<int64_t>(remaining, DYNAMIC_GRAPH_BLOCK_SIZE);
+		for (int64_t slot = 0; slot < count; slot++) {
+			if (neighbors[base + slot] == dst) {
+				position = base + slot;
+				break;
+			}
+		}
+		remaining -= count;
+	}
+	if (position < 0) {
+		return false;
+	}
+	// move the last neighbour of the chain into the hole
+	auto last_slot = (degree[src] - 1) % DYNAMIC_GRAPH_BLOCK_SIZE;
+	auto last_position = tail[src] * DYNAMIC_GRAPH_BLOCK_SIZE + last_slot;
+	neighbors[position] = neighbors[last_position];
+	degree[src]--;
+	edge_count--;
+	if (last_slot == 0) {
+		auto block = tail[src];
+		tail[src] = prev_block[block];
+		if (tail[src] == INVALID_BLOCK) {
+			head[src] = INVALID_BLOCK;
+		} else {
+			next_block[tail[src]] = INVALID_BLOCK;
+		}
+		FreeBlock(block);
+	}
+	return true;
+}
+
+} // namespace duckdb
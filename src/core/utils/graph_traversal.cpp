@@ -0,0 +1,109 @@
+#include "duckpgq/core/utils/graph_traversal.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+namespace duckdb {
+
+class TraversalRangeTask : public BaseExecutorTask {
+public:
+	TraversalRangeTask(TaskExecutor &executor, const std::function<void(idx_t, idx_t)> &fun, idx_t begin, idx_t end)
+	    : BaseExecutorTask(executor), fun(fun), begin(begin), end(end) {
+	}
+
+	void ExecuteTask() override {
+		fun(begin, end);
+	}
+
+	string TaskType() const override {
+		return "TraversalRangeTask";
+	}
+
+private:
+	const std::function<void(idx_t, idx_t)> &fun;
+	idx_t begin;
+	idx_t end;
+};
+
+EdgeMapMode ParseEdgeMapMode(const string &mode) {
+	auto lower_mode = StringUtil::Lower(mode);
+	if (lower_mode == "auto") {
+		return EdgeMapMode::AUTO;
+	}
+	if (lower_mode == "sparse") {
+		return EdgeMapMode::SPARSE;
+	}
+	if (lower_mode == "dense") {
+		return EdgeMapMode::DENSE;
+	}
+	if (lower_mode == "pull") {
+		return EdgeMapMode::PULL;
+	}
+	throw InvalidInputException("Unknown edge map mode '%s', expected auto, sparse, dense or pull", mode);
+}
+
+EdgeMapMode GetEdgeMapMode(ClientContext &context) {
+	Value mode;
+	if (context.TryGetCurrentSetting("duckpgq_edge_map_mode", mode) && !mode.IsNull()) {
+		return ParseEdgeMapMode(mode.ToString());
+	}
+	return EdgeMapMode::AUTO;
+}
+
+void TraversalParallelFor(ClientContext *context, idx_t count, const std::function<void(idx_t, idx_t)> &fun) {
+	if (!context || count < PARALLEL_TRAVERSAL_MIN_VERTICES) {
+		fun(0, count);
+		return;
+	}
+	auto thread_count = NumericCast<idx_t>(TaskScheduler::GetScheduler(*context).NumberOfThreads());
+	if (thread_count <= 1) {
+		fun(0, count);
+		return;
+	}
+	// a few ranges per thread to even out skewed degrees
+	auto range_size = MaxValue<idx_t>((count + thread_count * 4 - 1) / (thread_count * 4), 1);
+	TaskExecutor executor(*context);
+	for (idx_t begin = 0; begin < count; begin += range_size) {
+		executor.ScheduleTask(make_uniq<TraversalRangeTask>(executor, fun, begin, MinValue(begin + range_size, count)));
+	}
+	executor.WorkOnTasks();
+}
+
+void TraversalParallelTasks(ClientContext *context, idx_t task_count, const std::function<void(idx_t)> &fun) {
+	auto run_range = [&](idx_t begin, idx_t end) {
+		for (auto task = begin; task < end; task++) {
+			fun(task);
+		}
+	};
+	if (!context || task_count <= 1 || TaskScheduler::GetScheduler(*context).NumberOfThreads() <= 1) {
+		run_range(0, task_count);
+		return;
+	}
+	std::function<void(idx_t, idx_t)> range_fun = run_range;
+	TaskExecutor executor(*context);
+	for (idx_t task = 0; task < task_count; task++) {
+		executor.ScheduleTask(make_uniq<TraversalRangeTask>(executor, range_fun, task, task + 1));
+	}
+	executor.WorkOnTasks();
+}
+
+int64_t VertexRowid(const VertexDictionary *dictionary, int64_t vertex) {
+	return dictionary ? dictionary->GetRowid(vertex) : vertex;
+}
+
+void LabelComponentsBySmallestRowid(ClientContext *context, const CSR *csr, const VertexDictionary *dictionary,
+                                    vector<int64_t> &component) {
+	auto vertex_count = static_cast<int64_t>(component.size());
+	vector<int64_t> smallest_rowid(vertex_count, NumericLimits<int64_t>::Maximum());
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		auto &label = smallest_rowid[component[vertex]];
+		label = MinValue<int64_t>(label, VertexRowid(dictionary, csr ? csr->ToExternal(vertex) : vertex));
+	}
+	TraversalParallelFor(context, static_cast<idx_t>(vertex_count), [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			component[vertex] = smallest_rowid[component[vertex]];
+		}
+	});
+}
+
+} // namespace duckdb
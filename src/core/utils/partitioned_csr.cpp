@@ -0,0 +1,107 @@
+#include "duckpgq/core/utils/partitioned_csr.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+PartitionedCSR::PartitionedCSR(BufferManager &buffer_manager, const CSR &csr, idx_t edges_per_partition)
+    : vsize(csr.vsize), buffer_manager(buffer_manager), vertex_count(static_cast<int64_t>(csr.vsize) - 2),
+      perm(csr.perm) {
+	auto v = reinterpret_cast<const int64_t *>(csr.v);
+	AllocatePartitions(v, edges_per_partition);
+	for (auto &partition : partitions) {
+		if (partition.edge_count == 0) {
+			continue;
+		}
+		auto handle = buffer_manager.Pin(partition.block);
+		auto offset_count = static_cast<idx_t>(partition.end_vertex - partition.first_vertex + 1);
+		auto edges = reinterpret_cast<int64_t *>(handle.Ptr()) + offset_count;
+		memcpy(edges, csr.e.data() + v[partition.first_vertex], partition.edge_count * sizeof(int64_t));
+	}
+	appended_edges = edge_count;
+}
+
+PartitionedCSR::PartitionedCSR(BufferManager &buffer_manager, const vector<int64_t> &degrees,
+                               idx_t edges_per_partition)
+    : vsize(degrees.size() + 2), buffer_manager(buffer_manager), vertex_count(static_cast<int64_t>(degrees.size())),
+      fill(new std::atomic<int64_t>[degrees.size()]), degrees(degrees) {
+	vector<int64_t> offsets(degrees.size() + 1, 0);
+	for (idx_t i = 0; i < degrees.size(); i++) {
+		offsets[i + 1] = offsets[i] + degrees[i];
+		fill[i] = 0;
+	}
+	AllocatePartitions(offsets.data(), edges_per_partition);
+}
+
+void PartitionedCSR::AllocatePartitions(const int64_t *offsets, idx_t edges_per_partition) {
+	if (edges_per_partition == 0) {
+		throw InvalidInputException("A CSR partition needs room for at least one edge");
+	}
+	int64_t first_vertex = 0;
+	while (first_vertex < vertex_count) {
+		// grow the vertex range while its edges fit, a single vertex always fits
+		auto end_vertex = first_vertex + 1;
+		while (end_vertex < vertex_count &&
+		       static_cast<idx_t>(offsets[end_vertex + 1] - offsets[first_vertex]) <= edges_per_partition) {
+			end_vertex++;
+		}
+		auto partition_edges = static_cast<idx_t>(offsets[end_vertex] - offsets[first_vertex]);
+		auto offset_count = static_cast<idx_t>(end_vertex - first_vertex + 1);
+
+		auto handle = buffer_manager.Allocate(MemoryTag::EXTENSION, (offset_count + partition_edges) * sizeof(int64_t),
+		                                      false);
+		auto local_offsets = reinterpret_cast<int64_t *>(handle.Ptr());
+		for (idx_t i = 0; i < offset_count; i++) {
+			local_offsets[i] = offsets[first_vertex + static_cast<int64_t>(i)] - offsets[first_vertex];
+		}
+		partitions.push_back(Partition {first_vertex, end_vertex, partition_edges, handle.GetBlockHandle()});
+		edge_count += partition_edges;
+		first_vertex = end_vertex;
+	}
+}
+
+idx_t PartitionedCSR::FindPartition(int64_t vertex) const {
+	auto entry = std::upper_bound(partitions.begin(), partitions.end(), vertex,
+	                              [](int64_t v, const Partition &partition) { return v < partition.end_vertex; });
+	return static_cast<idx_t>(entry - partitions.begin());
+}
+
+void PartitionedCSR::AppendEdges(const int64_t *src, const int64_t *dst, idx_t count) {
+	if (!fill) {
+		throw InternalException("Edges can only be appended to a partitioned CSR that is built from its degrees");
+	}
+	// visit the edges ordered by source, so every partition touched by this batch is pinned once
+	vector<idx_t> order(count);
+	for (idx_t i = 0; i < count; i++) {
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&](idx_t a, idx_t b) { return src[a] < src[b]; });
+
+	idx_t pinned = DConstants::INVALID_INDEX;
+	BufferHandle handle;
+	int64_t *offsets = nullptr;
+	int64_t *edges = nullptr;
+	for (auto i : order) {
+		auto vertex = src[i];
+		if (vertex < 0 || vertex >= vertex_count || dst[i] < 0 || dst[i] >= vertex_count) {
+			throw ConstraintException("Edge (%d, %d) refers to a vertex outside of the partitioned CSR", vertex,
+			                          dst[i]);
+		}
+		auto slot = fill[vertex]++;
+		if (slot >= degrees[vertex]) {
+			throw ConstraintException("Vertex %d has more edges than its degree %d", vertex, degrees[vertex]);
+		}
+		if (pinned == DConstants::INVALID_INDEX || vertex >= partitions[pinned].end_vertex) {
+			pinned = FindPartition(vertex);
+			handle = buffer_manager.Pin(partitions[pinned].block);
+			offsets = reinterpret_cast<int64_t *>(handle.Ptr());
+			edges = offsets + (partitions[pinned].end_vertex - partitions[pinned].first_vertex + 1);
+		}
+		edges[offsets[vertex - partitions[pinned].first_vertex] + slot] = dst[i];
+	}
+	appended_edges += count;
+}
+
+} // namespace duckdb
@@ -0,0 +1,237 @@
+#include "duckpgq/core/utils/triangle_counting.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <random>
+
+namespace duckdb {
+
+OrientedGraph OrientByDegree(ClientContext &context, const CSR &csr) {
+	auto vertex_count = csr.VertexCount();
+	auto offsets = reinterpret_cast<const int64_t *>(csr.v);
+	auto before = [&](int64_t a, int64_t b) {
+		auto a_degree = offsets[a + 1] - offsets[a];
+		auto b_degree = offsets[b + 1] - offsets[b];
+		return a_degree < b_degree || (a_degree == b_degree && a < b);
+	};
+
+	// every vertex keeps the neighbours that come after it, sorted and without duplicates, in place
+	vector<int64_t> list_offsets(vertex_count + 1, 0);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			int64_t count = 0;
+			csr.ForEachNeighbor(vertex, [&](int64_t neighbor) { count += before(vertex, neighbor); });
+			list_offsets[vertex + 1] = count;
+		}
+	});
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		list_offsets[vertex + 1] += list_offsets[vertex];
+	}
+	vector<int64_t> lists(list_offsets[vertex_count]);
+	vector<int64_t> list_sizes(vertex_count);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			auto list = lists.data() + list_offsets[vertex];
+			int64_t size = 0;
+			csr.ForEachNeighbor(vertex, [&](int64_t neighbor) {
+				if (before(vertex, neighbor)) {
+					list[size++] = neighbor;
+				}
+			});
+			std::sort(list, list + size);
+			list_sizes[vertex] = std::unique(list, list + size) - list;
+		}
+	});
+
+	OrientedGraph result;
+	result.offsets.resize(vertex_count + 1);
+	result.offsets[0] = 0;
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		result.offsets[vertex + 1] = result.offsets[vertex] + list_sizes[vertex];
+	}
+	result.targets.resize(result.offsets[vertex_count]);
+	unique_ptr<std::atomic<int64_t>[]> in_degree(new std::atomic<int64_t>[vertex_count]);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			in_degree[vertex].store(0, std::memory_order_relaxed);
+		}
+	});
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			auto list = lists.data() + list_offsets[vertex];
+			std::copy(list, list + list_sizes[vertex], result.targets.data() + result.offsets[vertex]);
+			for (int64_t i = 0; i < list_sizes[vertex]; i++) {
+				in_degree[list[i]].fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	});
+	result.degree.resize(vertex_count);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			result.degree[vertex] = list_sizes[vertex] + in_degree[vertex].load(std::memory_order_relaxed);
+		}
+	});
+	return result;
+}
+
+vector<int64_t> CountVertexTriangles(ClientContext &context, const OrientedGraph &graph) {
+	auto vertex_count = graph.VertexCount();
+	unique_ptr<std::atomic<int64_t>[]> counts(new std::atomic<int64_t>[vertex_count]);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			counts[vertex].store(0, std::memory_order_relaxed);
+		}
+	});
+	// the triangle u < v < w in orientation order is found once, from u over the edge (u, v)
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto u = static_cast<int64_t>(begin); u < static_cast<int64_t>(end); u++) {
+			auto u_targets = graph.Targets(u);
+			auto u_size = graph.OutDegree(u);
+			int64_t u_triangles = 0;
+			for (idx_t i = 0; i < u_size; i++) {
+				auto v = u_targets[i];
+				int64_t v_triangles = 0;
+				ForEachCommonElement(u_targets, u_size, graph.Targets(v), graph.OutDegree(v), [&](int64_t w) {
+					counts[w].fetch_add(1, std::memory_order_relaxed);
+					v_triangles++;
+				});
+				if (v_triangles > 0) {
+					counts[v].fetch_add(v_triangles, std::memory_order_relaxed);
+					u_triangles += v_triangles;
+				}
+			}
+			counts[u].fetch_add(u_triangles, std::memory_order_relaxed);
+		}
+	});
+	vector<int64_t> triangles(vertex_count);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			triangles[vertex] = counts[vertex].load(std::memory_order_relaxed);
+		}
+	});
+	return triangles;
+}
+
+//! Two-sided standard normal quantile of the confidence, by bisection on the complementary error function
+static double NormalQuantile(double confidence) {
+	double low = 0;
+	double high = 40;
+	for (idx_t i = 0; i < 128; i++) {
+		auto middle = (low + high) / 2;
+		if (std::erfc(middle / std::sqrt(2.0)) > 1 - confidence) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	return (low + high) / 2;
+}
+
+//! Distinct neighbours of every vertex other than itself in the base arrays of a compacted CSR, sorted, so every
+//! pair in a list is a wedge
+static void BuildSimpleAdjacency(ClientContext &context, const CSR &csr, vector<int64_t> &offsets,
+                                 vector<int64_t> &targets) {
+	auto vertex_count = csr.VertexCount();
+	auto csr_offsets = reinterpret_cast<const int64_t *>(csr.v);
+	offsets.assign(vertex_count + 1, 0);
+	targets.resize(csr_offsets[vertex_count]);
+	vector<int64_t> sizes(vertex_count);
+	TraversalParallelFor(&context, vertex_count, [&](idx_t begin, idx_t end) {
+		for (auto vertex = static_cast<int64_t>(begin); vertex < static_cast<int64_t>(end); vertex++) {
+			auto list = targets.data() + csr_offsets[vertex];
+			int64_t size = 0;
+			for (auto offset = csr_offsets[vertex]; offset < csr_offsets[vertex + 1]; offset++) {
+				if (csr.e[offset] != vertex) {
+					list[size++] = csr.e[offset];
+				}
+			}
+			std::sort(list, list + size);
+			sizes[vertex] = std::unique(list, list + size) - list;
+		}
+	});
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		offsets[vertex + 1] = offsets[vertex] + sizes[vertex];
+	}
+	// close the gaps the dropped self-loops and duplicates left, in vertex order the lists only move to the front
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		if (offsets[vertex] != csr_offsets[vertex]) {
+			std::copy(targets.begin() + csr_offsets[vertex], targets.begin() + csr_offsets[vertex] + sizes[vertex],
+			          targets.begin() + offsets[vertex]);
+		}
+	}
+	targets.resize(offsets[vertex_count]);
+}
+
+TriangleEstimate EstimateTriangles(ClientContext &context, const CSR &csr, double error, double confidence) {
+	auto vertex_count = csr.VertexCount();
+	// self-loops and parallel edges are no wedges, sampling over the raw lists would count them as open ones
+	vector<int64_t> offsets;
+	vector<int64_t> targets;
+	BuildSimpleAdjacency(context, csr, offsets, targets);
+	// wedges centred at every vertex, as a prefix sum to sample centres proportionally
+	vector<int64_t> wedge_prefix(vertex_count + 1, 0);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		auto degree = offsets[vertex + 1] - offsets[vertex];
+		wedge_prefix[vertex + 1] = wedge_prefix[vertex] + degree * (degree - 1) / 2;
+	}
+	TriangleEstimate estimate;
+	auto wedges = static_cast<double>(wedge_prefix[vertex_count]);
+	if (wedge_prefix[vertex_count] == 0) {
+		// without wedges there are no triangles, the estimate is exact
+		estimate.error_met = true;
+		return estimate;
+	}
+
+	auto z = NormalQuantile(confidence);
+	auto z_squared = z * z;
+	idx_t closed = 0;
+	for (idx_t sample_round = 0; estimate.samples < TRIANGLE_MAX_SAMPLES; sample_round++) {
+		vector<idx_t> task_closed(TRIANGLE_SAMPLE_TASKS, 0);
+		TraversalParallelTasks(&context, TRIANGLE_SAMPLE_TASKS, [&](idx_t task) {
+			std::mt19937_64 generator(sample_round * TRIANGLE_SAMPLE_TASKS + task);
+			std::uniform_int_distribution<int64_t> pick_wedge(0, wedge_prefix[vertex_count] - 1);
+			for (idx_t i = 0; i < TRIANGLE_SAMPLE_ROUND / TRIANGLE_SAMPLE_TASKS; i++) {
+				auto wedge = pick_wedge(generator);
+				auto center = static_cast<int64_t>(
+				    std::upper_bound(wedge_prefix.begin(), wedge_prefix.end(), wedge) - wedge_prefix.begin() - 1);
+				auto degree = offsets[center + 1] - offsets[center];
+				// two distinct positions of the adjacency list of the centre, which are two distinct neighbours
+				auto first = std::uniform_int_distribution<int64_t>(0, degree - 1)(generator);
+				auto second = std::uniform_int_distribution<int64_t>(0, degree - 2)(generator);
+				second += second >= first;
+				auto a = targets[offsets[center] + first];
+				auto b = targets[offsets[center] + second];
+				// look the edge up from the endpoint with the shorter list
+				if (offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b]) {
+					std::swap(a, b);
+				}
+				task_closed[task] += csr.HasEdge(a, b);
+			}
+		});
+		for (auto count : task_closed) {
+			closed += count;
+		}
+		estimate.samples += TRIANGLE_SAMPLE_ROUND;
+		auto samples = static_cast<double>(estimate.samples);
+		auto closed_fraction = static_cast<double>(closed) / samples;
+		estimate.transitivity = closed_fraction;
+		// Wilson score interval, which stays inside [0, 1] and does not collapse when no or every wedge is closed
+		auto scale = 1 + z_squared / samples;
+		auto center = (closed_fraction + z_squared / (2 * samples)) / scale;
+		auto half_width = z / scale *
+		                  std::sqrt(closed_fraction * (1 - closed_fraction) / samples +
+		                            z_squared / (4 * samples * samples));
+		estimate.triangles = closed_fraction * wedges / 3;
+		estimate.lower_bound = MaxValue<double>(center - half_width, 0) * wedges / 3;
+		estimate.upper_bound = MinValue<double>(center + half_width, 1) * wedges / 3;
+		estimate.error_met = half_width <= error * closed_fraction;
+		if (estimate.error_met ||
+		    half_width <= error * MaxValue<double>(closed_fraction, TRIANGLE_MIN_TRANSITIVITY)) {
+			break;
+		}
+	}
+	return estimate;
+}
+
+} // namespace duckdb
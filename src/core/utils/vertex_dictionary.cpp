@@ -0,0 +1,141 @@
+#include "duckpgq/core/utils/vertex_dictionary.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace duckdb {
+
+//! Big-endian so that byte order matches numeric order
+static void AppendBigEndian(string &key, uint64_t value) {
+	for (idx_t shift = 64; shift > 0; shift -= 8) {
+		key.push_back(static_cast<char>((value >> (shift - 8)) & 0xFF));
+	}
+}
+
+void VertexDictionary::EncodeKeys(DataChunk &args, idx_t first_column, vector<string> &keys, vector<bool> &valid) {
+	auto count = args.size();
+	keys.assign(count, string());
+	valid.assign(count, true);
+	for (idx_t col = first_column; col < args.ColumnCount(); col++) {
+		auto physical_type = args.data[col].GetType().InternalType();
+		UnifiedVectorFormat format;
+		args.data[col].ToUnifiedFormat(count, format);
+		if (physical_type == PhysicalType::VARCHAR) {
+			auto strings = UnifiedVectorFormat::GetData<string_t>(format);
+			for (idx_t row = 0; row < count; row++) {
+				auto idx = format.sel->get_index(row);
+				if (!format.validity.RowIsValid(idx)) {
+					valid[row] = false;
+					continue;
+				}
+				// escape zero bytes and terminate with \0\0, so that ('ab', 'c') and ('a', 'bc') stay different keys
+				// and composite keys sort column by column
+				auto data = strings[idx].GetData();
+				for (idx_t i = 0; i < strings[idx].GetSize(); i++) {
+					keys[row].push_back(data[i]);
+					if (data[i] == '\0') {
+						keys[row].push_back('\1');
+					}
+				}
+				keys[row].append(2, '\0');
+			}
+			continue;
+		}
+		if (physical_type == PhysicalType::INT64 || physical_type == PhysicalType::UINT64) {
+			auto values = reinterpret_cast<const uint64_t *>(format.data);
+			// flipping the sign bit orders negative BIGINTs before positive ones
+			uint64_t sign_flip = physical_type == PhysicalType::INT64 ? 1ULL << 63 : 0;
+			for (idx_t row = 0; row < count; row++) {
+				auto idx = format.sel->get_index(row);
+				if (!format.validity.RowIsValid(idx)) {
+					valid[row] = false;
+					continue;
+				}
+				AppendBigEndian(keys[row], values[idx] ^ sign_flip);
+			}
+			continue;
+		}
+		if (!TypeIsConstantSize(physical_type)) {
+			throw InvalidInputException("Vertex keys of type %s are not supported",
+			                            args.data[col].GetType().ToString());
+		}
+		auto width = GetTypeIdSize(physical_type);
+		for (idx_t row = 0; row < count; row++) {
+			auto idx = format.sel->get_index(row);
+			if (!format.validity.RowIsValid(idx)) {
+				valid[row] = false;
+				continue;
+			}
+			keys[row].append(reinterpret_cast<const char *>(format.data + idx * width), width);
+		}
+	}
+}
+
+void VertexDictionary::Insert(vector<string> &batch, vector<int64_t> &batch_rowids) {
+	D_ASSERT(batch_rowids.empty() || batch_rowids.size() == batch.size());
+	if (!batch_rowids.empty()) {
+		has_rowids = true;
+	}
+	auto &shard = shards[next_shard++ % INSERT_SHARD_COUNT];
+	lock_guard<mutex> guard(shard.lock);
+	shard.keys.insert(shard.keys.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+	if (batch_rowids.empty()) {
+		shard.rowids.insert(shard.rowids.end(), batch.size(), -1);
+	} else {
+		shard.rowids.insert(shard.rowids.end(), batch_rowids.begin(), batch_rowids.end());
+	}
+	finalized = false;
+}
+
+void VertexDictionary::Finalize() {
+	if (finalized.load()) {
+		return;
+	}
+	lock_guard<mutex> guard(finalize_lock);
+	if (finalized.load()) {
+		return;
+	}
+	vector<std::pair<string, int64_t>> entries;
+	entries.reserve(keys.size());
+	for (idx_t i = 0; i < keys.size(); i++) {
+		entries.emplace_back(std::move(keys[i]), rowids[i]);
+	}
+	for (auto &shard : shards) {
+		lock_guard<mutex> shard_guard(shard.lock);
+		for (idx_t i = 0; i < shard.keys.size(); i++) {
+			entries.emplace_back(std::move(shard.keys[i]), shard.rowids[i]);
+		}
+		vector<string>().swap(shard.keys);
+		vector<int64_t>().swap(shard.rowids);
+	}
+	// a duplicate key keeps the smallest of its rowids
+	std::sort(entries.begin(), entries.end());
+	keys.clear();
+	rowids.clear();
+	for (auto &entry : entries) {
+		if (!keys.empty() && keys.back() == entry.first) {
+			continue;
+		}
+		keys.push_back(std::move(entry.first));
+		rowids.push_back(entry.second);
+	}
+	keys.shrink_to_fit();
+	rowids.shrink_to_fit();
+	finalized = true;
+}
+
+int64_t VertexDictionary::Lookup(const string &key) const {
+	D_ASSERT(finalized);
+	auto entry = std::lower_bound(keys.begin(), keys.end(), key);
+	if (entry == keys.end() || *entry != key) {
+		return -1;
+	}
+	return static_cast<int64_t>(entry - keys.begin());
+}
+
+int64_t VertexDictionary::GetRowid(int64_t dense_id) const {
+	D_ASSERT(finalized && dense_id >= 0 && dense_id < static_cast<int64_t>(rowids.size()));
+	return rowids[dense_id];
+}
+
+} // namespace duckdb
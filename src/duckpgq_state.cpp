@@ -163,10 +163,27 @@ void DuckPGQState::QueryEnd() {
 	parse_data.reset();
 	transform_expression.clear();
 	match_index = 0; // Reset the index
+	lock_guard<mutex> csr_delete_lock(csr_lock);
 	for (const auto &csr_id : csr_to_delete) {
-		csr_list.erase(csr_id);
+		auto csr_entry = csr_list.find(csr_id);
+		if (csr_entry == csr_list.end()) {
+			continue;
+		}
+		// wait for the last reader before freeing the CSR, no new reader can look it up while csr_lock is held
+		csr_entry->second->access_lock.Lock();
+		csr_entry->second->access_lock.Unlock();
+		csr_list.erase(csr_entry);
 	}
 	csr_to_delete.clear();
+	// the vertex dictionaries of a CSR builder live as long as their CSR
+	for (auto entry = vertex_dictionary_list.begin(); entry != vertex_dictionary_list.end();) {
+		auto csr_id = GetVertexDictionaryCSRId(entry->first);
+		if (csr_id >= 0 && csr_list.find(csr_id) == csr_list.end()) {
+			entry = vertex_dictionary_list.erase(entry);
+		} else {
+			++entry;
+		}
+	}
 }
 
 CreatePropertyGraphInfo *DuckPGQState::GetPropertyGraph(const string &pg_name) {
@@ -185,4 +202,43 @@ CSR *DuckPGQState::GetCSR(int32_t id) {
 	return csr_entry->second.get();
 }
 
+DynamicGraph *DuckPGQState::GetDynamicGraph(int32_t id) {
+	auto graph_entry = dynamic_graph_list.find(id);
+	if (graph_entry == dynamic_graph_list.end()) {
+		return nullptr;
+	}
+	return graph_entry->second.get();
+}
+
+PartitionedCSR *DuckPGQState::GetPartitionedCSR(int32_t id) {
+	auto partitioned_entry = partitioned_csr_list.find(id);
+	if (partitioned_entry == partitioned_csr_list.end()) {
+		return nullptr;
+	}
+	return partitioned_entry->second.get();
+}
+
+VertexDictionary *DuckPGQState::GetVertexDictionary(int32_t id) {
+	auto dictionary_entry = vertex_dictionary_list.find(id);
+	if (dictionary_entry == vertex_dictionary_list.end()) {
+		return nullptr;
+	}
+	return dictionary_entry->second.get();
+}
+
+VertexDictionary *DuckPGQState::GetRowidDictionary(int32_t csr_id, int64_t vertex_count) {
+	if (csr_id < 0 || csr_id > (NumericLimits<int32_t>::Maximum() - 1) / CSR_MAX_VERTEX_TABLES - 1) {
+		return nullptr;
+	}
+	auto dictionary = GetVertexDictionary(GetVertexDictionaryId(csr_id, 0));
+	if (!dictionary || !dictionary->HasRowids()) {
+		return nullptr;
+	}
+	dictionary->Finalize();
+	if (static_cast<int64_t>(dictionary->Size()) != vertex_count) {
+		return nullptr;
+	}
+	return dictionary;
+}
+
 } // namespace duckdb
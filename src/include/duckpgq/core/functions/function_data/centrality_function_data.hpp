@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/function_data/centrality_function_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckdb/main/client_context.hpp"
+#include "duckpgq/common.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+struct CentralityFunctionData final : FunctionData {
+	ClientContext &context;
+	int32_t csr_id;
+	//! Number of sampled sources, 0 runs from every vertex
+	int64_t samples;
+	//! Only betweenness_centrality has a normalized variant
+	bool normalized;
+	std::mutex centrality_lock;
+	std::atomic<bool> state_converged;
+	//! Score of every vertex, computed by the first chunk
+	vector<double> centrality;
+
+	CentralityFunctionData(ClientContext &context, int32_t csr_id, int64_t samples, bool normalized);
+
+	static unique_ptr<FunctionData> CentralityBind(ClientContext &context, ScalarFunction &bound_function,
+	                                               vector<unique_ptr<Expression>> &arguments);
+
+	unique_ptr<FunctionData> Copy() const override;
+	bool Equals(const FunctionData &other_p) const override;
+};
+
+} // namespace duckdb
@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/function_data/community_detection_function_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckdb/main/client_context.hpp"
+#include "duckpgq/common.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+#define COMMUNITY_DEFAULT_SEED 0
+#define LABEL_PROPAGATION_DEFAULT_MAX_ITERATIONS 100
+#define LEIDEN_DEFAULT_RESOLUTION 1.0
+//! Levels of local moving, refinement and aggregation, most graphs converge in a handful
+#define LEIDEN_DEFAULT_MAX_ITERATIONS 10
+
+struct CommunityDetectionFunctionData final : FunctionData {
+	ClientContext &context;
+	int32_t csr_id;
+	//! Bound by leiden, label_propagation otherwise
+	bool leiden;
+	int64_t seed;
+	double resolution;
+	int64_t max_iterations;
+	std::mutex community_lock;
+	std::atomic<bool> state_converged;
+	//! Community of every vertex, labelled by the smallest rowid in it, computed by the first chunk
+	vector<int64_t> community;
+	//! Modularity of the communities at the resolution, and the time it took to find them
+	double modularity;
+	double runtime_ms;
+
+	CommunityDetectionFunctionData(ClientContext &context, int32_t csr_id, bool leiden, int64_t seed,
+	                               double resolution, int64_t max_iterations);
+
+	static unique_ptr<FunctionData> CommunityDetectionBind(ClientContext &context, ScalarFunction &bound_function,
+	                                                       vector<unique_ptr<Expression>> &arguments);
+
+	unique_ptr<FunctionData> Copy() const override;
+	bool Equals(const FunctionData &other_p) const override;
+};
+
+} // namespace duckdb
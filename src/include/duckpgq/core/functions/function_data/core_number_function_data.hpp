@@ -0,0 +1,34 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/function_data/core_number_function_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckdb/main/client_context.hpp"
+#include "duckpgq/common.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+struct CoreNumberFunctionData final : FunctionData {
+	ClientContext &context;
+	int32_t csr_id;
+	std::mutex core_lock;
+	std::atomic<bool> state_converged;
+	//! Largest k such that the vertex is in the k-core, computed by the first chunk
+	vector<int64_t> core;
+
+	CoreNumberFunctionData(ClientContext &context, int32_t csr_id);
+
+	static unique_ptr<FunctionData> CoreNumberBind(ClientContext &context, ScalarFunction &bound_function,
+	                                               vector<unique_ptr<Expression>> &arguments);
+
+	unique_ptr<FunctionData> Copy() const override;
+	bool Equals(const FunctionData &other_p) const override;
+};
+
+} // namespace duckdb
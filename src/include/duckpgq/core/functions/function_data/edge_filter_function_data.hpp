@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/function_data/edge_filter_function_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckdb/main/client_context.hpp"
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+#include "duckpgq/core/utils/csr_edge_property.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+//! Bind data of the path-finding functions that only follow edges passing a filter on an edge property
+struct EdgeFilterFunctionData final : FunctionData {
+	ClientContext &context;
+	int32_t csr_id;
+	CSREdgeFilter filter;
+	//! Edges of the CSR passing the filter, evaluated once per query by the first chunk
+	std::mutex mask_lock;
+	std::atomic<bool> mask_ready;
+	unique_ptr<DuckPGQBitmap> edge_mask;
+	//! Size of the edge array the mask was evaluated over, a compaction in between evaluates it again
+	idx_t mask_edge_count = 0;
+
+	EdgeFilterFunctionData(ClientContext &context, int32_t csr_id, CSREdgeFilter filter)
+	    : context(context), csr_id(csr_id), filter(std::move(filter)), mask_ready(false) {
+	}
+	//! Arguments 3 to 5 are the property name, the operator and the constant, a list for between and in
+	static unique_ptr<FunctionData> EdgeFilterBind(ClientContext &context, ScalarFunction &bound_function,
+	                                               vector<unique_ptr<Expression>> &arguments);
+
+	//! The edge mask of the CSR, evaluated on first use. Call with a read guard on the CSR.
+	const DuckPGQBitmap &GetEdgeMask(CSR &csr);
+
+	unique_ptr<FunctionData> Copy() const override;
+	bool Equals(const FunctionData &other_p) const override;
+};
+
+} // namespace duckdb
@@ -10,13 +10,22 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckpgq/common.hpp"
 
+#include <atomic>
+
 namespace duckdb {
 
 struct LocalClusteringCoefficientFunctionData final : FunctionData {
 	ClientContext &context;
 	int32_t csr_id;
+	//! local_wedge_count only needs the degrees
+	bool count_triangles;
+	std::mutex triangle_lock;
+	std::atomic<bool> state_converged;
+	//! Triangles through every vertex and its number of distinct neighbours, indexed by CSR vertex
+	vector<int64_t> triangles;
+	vector<int64_t> degree;
 
-	LocalClusteringCoefficientFunctionData(ClientContext &context, int32_t csr_id);
+	LocalClusteringCoefficientFunctionData(ClientContext &context, int32_t csr_id, bool count_triangles);
 	static unique_ptr<FunctionData> LocalClusteringCoefficientBind(ClientContext &context,
 	                                                               ScalarFunction &bound_function,
 	                                                               vector<unique_ptr<Expression>> &arguments);
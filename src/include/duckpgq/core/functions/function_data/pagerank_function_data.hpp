@@ -12,6 +12,11 @@
 
 namespace duckdb {
 
+#define PAGERANK_DEFAULT_DAMPING 0.85
+#define PAGERANK_DEFAULT_TOLERANCE 1e-6
+//! Far above the iterations a damping of 0.85 needs to reach the default tolerance
+#define PAGERANK_DEFAULT_MAX_ITERATIONS 1000
+
 struct PageRankFunctionData final : FunctionData {
 	ClientContext &context;
 	int32_t csr_id;
@@ -19,12 +24,16 @@ struct PageRankFunctionData final : FunctionData {
 	vector<double_t> temp_rank;
 	double_t damping_factor;
 	double_t convergence_threshold;
+	int64_t max_iterations;
 	int64_t iteration_count;
 	std::mutex state_lock; // Lock for state
 	bool state_initialized;
-	bool converged;
+	//! Set once the ranks are final, after converging or running max_iterations iterations
+	std::atomic<bool> converged;
 
 	PageRankFunctionData(ClientContext &context, int32_t csr_id);
+	PageRankFunctionData(ClientContext &context, int32_t csr_id, double_t damping_factor,
+	                     double_t convergence_threshold, int64_t max_iterations);
 	PageRankFunctionData(ClientContext &context, int32_t csr_id, const vector<int64_t> &componentId);
 	static unique_ptr<FunctionData> PageRankBind(ClientContext &context, ScalarFunction &bound_function,
 	                                             vector<unique_ptr<Expression>> &arguments);
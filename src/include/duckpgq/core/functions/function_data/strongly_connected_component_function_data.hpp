@@ -0,0 +1,39 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/function_data/strongly_connected_component_function_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckdb/main/client_context.hpp"
+#include "duckpgq/common.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+struct StronglyConnectedComponentFunctionData final : FunctionData {
+	ClientContext &context;
+	int32_t csr_id;
+	//! Bound by strongly_connected_component_successors, which also needs the condensation
+	bool build_condensation;
+	std::mutex scc_lock;
+	std::atomic<bool> state_converged;
+	//! Component of every vertex, labelled by the smallest rowid in it
+	vector<int64_t> component;
+	//! Edges of the condensation DAG as distinct (source, destination) component labels, sorted
+	vector<std::pair<int64_t, int64_t>> condensation;
+
+	StronglyConnectedComponentFunctionData(ClientContext &context, int32_t csr_id, bool build_condensation);
+
+	static unique_ptr<FunctionData> StronglyConnectedComponentBind(ClientContext &context,
+	                                                               ScalarFunction &bound_function,
+	                                                               vector<unique_ptr<Expression>> &arguments);
+
+	unique_ptr<FunctionData> Copy() const override;
+	bool Equals(const FunctionData &other_p) const override;
+};
+
+} // namespace duckdb
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/function_data/summarize_csr_function_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckdb/main/client_context.hpp"
+#include "duckpgq/common.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+//! Degrees of the vertices with at least one edge of a label, the quantiles are the degree at rank
+//! floor(q * (vertices - 1)) of the ascending degrees
+struct CSRDegreeSummary {
+	int64_t vertices = 0;
+	int64_t sum = 0;
+	int64_t min = 0;
+	int64_t max = 0;
+	int64_t q25 = 0;
+	int64_t q50 = 0;
+	int64_t q75 = 0;
+};
+
+struct CSRLabelSummary {
+	int64_t edge_count = 0;
+	int64_t self_loops = 0;
+	CSRDegreeSummary in_degree;
+	CSRDegreeSummary out_degree;
+};
+
+struct SummarizeCSRFunctionData final : FunctionData {
+	ClientContext &context;
+	int32_t csr_id;
+	std::mutex summary_lock;
+	std::atomic<bool> state_converged;
+	//! Statistics of every edge label of the CSR, computed by the first chunk
+	vector<CSRLabelSummary> summaries;
+
+	SummarizeCSRFunctionData(ClientContext &context, int32_t csr_id);
+
+	static unique_ptr<FunctionData> SummarizeCSRBind(ClientContext &context, ScalarFunction &bound_function,
+	                                                 vector<unique_ptr<Expression>> &arguments);
+
+	unique_ptr<FunctionData> Copy() const override;
+	bool Equals(const FunctionData &other_p) const override;
+};
+
+} // namespace duckdb
@@ -10,16 +10,17 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckpgq/common.hpp"
 
+#include <atomic>
+
 namespace duckdb {
 
 struct WeaklyConnectedComponentFunctionData final : FunctionData {
 	ClientContext &context;
 	int32_t csr_id;
 	std::mutex wcc_lock;
-	std::mutex initialize_lock;
-	bool state_converged;
-	bool state_initialized;
-	vector<int64_t> forest;
+	std::atomic<bool> state_converged;
+	//! Component of every vertex, labelled by the smallest rowid in it
+	vector<int64_t> component;
 
 	WeaklyConnectedComponentFunctionData(ClientContext &context, int32_t csr_id);
 
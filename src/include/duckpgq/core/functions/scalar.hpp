@@ -16,16 +16,34 @@ struct CoreScalarFunctions {
 		RegisterIterativeLengthScalarFunction(loader); // this 3
 		RegisterIterativeLength2ScalarFunction(loader);
 		RegisterIterativeLengthBidirectionalScalarFunction(loader);
+		RegisterCentralityScalarFunctions(loader);
+		RegisterCommunityDetectionScalarFunctions(loader);
+		RegisterCoreNumberScalarFunction(loader);
+		RegisterDegreeScalarFunctions(loader);
+		RegisterSummarizeCSRScalarFunction(loader);
 		RegisterLocalClusteringCoefficientScalarFunction(loader);
 		RegisterPageRankScalarFunction(loader);
+		RegisterPersonalizedPageRankScalarFunction(loader);
+		RegisterStronglyConnectedComponentScalarFunctions(loader);
+		RegisterTemporalPathLengthScalarFunction(loader);
 		RegisterWeaklyConnectedComponentScalarFunction(loader);
 
 		// Access CSR data structures
 		RegisterGetCSRWTypeScalarFunction(loader);
+		RegisterCSRHasEdgeScalarFunction(loader);
 
 		// Create CSR graph representation
 		RegisterCSRCreationScalarFunctions(loader);
 		RegisterCSRDeletionScalarFunction(loader);
+		RegisterCSRAppendScalarFunctions(loader);
+		RegisterCSREdgePropertyScalarFunction(loader);
+		RegisterCSRPartitionScalarFunctions(loader);
+
+		// Dynamic graph store for streaming edge updates
+		RegisterDynamicGraphScalarFunctions(loader);
+
+		// Dense vertex ids for arbitrary vertex keys
+		RegisterVertexDictionaryScalarFunctions(loader);
 
 		// Check if nodes are reachable
 		RegisterReachabilityScalarFunction(loader); // this 4
@@ -35,9 +53,19 @@ struct CoreScalarFunctions {
 	}
 
 private:
+	static void RegisterCentralityScalarFunctions(ExtensionLoader &loader);
 	static void RegisterCheapestPathLengthScalarFunction(ExtensionLoader &loader);
+	static void RegisterCommunityDetectionScalarFunctions(ExtensionLoader &loader);
+	static void RegisterCoreNumberScalarFunction(ExtensionLoader &loader);
+	static void RegisterDegreeScalarFunctions(ExtensionLoader &loader);
+	static void RegisterSummarizeCSRScalarFunction(ExtensionLoader &loader);
 	static void RegisterCSRCreationScalarFunctions(ExtensionLoader &loader);
 	static void RegisterCSRDeletionScalarFunction(ExtensionLoader &loader);
+	static void RegisterCSRAppendScalarFunctions(ExtensionLoader &loader);
+	static void RegisterCSRHasEdgeScalarFunction(ExtensionLoader &loader);
+	static void RegisterCSREdgePropertyScalarFunction(ExtensionLoader &loader);
+	static void RegisterCSRPartitionScalarFunctions(ExtensionLoader &loader);
+	static void RegisterDynamicGraphScalarFunctions(ExtensionLoader &loader);
 	static void RegisterGetCSRWTypeScalarFunction(ExtensionLoader &loader);
 	static void RegisterIterativeLengthScalarFunction(ExtensionLoader &loader);
 	static void RegisterIterativeLength2ScalarFunction(ExtensionLoader &loader);
@@ -45,8 +73,12 @@ private:
 	static void RegisterLocalClusteringCoefficientScalarFunction(ExtensionLoader &loader);
 	static void RegisterReachabilityScalarFunction(ExtensionLoader &loader);
 	static void RegisterShortestPathScalarFunction(ExtensionLoader &loader);
+	static void RegisterStronglyConnectedComponentScalarFunctions(ExtensionLoader &loader);
+	static void RegisterTemporalPathLengthScalarFunction(ExtensionLoader &loader);
 	static void RegisterWeaklyConnectedComponentScalarFunction(ExtensionLoader &loader);
+	static void RegisterVertexDictionaryScalarFunctions(ExtensionLoader &loader);
 	static void RegisterPageRankScalarFunction(ExtensionLoader &loader);
+	static void RegisterPersonalizedPageRankScalarFunction(ExtensionLoader &loader);
 };
 
 } // namespace duckdb
@@ -11,33 +11,59 @@ struct CoreTableFunctions {
 		RegisterDescribePropertyGraphTableFunction(loader);
 		RegisterDropPropertyGraphTableFunction(loader);
 
-		// Measure clustering for nodes
+		// Measure clustering for nodes, and triangles of the whole graph
 		RegisterLocalClusteringCoefficientTableFunction(loader);
+		RegisterTriangleCountTableFunctions(loader);
+
+		// Core number of every vertex
+		RegisterKCoreTableFunction(loader);
+
+		// Degree, in-degree and out-degree of every vertex
+		RegisterDegreeTableFunctions(loader);
 
 		// Pattern matching queries (like "find all paths from A to B")
 		RegisterMatchTableFunction(loader);
 
+		// Build one CSR over several edge labels
+		RegisterMultiLabelCSRTableFunction(loader);
+
+		// Rank vertices by the shortest paths through them
+		RegisterCentralityTableFunctions(loader);
+
 		// Compute PageRank for all nodes in a graph
 		RegisterPageRankTableFunction(loader);
+		RegisterPersonalizedPageRankTableFunction(loader);
 
 		// Scan property graph data
 		RegisterScanTableFunctions(loader);
 		RegisterSummarizePropertyGraphTableFunction(loader);
 
+		// Find communities
+		RegisterCommunityDetectionTableFunctions(loader);
+
 		// Find connected components
+		RegisterStronglyConnectedComponentTableFunctions(loader);
 		RegisterWeaklyConnectedComponentTableFunction(loader);
 	}
 
 private:
+	static void RegisterCentralityTableFunctions(ExtensionLoader &loader);
+	static void RegisterCommunityDetectionTableFunctions(ExtensionLoader &loader);
 	static void RegisterCreatePropertyGraphTableFunction(ExtensionLoader &loader);
 	static void RegisterMatchTableFunction(ExtensionLoader &loader);
+	static void RegisterMultiLabelCSRTableFunction(ExtensionLoader &loader);
 	static void RegisterDropPropertyGraphTableFunction(ExtensionLoader &loader);
 	static void RegisterDescribePropertyGraphTableFunction(ExtensionLoader &loader);
 	static void RegisterLocalClusteringCoefficientTableFunction(ExtensionLoader &loader);
+	static void RegisterKCoreTableFunction(ExtensionLoader &loader);
+	static void RegisterDegreeTableFunctions(ExtensionLoader &loader);
 	static void RegisterScanTableFunctions(ExtensionLoader &loader);
+	static void RegisterStronglyConnectedComponentTableFunctions(ExtensionLoader &loader);
 	static void RegisterWeaklyConnectedComponentTableFunction(ExtensionLoader &loader);
 	static void RegisterPageRankTableFunction(ExtensionLoader &loader);
+	static void RegisterPersonalizedPageRankTableFunction(ExtensionLoader &loader);
 	static void RegisterSummarizePropertyGraphTableFunction(ExtensionLoader &loader);
+	static void RegisterTriangleCountTableFunctions(ExtensionLoader &loader);
 };
 
 } // namespace duckdb
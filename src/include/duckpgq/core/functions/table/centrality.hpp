@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/centrality.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+//! betweenness_centrality(pg, vertex_label, edge_label, samples := NULL, normalized := false) scores every vertex by
+//! the shortest paths between other vertices that pass through it, following the edges in their direction. With
+//! samples the paths are counted from that many sources only and scaled up to the vertex count.
+class BetweennessCentralityFunction : public TableFunction {
+public:
+	BetweennessCentralityFunction() {
+		name = "betweenness_centrality";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["samples"] = LogicalType::BIGINT;
+		named_parameters["normalized"] = LogicalType::BOOLEAN;
+		bind_replace = BetweennessCentralityBindReplace;
+	}
+
+	static unique_ptr<TableRef> BetweennessCentralityBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+//! closeness_centrality(pg, vertex_label, edge_label, samples := NULL) scores every vertex by the distances of the
+//! vertices that reach it along the edges, scaled by the fraction of vertices that reach it. With samples the
+//! distances are summed from that many sources only and scaled up to the vertex count.
+class ClosenessCentralityFunction : public TableFunction {
+public:
+	ClosenessCentralityFunction() {
+		name = "closeness_centrality";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["samples"] = LogicalType::BIGINT;
+		bind_replace = ClosenessCentralityBindReplace;
+	}
+
+	static unique_ptr<TableRef> ClosenessCentralityBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+//! harmonic_centrality(pg, vertex_label, edge_label, samples := NULL) sums the inverse distances of the vertices that
+//! reach every vertex along the edges, sampled like closeness_centrality
+class HarmonicCentralityFunction : public TableFunction {
+public:
+	HarmonicCentralityFunction() {
+		name = "harmonic_centrality";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["samples"] = LogicalType::BIGINT;
+		bind_replace = HarmonicCentralityBindReplace;
+	}
+
+	static unique_ptr<TableRef> HarmonicCentralityBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
@@ -0,0 +1,48 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/community_detection.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+//! label_propagation(pg, vertex_label, edge_label, seed := 0, max_iterations := 100, weight := NULL) returns the
+//! community of every vertex, labelled by its smallest dense vertex id, with the modularity of the communities and the
+//! milliseconds it took to find them. Edges are undirected, weighted by the weight column of the edge table if given.
+class LabelPropagationFunction : public TableFunction {
+public:
+	LabelPropagationFunction() {
+		name = "label_propagation";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["seed"] = LogicalType::BIGINT;
+		named_parameters["max_iterations"] = LogicalType::BIGINT;
+		named_parameters["weight"] = LogicalType::VARCHAR;
+		bind_replace = LabelPropagationBindReplace;
+	}
+
+	static unique_ptr<TableRef> LabelPropagationBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+//! leiden(pg, vertex_label, edge_label, seed := 0, resolution := 1.0, max_iterations := 10, weight := NULL) returns
+//! the same columns as label_propagation, for the communities Leiden finds maximizing the modularity
+class LeidenFunction : public TableFunction {
+public:
+	LeidenFunction() {
+		name = "leiden";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["seed"] = LogicalType::BIGINT;
+		named_parameters["resolution"] = LogicalType::DOUBLE;
+		named_parameters["max_iterations"] = LogicalType::BIGINT;
+		named_parameters["weight"] = LogicalType::VARCHAR;
+		bind_replace = LeidenBindReplace;
+	}
+
+	static unique_ptr<TableRef> LeidenBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/degree.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+// Without csr_id the degree table functions build a dense CSR of the edge label and drop it when the query ends. The
+// build fills a vertex dictionary and scans the edges twice, once to count and once to place them, so this form is
+// slower than a GROUP BY on the edge table and only there for convenience. With csr_id := id they scan the vertex
+// table and call the degree scalar per row, which reads two offsets of a CSR the user built and keeps over the rowids
+// of the vertex table (in_degree and degree also build its transpose once). Only that form avoids the edges.
+
+//! degree(pg, vertex_label, edge_label, csr_id := NULL) returns the number of edges into and out of every vertex
+class DegreeFunction : public TableFunction {
+public:
+	DegreeFunction() {
+		name = "degree";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["csr_id"] = LogicalType::INTEGER;
+		bind_replace = DegreeBindReplace;
+	}
+
+	static unique_ptr<TableRef> DegreeBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+//! in_degree(pg, vertex_label, edge_label, csr_id := NULL) returns the number of edges into every vertex
+class InDegreeFunction : public TableFunction {
+public:
+	InDegreeFunction() {
+		name = "in_degree";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["csr_id"] = LogicalType::INTEGER;
+		bind_replace = InDegreeBindReplace;
+	}
+
+	static unique_ptr<TableRef> InDegreeBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+//! out_degree(pg, vertex_label, edge_label, csr_id := NULL) returns the number of edges out of every vertex
+class OutDegreeFunction : public TableFunction {
+public:
+	OutDegreeFunction() {
+		name = "out_degree";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["csr_id"] = LogicalType::INTEGER;
+		bind_replace = OutDegreeBindReplace;
+	}
+
+	static unique_ptr<TableRef> OutDegreeBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/k_core.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+//! k_core(pg, vertex_label, edge_label) returns the core number of every vertex, the largest k such that the vertex
+//! belongs to a subgraph in which every vertex has at least k neighbours. Edges are undirected.
+class KCoreFunction : public TableFunction {
+public:
+	KCoreFunction() {
+		name = "k_core";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		bind_replace = KCoreBindReplace;
+	}
+
+	static unique_ptr<TableRef> KCoreBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
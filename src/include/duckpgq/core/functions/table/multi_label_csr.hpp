@@ -0,0 +1,28 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/multi_label_csr.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+//! Builds one CSR over several edge labels of a property graph and returns the vertex dictionary and dense id offset
+//! of every vertex table and the key its edges reference it by. The global id of a vertex used by
+//! iterativelength_labeled is vertex_offset + vertex_dictionary_lookup(vertex_dictionary, vertex_key columns).
+class CreateMultiLabelCSRFunction : public TableFunction {
+public:
+	CreateMultiLabelCSRFunction() {
+		name = "create_multi_label_csr";
+		arguments = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::LIST(LogicalType::VARCHAR)};
+		bind_replace = CreateMultiLabelCSRBindReplace;
+	}
+
+	static unique_ptr<TableRef> CreateMultiLabelCSRBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
@@ -15,6 +15,11 @@ public:
 	PageRankFunction() {
 		name = "pagerank";
 		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		named_parameters["damping"] = LogicalType::DOUBLE;
+		named_parameters["tolerance"] = LogicalType::DOUBLE;
+		named_parameters["max_iterations"] = LogicalType::BIGINT;
+		//! Edge table column holding the edge weights, unweighted when not given
+		named_parameters["weight"] = LogicalType::VARCHAR;
 		bind_replace = PageRankBindReplace;
 	}
 
@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/personalized_pagerank.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+#define PERSONALIZED_PAGERANK_DEFAULT_ALPHA 0.15
+#define PERSONALIZED_PAGERANK_DEFAULT_EPSILON 1e-4
+#define PERSONALIZED_PAGERANK_DEFAULT_TOP_K 10
+
+//! personalized_pagerank(pg, vertex_label, edge_label, seeds) returns the top_k vertices by random walk with restart
+//! score for every seed key in the list, as (seed, vertex, score) rows
+class PersonalizedPageRankFunction : public TableFunction {
+public:
+	PersonalizedPageRankFunction() {
+		name = "personalized_pagerank";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::ANY};
+		//! Restart probability of the walks
+		named_parameters["alpha"] = LogicalType::DOUBLE;
+		named_parameters["epsilon"] = LogicalType::DOUBLE;
+		named_parameters["top_k"] = LogicalType::BIGINT;
+		//! push (approximate, local) or power (exact up to epsilon, 32 seeds per pass over the graph)
+		named_parameters["method"] = LogicalType::VARCHAR;
+		bind_replace = PersonalizedPageRankBindReplace;
+	}
+
+	static unique_ptr<TableRef> PersonalizedPageRankBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
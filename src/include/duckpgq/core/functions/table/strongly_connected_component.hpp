@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/strongly_connected_component.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+//! strongly_connected_component(pg, vertex_label, edge_label) labels every vertex with the smallest dense vertex id,
+//! the rank of its key, of its strongly connected component, following the edges in their direction
+class StronglyConnectedComponentFunction : public TableFunction {
+public:
+	StronglyConnectedComponentFunction() {
+		name = "strongly_connected_component";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		bind_replace = StronglyConnectedComponentBindReplace;
+	}
+
+	static unique_ptr<TableRef> StronglyConnectedComponentBindReplace(ClientContext &context,
+	                                                                  TableFunctionBindInput &input);
+};
+
+//! strongly_connected_component_condensation(pg, vertex_label, edge_label) returns the edges of the condensation DAG
+//! as (source_component, destination_component) rows, using the component labels of strongly_connected_component
+class StronglyConnectedComponentCondensationFunction : public TableFunction {
+public:
+	StronglyConnectedComponentCondensationFunction() {
+		name = "strongly_connected_component_condensation";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		bind_replace = StronglyConnectedComponentCondensationBindReplace;
+	}
+
+	static unique_ptr<TableRef> StronglyConnectedComponentCondensationBindReplace(ClientContext &context,
+	                                                                              TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
@@ -9,15 +9,29 @@
 #pragma once
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/parser/parsed_data/create_property_graph_info.hpp"
+#include "duckdb/parser/query_node/select_node.hpp"
 #include "duckpgq/common.hpp"
 
 namespace duckdb {
 
+//! How summarize_property_graph computes the edge table statistics
+enum class SummarizeMode : uint8_t {
+	//! Aggregate queries over every edge table
+	SQL,
+	//! One pass over a multi-label CSR of all edge tables, with exact quantiles and self-loops
+	CSR,
+	//! One aggregate scan per edge table, isolated vertices are estimated without the anti-joins
+	APPROXIMATE
+};
+
+SummarizeMode ParseSummarizeMode(const string &mode);
+
 class SummarizePropertyGraphFunction : public TableFunction {
 public:
 	SummarizePropertyGraphFunction() {
 		name = "summarize_property_graph";
 		arguments.push_back(LogicalType::VARCHAR);
+		named_parameters["mode"] = LogicalType::VARCHAR;
 		bind_replace = SummarizePropertyGraphBindReplace;
 	}
 
@@ -49,6 +63,12 @@ public:
 	static unique_ptr<CommonTableExpressionInfo>
 	CreateVertexTableCTE(const shared_ptr<PropertyGraphTable> &vertex_table);
 	static unique_ptr<CommonTableExpressionInfo> CreateEdgeTableCTE(shared_ptr<PropertyGraphTable> &edge_table);
+	//! The edge table row of mode := 'approximate', every statistic comes from one aggregate over the edge table
+	static unique_ptr<CommonTableExpressionInfo>
+	CreateApproximateEdgeTableCTE(const shared_ptr<PropertyGraphTable> &edge_table);
+	//! The edge table rows of mode := 'csr', computed by summarize_csr over one multi-label CSR of all edge tables
+	static unique_ptr<SelectNode> CreateCSRSummaryNode(CreatePropertyGraphInfo &pg_info);
+	static unique_ptr<TableRef> SummarizePropertyGraphCSR(CreatePropertyGraphInfo &pg_info);
 
 	static unique_ptr<TableRef> HandleSingleVertexTable(const shared_ptr<PropertyGraphTable> &vertex_table,
 	                                                    const string &stat_table_alias);
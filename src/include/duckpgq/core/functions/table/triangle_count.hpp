@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/functions/table/triangle_count.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+#define APPROXIMATE_TRIANGLE_DEFAULT_ERROR 0.01
+#define APPROXIMATE_TRIANGLE_DEFAULT_CONFIDENCE 0.95
+
+//! triangle_count(pg, vertex_label, edge_label) returns the number of triangles of the graph, edges taken undirected
+class TriangleCountFunction : public TableFunction {
+public:
+	TriangleCountFunction() {
+		name = "triangle_count";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		bind_replace = TriangleCountBindReplace;
+	}
+
+	static unique_ptr<TableRef> TriangleCountBindReplace(ClientContext &context, TableFunctionBindInput &input);
+};
+
+//! global_clustering_coefficient(pg, vertex_label, edge_label) returns the transitivity of the graph: three times
+//! the triangles over the wedges (pairs of edges sharing a vertex)
+class GlobalClusteringCoefficientFunction : public TableFunction {
+public:
+	GlobalClusteringCoefficientFunction() {
+		name = "global_clustering_coefficient";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		bind_replace = GlobalClusteringCoefficientBindReplace;
+	}
+
+	static unique_ptr<TableRef> GlobalClusteringCoefficientBindReplace(ClientContext &context,
+	                                                                   TableFunctionBindInput &input);
+};
+
+//! approximate_triangle_count(pg, vertex_label, edge_label) estimates the triangles by wedge sampling, with a
+//! confidence interval, as a single (triangle_count, lower_bound, upper_bound, global_clustering_coefficient, samples,
+//! error_met) row. error_met is false when sampling stopped before the interval was within error of the estimate.
+class ApproximateTriangleCountFunction : public TableFunction {
+public:
+	ApproximateTriangleCountFunction() {
+		name = "approximate_triangle_count";
+		arguments = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR};
+		//! Relative half-width of the confidence interval to sample for
+		named_parameters["error"] = LogicalType::DOUBLE;
+		named_parameters["confidence"] = LogicalType::DOUBLE;
+		bind_replace = ApproximateTriangleCountBindReplace;
+	}
+
+	static unique_ptr<TableRef> ApproximateTriangleCountBindReplace(ClientContext &context,
+	                                                                TableFunctionBindInput &input);
+};
+
+} // namespace duckdb
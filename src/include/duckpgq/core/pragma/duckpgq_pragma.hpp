@@ -17,11 +17,16 @@ public:
 	static void Register(ExtensionLoader &loader) {
 		RegisterShowPropertyGraphs(loader);
 		RegisterCreateVertexTable(loader);
+		RegisterCreateProjection(loader);
 	}
 
 private:
 	static void RegisterShowPropertyGraphs(ExtensionLoader &loader);
 	static void RegisterCreateVertexTable(ExtensionLoader &loader);
+	//! Materializes a filtered subgraph as a new property graph that the analytics functions can target. The
+	//! projection is a copy in new tables <projection>_<table>, it does not follow later changes to the source tables
+	//! and fails instead of replacing existing tables or graphs.
+	static void RegisterCreateProjection(ExtensionLoader &loader);
 };
 
 } // namespace duckdb
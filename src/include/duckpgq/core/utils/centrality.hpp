@@ -0,0 +1,48 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/centrality.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+//! State the concurrent batches of sources may allocate, graphs too large for LANE_LIMIT lanes run narrower batches
+#define CENTRALITY_BATCH_BYTES (1 << 28)
+//! Batches are narrowed to spread few sources over the threads, but not below this many lanes
+#define CENTRALITY_MIN_BATCH_LANES 64
+//! Sampled sources are drawn with a fixed seed, so repeated runs agree
+#define CENTRALITY_SAMPLE_SEED 0
+
+//! Internal ids of the sources of a centrality run: every vertex, or sample_count rowids drawn uniformly without
+//! replacement when 0 < sample_count < vertex count
+vector<int64_t> SelectCentralitySources(const CSR &csr, int64_t sample_count);
+
+//! Splits sources into batches of at most LANE_LIMIT lanes and runs fun(batch_sources, lanes) for every batch on the
+//! task scheduler. A batch holds its LaneBfs and vertex_bytes per vertex, plus lane_bytes per vertex and lane, and the
+//! batches running at the same time hold at most CENTRALITY_BATCH_BYTES together.
+void ForEachSourceBatch(ClientContext &context, int64_t vertex_count, const vector<int64_t> &sources,
+                        idx_t vertex_bytes, idx_t lane_bytes, const std::function<void(const int64_t *, idx_t)> &fun);
+
+//! Brandes betweenness centrality of every vertex of a compacted CSR, following the edges in their direction.
+//! Every batch of sources runs one lane-parallel BFS that counts shortest paths, then accumulates the dependencies
+//! level by level from the deepest back to the sources. With sample_count sources out of n the scores are scaled
+//! by n / sample_count, normalized divides them by (n - 1)(n - 2).
+vector<double> BetweennessCentrality(ClientContext &context, const CSR &csr, int64_t sample_count, bool normalized);
+
+//! Closeness centrality of every vertex of a compacted CSR from the distances of the vertices that reach it,
+//! (r / d) * (r / (n - 1)) for r such vertices at total distance d, and 0 when no other vertex reaches it.
+//! Every batch of sources runs one lane-parallel BFS and adds, per level, the lanes that reached a vertex times the
+//! level to its distance sum. With sample_count sources the sums are estimated by scaling them by n / sample_count.
+vector<double> ClosenessCentrality(ClientContext &context, const CSR &csr, int64_t sample_count);
+//! Sum of the inverse distances of the vertices that reach every vertex, estimated like ClosenessCentrality
+vector<double> HarmonicCentrality(ClientContext &context, const CSR &csr, int64_t sample_count);
+
+} // namespace duckdb
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/community_detection.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+
+namespace duckdb {
+
+//! Local moving splits the vertices into this many phases by a seeded hash, the vertices of one phase move at once
+#define LEIDEN_MOVE_PHASES 4
+//! Local moving stops after this many rounds over all phases, even if vertices are still moving
+#define LEIDEN_MAX_MOVE_ROUNDS 64
+
+//! Undirected weighted view of a CSR for community detection. Every directed edge (u, v) adds its weight to both
+//! A(u, v) and A(v, u), a self-loop adds twice its weight to A(u, u). Lists are sorted by target and hold every
+//! target once.
+struct CommunityGraph {
+	vector<int64_t> offsets;
+	vector<int64_t> targets;
+	vector<double> weights;
+	//! Row sums of A
+	vector<double> degree;
+	//! Sum of all entries of A, twice the total edge weight
+	double total_weight = 0;
+
+	int64_t VertexCount() const {
+		return static_cast<int64_t>(degree.size());
+	}
+};
+
+//! The CSR as a CommunityGraph, weighted by w_double or w when the CSR has weights
+CommunityGraph BuildCommunityGraph(ClientContext &context, const CSR &csr);
+
+//! Label propagation: every vertex adopts the label of the largest neighbour weight, keeping its own label on ties
+//! and otherwise preferring the label with the smallest seeded hash. Each iteration updates two halves of the
+//! vertices, chosen by a seeded hash, one after the other, every half in parallel from the labels of the previous
+//! half, so the labels do not depend on the number of threads and do not oscillate between neighbours.
+vector<int64_t> LabelPropagation(ClientContext &context, const CommunityGraph &graph, uint64_t seed,
+                                 int64_t max_iterations);
+
+//! Leiden (Traag et al.) maximizing modularity with the given resolution: local moving, refinement of every
+//! community into well-connected subcommunities, and aggregation of the refined partition, for at most
+//! max_iterations levels. Local moving runs LEIDEN_MOVE_PHASES seeded phases in parallel per round, refinement
+//! handles the communities in parallel and greedily merges every vertex into the subcommunity of largest gain.
+vector<int64_t> Leiden(ClientContext &context, const CommunityGraph &graph, uint64_t seed, double resolution,
+                       int64_t max_iterations);
+
+//! Modularity of the partition of the graph into community, community ids are any values in [0, vertex count)
+double Modularity(ClientContext &context, const CommunityGraph &graph, const vector<int64_t> &community,
+                  double resolution);
+
+} // namespace duckdb
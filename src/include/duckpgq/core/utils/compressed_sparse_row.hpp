@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #pragma once
+#include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/function/function.hpp"
 
 #include "duckdb/parser/expression/cast_expression.hpp"
@@ -15,13 +16,103 @@
 #include "duckdb/parser/query_node/set_operation_node.hpp"
 
 #include "duckdb/parser/expression/columnref_expression.hpp"
+#include "duckdb/parser/parsed_data/create_property_graph_info.hpp"
 #include "duckdb/parser/property_graph_table.hpp"
 #include "duckdb/parser/query_node/select_node.hpp"
 #include "duckdb/parser/tableref/joinref.hpp"
 #include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/csr_edge_property.hpp"
+#include "duckpgq/core/utils/duckpgq_bitmap.hpp"
+
+#include <algorithm>
+#include <condition_variable>
 
 namespace duckdb {
 
+#define DEFAULT_DELTA_COMPACTION_THRESHOLD 4096
+//! Edge labels are selected with a BIGINT bit mask
+#define CSR_MAX_EDGE_LABELS 64
+//! Vertex dictionaries of a CSR builder use the ids -1 - (csr_id * CSR_MAX_VERTEX_TABLES + vertex table index)
+#define CSR_MAX_VERTEX_TABLES 64
+//! Lower bound on the degree of a hub vertex when the threshold is derived from the vertex count
+#define DEFAULT_HUB_MIN_DEGREE 64
+//! Time of edges whose time property is NULL, it sorts last and falls outside every window
+#define CSR_NO_EDGE_TIME NumericLimits<int64_t>::Maximum()
+
+//! Vertex relabeling applied to a built CSR to improve the locality of neighbour accesses
+enum class CSRReorderMethod : uint8_t {
+	NONE,
+	//! Vertices by descending out-degree, hubs share the first cache lines of visit/seen
+	DEGREE,
+	//! Reverse Cuthill-McKee, keeps the ids of neighbouring vertices close together
+	RCM
+};
+
+CSRReorderMethod ParseCSRReorderMethod(const string &method);
+
+//! An edge appended to a CSR after it has been built
+struct CSRDeltaEdge {
+	int64_t dst;
+	int64_t edge_id;
+	int64_t w;
+	double w_double;
+};
+
+//! In-edges of every vertex, laid out like v/e of the CSR it was built from. The sources of every vertex are in
+//! ascending order, offsets[i] is the position of in-edge i in e so edge weights and properties are shared.
+struct CSRTranspose {
+	vector<int64_t> v;
+	vector<int64_t> e;
+	vector<int64_t> offsets;
+
+	idx_t EdgeCount() const {
+		return e.size();
+	}
+	int64_t Degree(int64_t vertex) const {
+		return v[vertex + 1] - v[vertex];
+	}
+	//! Calls fun(src, offset) for every edge src -> vertex, offset is the position of the edge in e of the CSR
+	template <class FUNC>
+	void ForEachInEdge(int64_t vertex, FUNC &&fun) const {
+		for (auto i = v[vertex]; i < v[vertex + 1]; i++) {
+			fun(e[i], offsets[i]);
+		}
+	}
+};
+
+//! Readers/writer lock of a CSR. Kernels hold shared access while they read v/e and the delta, Compact and the
+//! other rebuilds wait until no reader is left. Readers never queue behind a waiting writer, so shared access nests.
+class CSRAccessLock {
+public:
+	void LockShared() {
+		unique_lock<mutex> guard(lock);
+		released.wait(guard, [&]() { return !writer; });
+		readers++;
+	}
+	void UnlockShared() {
+		lock_guard<mutex> guard(lock);
+		if (--readers == 0) {
+			released.notify_all();
+		}
+	}
+	void Lock() {
+		unique_lock<mutex> guard(lock);
+		released.wait(guard, [&]() { return !writer && readers == 0; });
+		writer = true;
+	}
+	void Unlock() {
+		lock_guard<mutex> guard(lock);
+		writer = false;
+		released.notify_all();
+	}
+
+private:
+	mutex lock;
+	std::condition_variable released;
+	idx_t readers = 0;
+	bool writer = false;
+};
+
 class CSR {
 public:
 	CSR() = default;
@@ -37,13 +128,344 @@ public:
 	vector<int64_t> w;
 	vector<double> w_double;
 
+	//! Label tag of every edge in e, only filled for CSRs built over several edge tables
+	vector<uint8_t> edge_labels;
+
 	bool initialized_v = false;
 	bool initialized_e = false;
 	bool initialized_w = false;
+	bool initialized_labels = false;
+	//! Built by create_csr_edge_symmetric, every base edge is stored in both directions
+	bool symmetric = false;
 
 	size_t vsize {};
 
+	//! Edges appended since the last (re)build, grouped per source vertex so a traversal only looks up the delta
+	//! edges of its frontier
+	unordered_map<int64_t, vector<CSRDeltaEdge>> delta;
+	atomic<idx_t> delta_size {0};
+	//! Once the delta holds this many edges it is merged into v/e
+	idx_t compaction_threshold = DEFAULT_DELTA_COMPACTION_THRESHOLD;
+	//! Shared by the kernels reading the CSR, exclusive for AppendEdge, Compact, Reorder, BuildHubRows and
+	//! BuildTemporalIndex. Take it through CSRReadGuard, never while calling one of the writers.
+	mutable CSRAccessLock access_lock;
+
+	//! Relabeling of the vertices, empty while the dense ids are still the rowids.
+	//! perm maps a rowid to its vertex in v, inv_perm maps a vertex in v back to its rowid.
+	vector<int64_t> perm;
+	vector<int64_t> inv_perm;
+	//! Set once the vertex_reordering setting has been applied to this CSR
+	atomic<bool> reorder_checked {false};
+
+	//! Neighbour bitmaps of the high-degree vertices, built next to their adjacency lists in e.
+	//! hub_slot[vertex] indexes hub_rows, or is -1 for a vertex without a bitmap row.
+	vector<int64_t> hub_slot;
+	vector<DuckPGQBitmap> hub_rows;
+	//! Set once the hub_degree_threshold setting has been applied to this CSR
+	atomic<bool> hub_rows_checked {false};
+
+	//! Edge property columns aligned with e, see SetEdgeProperty
+	case_insensitive_map_t<unique_ptr<CSREdgeProperty>> edge_properties;
+	std::mutex property_lock;
+
+	//! Time of every edge in e, each adjacency list sorted by it. Edges without a time hold CSR_NO_EDGE_TIME.
+	vector<int64_t> edge_times;
+	bool initialized_times = false;
+	//! Edge property the temporal index was built from, Compact rebuilds the index from it
+	string time_property;
+
+	//! Built lazily by GetTranspose, dropped whenever the base arrays change
+	unique_ptr<CSRTranspose> transpose;
+	std::mutex transpose_lock;
+
+	//! Buffer a new edge, compacting the delta once it passes the threshold. Returns the delta size.
+	idx_t AppendEdge(int64_t src, int64_t dst, int64_t edge_id, int64_t weight = 0, double weight_double = 0);
+	//! Merge the delta into the base arrays once no kernel reads the CSR. Returns the number of edges that were
+	//! merged. A temporal index is rebuilt, the merged edges have no time and sort last.
+	idx_t Compact();
+
+	//! Relabel the vertices, compacting the delta first. Reordering twice composes the permutations.
+	void Reorder(CSRReorderMethod method);
+
+	//! Give every vertex with at least degree_threshold neighbours a bitmap row. A threshold of 0 picks the degree
+	//! at which the bitmap becomes smaller than the adjacency list, a negative threshold drops all rows.
+	void BuildHubRows(int64_t degree_threshold);
+	//! Drop the bitmap rows, they are rebuilt lazily after the base arrays change
+	void ClearHubRows();
+	const DuckPGQBitmap *GetHubRow(int64_t vertex) const {
+		if (hub_slot.empty() || hub_slot[vertex] < 0) {
+			return nullptr;
+		}
+		return &hub_rows[hub_slot[vertex]];
+	}
+	//! Transpose of the base arrays, built on first use. Edges in the delta are not part of it.
+	const CSRTranspose &GetTranspose();
+	//! Whether the edge (src, dst) exists in the base arrays or the delta, both given as vertex ids of v/e
+	bool HasEdge(int64_t src, int64_t dst) const;
+	//! Edge rowid of the first (src, dst) edge in the base arrays, then the delta. -1 when there is none.
+	int64_t FindEdgeId(int64_t src, int64_t dst) const;
+
+	//! Store a property value for every edge in e with the given edge rowid, an undirected edge gets it in both
+	//! directions. Edges in the delta have no property values. found[i] tells whether row i matched an edge.
+	void SetEdgeProperty(const string &name, Vector &edge_rowids, Vector &values, idx_t count, bool *found);
+	//! Throws when no property with this name was attached
+	const CSREdgeProperty &GetEdgeProperty(const string &name) const;
+
+	//! Sort every adjacency list by an integral edge property such as a BIGINT, DATE or TIMESTAMP column, keeping
+	//! the times in edge_times. Compacts the delta first, later compactions rebuild the index.
+	void BuildTemporalIndex(const string &property);
+	//! Offsets [begin, end) of the edges of vertex with a time in [start, end], found by binary search
+	void TimeWindow(int64_t vertex, int64_t start, int64_t end, int64_t &begin_offset, int64_t &end_offset) const {
+		auto offsets = reinterpret_cast<int64_t *>(v);
+		auto first = edge_times.begin() + offsets[vertex];
+		auto last = edge_times.begin() + offsets[vertex + 1];
+		begin_offset = std::lower_bound(first, last, start) - edge_times.begin();
+		end_offset = std::upper_bound(first, last, end) - edge_times.begin();
+	}
+
+	int64_t VertexCount() const {
+		return static_cast<int64_t>(vsize) - 2;
+	}
+	//! Edges in the base arrays and the delta
+	idx_t EdgeCount() const {
+		return e.size() + delta_size;
+	}
+	bool HasDelta() const {
+		return delta_size > 0;
+	}
+	//! Out-degree of vertex in the base arrays
+	int64_t Degree(int64_t vertex) const {
+		auto offsets = reinterpret_cast<int64_t *>(v);
+		return offsets[vertex + 1] - offsets[vertex];
+	}
+
+	//! Translate a rowid into the vertex id used by v/e
+	int64_t ToInternal(int64_t vertex) const {
+		if (perm.empty() || vertex < 0 || vertex >= static_cast<int64_t>(perm.size())) {
+			return vertex;
+		}
+		return perm[vertex];
+	}
+	//! Translate a vertex id of v/e back into its rowid
+	int64_t ToExternal(int64_t vertex) const {
+		if (inv_perm.empty() || vertex < 0 || vertex >= static_cast<int64_t>(inv_perm.size())) {
+			return vertex;
+		}
+		return inv_perm[vertex];
+	}
+
+	//! Calls fun(dst) for every neighbour of vertex stored in the base arrays
+	template <class FUNC>
+	void ForEachNeighbor(int64_t vertex, FUNC &&fun) const {
+		auto offsets = reinterpret_cast<int64_t *>(v);
+		for (auto offset = offsets[vertex]; offset < offsets[vertex + 1]; offset++) {
+			fun(e[offset]);
+		}
+	}
+
+	//! Calls fun(src, delta_edge) for every buffered edge. Kernels call this after scanning v/e.
+	template <class FUNC>
+	void ForEachDeltaEdge(FUNC &&fun) const {
+		for (auto &entry : delta) {
+			for (auto &edge : entry.second) {
+				fun(entry.first, edge);
+			}
+		}
+	}
+	//! Calls fun(delta_edge) for every buffered edge leaving vertex
+	template <class FUNC>
+	void ForEachDeltaNeighbor(int64_t vertex, FUNC &&fun) const {
+		auto entry = delta.find(vertex);
+		if (entry == delta.end()) {
+			return;
+		}
+		for (auto &edge : entry->second) {
+			fun(edge);
+		}
+	}
+
 	string ToString() const;
+
+private:
+	//! Offsets in e grouped by edge rowid, laid out like v/e. Built by the first SetEdgeProperty.
+	vector<int64_t> edge_rowid_offsets;
+	vector<int64_t> edge_rowid_positions;
+
+	void BuildEdgeRowidIndex();
+	//! Bodies of Compact and BuildTemporalIndex, the caller holds access_lock exclusively
+	idx_t CompactLocked();
+	void BuildTemporalIndexLocked(const string &property);
+	//! Move the property columns along after the edges moved, source[i] is the old offset of edge i or -1
+	void GatherEdgeProperties(const vector<int64_t> &source);
+	//! Reorder the edges within their adjacency lists, new offset i takes the edge at old offset source[i]
+	void PermuteEdges(const vector<int64_t> &source);
+	//! Drop the transpose after the base arrays changed
+	void ResetTranspose();
+};
+
+//! View of a multi-label CSR that only exposes the edges whose label bit is set in the mask.
+//! Appended delta edges carry label 0.
+struct CSRLabelView {
+	CSRLabelView(const CSR &csr, uint64_t label_mask) : csr(csr), label_mask(label_mask) {
+	}
+
+	const CSR &csr;
+	const uint64_t label_mask;
+
+	int64_t ToInternal(int64_t vertex) const {
+		return csr.ToInternal(vertex);
+	}
+	//! Upper bounds of the view, used by the traversal cost model
+	idx_t EdgeCount() const {
+		return csr.EdgeCount();
+	}
+	int64_t Degree(int64_t vertex) const {
+		return csr.Degree(vertex);
+	}
+
+	template <class FUNC>
+	void ForEachNeighbor(int64_t vertex, FUNC &&fun) const {
+		auto offsets = reinterpret_cast<int64_t *>(csr.v);
+		for (auto offset = offsets[vertex]; offset < offsets[vertex + 1]; offset++) {
+			if ((label_mask >> csr.edge_labels[offset]) & 1) {
+				fun(csr.e[offset]);
+			}
+		}
+	}
+
+	template <class FUNC>
+	void ForEachDeltaEdge(FUNC &&fun) const {
+		if (label_mask & 1) {
+			csr.ForEachDeltaEdge(fun);
+		}
+	}
+	bool HasDelta() const {
+		return (label_mask & 1) && csr.HasDelta();
+	}
+	template <class FUNC>
+	void ForEachDeltaNeighbor(int64_t vertex, FUNC &&fun) const {
+		if (label_mask & 1) {
+			csr.ForEachDeltaNeighbor(vertex, fun);
+		}
+	}
+};
+
+//! View of a CSR that only exposes the edges whose bit is set in the mask, see CSREdgeProperty::Evaluate.
+//! Appended delta edges carry no properties and never pass a filter.
+struct CSREdgeMaskView {
+	CSREdgeMaskView(const CSR &csr, const DuckPGQBitmap &mask) : csr(csr), mask(mask) {
+	}
+
+	const CSR &csr;
+	const DuckPGQBitmap &mask;
+
+	int64_t ToInternal(int64_t vertex) const {
+		return csr.ToInternal(vertex);
+	}
+	//! Upper bounds of the view, used by the traversal cost model
+	idx_t EdgeCount() const {
+		return csr.EdgeCount();
+	}
+	int64_t Degree(int64_t vertex) const {
+		return csr.Degree(vertex);
+	}
+
+	template <class FUNC>
+	void ForEachNeighbor(int64_t vertex, FUNC &&fun) const {
+		auto offsets = reinterpret_cast<int64_t *>(csr.v);
+		for (auto offset = offsets[vertex]; offset < offsets[vertex + 1]; offset++) {
+			if (mask.test(offset)) {
+				fun(csr.e[offset]);
+			}
+		}
+	}
+
+	template <class FUNC>
+	void ForEachDeltaEdge(FUNC &&fun) const {
+	}
+	bool HasDelta() const {
+		return false;
+	}
+	template <class FUNC>
+	void ForEachDeltaNeighbor(int64_t vertex, FUNC &&fun) const {
+	}
+};
+
+//! View of a temporally indexed CSR that only exposes the edges with a time in [start, end].
+//! Appended delta edges have no time and are never exposed.
+struct CSRTimeWindowView {
+	CSRTimeWindowView(const CSR &csr, int64_t start, int64_t end) : csr(csr), start(start), end(end) {
+	}
+
+	const CSR &csr;
+	const int64_t start;
+	const int64_t end;
+
+	int64_t ToInternal(int64_t vertex) const {
+		return csr.ToInternal(vertex);
+	}
+	//! Upper bounds of the view, used by the traversal cost model
+	idx_t EdgeCount() const {
+		return csr.EdgeCount();
+	}
+	int64_t Degree(int64_t vertex) const {
+		return csr.Degree(vertex);
+	}
+
+	template <class FUNC>
+	void ForEachNeighbor(int64_t vertex, FUNC &&fun) const {
+		int64_t begin_offset;
+		int64_t end_offset;
+		csr.TimeWindow(vertex, start, end, begin_offset, end_offset);
+		for (auto offset = begin_offset; offset < end_offset; offset++) {
+			fun(csr.e[offset]);
+		}
+	}
+
+	template <class FUNC>
+	void ForEachDeltaEdge(FUNC &&fun) const {
+	}
+	bool HasDelta() const {
+		return false;
+	}
+	template <class FUNC>
+	void ForEachDeltaNeighbor(int64_t vertex, FUNC &&fun) const {
+	}
+};
+
+//! Shared access to a CSR for the lifetime of the guard
+class CSRReadGuard {
+public:
+	explicit CSRReadGuard(const CSR &csr) : CSRReadGuard(csr.access_lock) {
+	}
+	//! For the other graph stores that share the CSR locking scheme
+	explicit CSRReadGuard(CSRAccessLock &access_lock_p) : access_lock(access_lock_p) {
+		access_lock.LockShared();
+	}
+	~CSRReadGuard() {
+		access_lock.UnlockShared();
+	}
+	CSRReadGuard(const CSRReadGuard &) = delete;
+	CSRReadGuard &operator=(const CSRReadGuard &) = delete;
+
+private:
+	CSRAccessLock &access_lock;
+};
+
+//! Exclusive access to a CSR for the lifetime of the guard
+class CSRWriteGuard {
+public:
+	explicit CSRWriteGuard(CSRAccessLock &access_lock_p) : access_lock(access_lock_p) {
+		access_lock.Lock();
+	}
+	~CSRWriteGuard() {
+		access_lock.Unlock();
+	}
+	CSRWriteGuard(const CSRWriteGuard &) = delete;
+	CSRWriteGuard &operator=(const CSRWriteGuard &) = delete;
+
+private:
+	CSRAccessLock &access_lock;
 };
 
 struct CSRFunctionData : FunctionData {
@@ -62,29 +484,84 @@ struct CSRFunctionData : FunctionData {
 	const LogicalType weight_type;
 };
 
+//! A vertex table of a CSR build numbered through a vertex dictionary on the key the edge tables reference it by
+struct CSRVertexTable {
+	shared_ptr<PropertyGraphTable> table;
+	vector<string> key_columns;
+	int32_t dictionary_id;
+};
+
 // CSR BindReplace functions
+//! Reciprocal pairs and parallel edges collapse into a single undirected edge. Raises an error when the keys the
+//! edges reference are not unique.
 unique_ptr<CommonTableExpressionInfo> CreateUndirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
                                                              const unique_ptr<SelectNode> &select_node);
+//! A non-empty weight_column stores that column of the edge table as DOUBLE edge weights
 unique_ptr<CommonTableExpressionInfo> CreateDirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
                                                            const string &prev_binding, const string &edge_binding,
-                                                           const string &next_binding);
+                                                           const string &next_binding,
+                                                           const string &weight_column = "");
+//! The dense variants number the vertices by their rank in a vertex dictionary on the referenced key, so gaps in the
+//! rowids of deleted vertices leave no empty vertices behind. The rowid variants serve MATCH, whose paths are rowids.
+unique_ptr<CommonTableExpressionInfo> CreateDenseUndirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
+                                                                  const unique_ptr<SelectNode> &select_node);
+unique_ptr<CommonTableExpressionInfo> CreateDenseDirectedCSRCTE(const shared_ptr<PropertyGraphTable> &edge_table,
+                                                                const unique_ptr<SelectNode> &select_node,
+                                                                const string &weight_column = "");
+//! One CSR over several edge tables. Vertices of all vertex tables share one dense id space, see GetVertexOffset,
+//! and the label of an edge is the position of its edge table in edge_tables.
+unique_ptr<CommonTableExpressionInfo> CreateMultiLabelCSRCTE(CreatePropertyGraphInfo &pg_info,
+                                                             const vector<shared_ptr<PropertyGraphTable>> &edge_tables,
+                                                             int32_t csr_id, const unique_ptr<SelectNode> &select_node);
 
 // Helper functions
 unique_ptr<CommonTableExpressionInfo> MakeEdgesCTE(const shared_ptr<PropertyGraphTable> &edge_table);
 unique_ptr<SubqueryExpression> CreateDirectedCSRVertexSubquery(const shared_ptr<PropertyGraphTable> &edge_table,
                                                                const string &binding);
-unique_ptr<SubqueryExpression> CreateUndirectedCSRVertexSubquery(const shared_ptr<PropertyGraphTable> &edge_table,
-                                                                 const string &binding);
+unique_ptr<CommonTableExpressionInfo> MakeUndirectedEdgesCTE();
+unique_ptr<SubqueryExpression> CreateSymmetricCSRVertexSubquery(unique_ptr<ParsedExpression> vertex_count);
 unique_ptr<SelectNode> CreateOuterSelectEdgesNode();
 unique_ptr<SelectNode> CreateOuterSelectNode(unique_ptr<FunctionExpression> create_csr_edge_function);
 unique_ptr<JoinRef> GetJoinRef(const shared_ptr<PropertyGraphTable> &edge_table, const string &edge_binding,
                                const string &prev_binding, const string &next_binding);
-unique_ptr<SubqueryExpression> GetCountTable(const shared_ptr<PropertyGraphTable> &table, const string &table_alias,
-                                             const string &primary_key);
-void SetupSelectNode(unique_ptr<SelectNode> &select_node, const shared_ptr<PropertyGraphTable> &edge_table,
-                     bool reverse = false);
+//! The vertex count of the CSR of the rowid builders, the rowid range of the source and destination tables
+unique_ptr<ParsedExpression> GetRowidRange(const shared_ptr<PropertyGraphTable> &edge_table);
 unique_ptr<SubqueryRef> CreateCountCTESubquery();
-unique_ptr<SubqueryExpression> GetCountUndirectedEdgeTable();
 unique_ptr<SubqueryExpression> GetCountEdgeTable(const shared_ptr<PropertyGraphTable> &edge_table);
+unique_ptr<SubqueryExpression> GetCountStarTable(const shared_ptr<PropertyGraphTable> &table);
+
+// Dense vertex id helpers
+int32_t GetVertexDictionaryId(int32_t csr_id, idx_t vertex_table_index);
+//! The CSR id a builder dictionary belongs to, -1 for dictionaries created by the user
+int32_t GetVertexDictionaryCSRId(int32_t dictionary_id);
+unique_ptr<ParsedExpression> GetDenseVertexId(int32_t dictionary_id, const vector<string> &key_columns,
+                                              const string &binding);
+//! Index 0 is the source table, destination_index is 1 unless the destination table and key equal the source
+vector<CSRVertexTable> GetEdgeVertexTables(const shared_ptr<PropertyGraphTable> &edge_table, int32_t csr_id,
+                                           idx_t &destination_index);
+//! One entry per vertex table and key referenced by edge_tables, in the order of the vertex tables of pg_info
+vector<CSRVertexTable> GetGraphVertexTables(CreatePropertyGraphInfo &pg_info,
+                                            const vector<shared_ptr<PropertyGraphTable>> &edge_tables,
+                                            int32_t csr_id);
+//! DConstants::INVALID_INDEX when no entry numbers the table by key_columns
+idx_t FindVertexTable(const vector<CSRVertexTable> &vertex_tables, const string &table_name,
+                      const vector<string> &key_columns);
+//! vertex_dictionary_cte, which has to be in scope of every expression returned by the helpers below
+unique_ptr<CommonTableExpressionInfo> MakeVertexDictionaryCTE(const vector<CSRVertexTable> &vertex_tables);
+//! The vertex count of a table, raises a constraint error when its keys are not unique
+unique_ptr<ParsedExpression> GetDenseVertexCount(const CSRVertexTable &vertex_table, idx_t vertex_table_index);
+unique_ptr<ParsedExpression> GetDenseVertexCount(const vector<CSRVertexTable> &vertex_tables);
+unique_ptr<SelectNode> CreateDenseEdgesNode(const shared_ptr<PropertyGraphTable> &edge_table,
+                                            const vector<CSRVertexTable> &vertex_tables, idx_t source_index,
+                                            idx_t destination_index, const string &weight_column = "",
+                                            unique_ptr<ParsedExpression> source_offset = nullptr,
+                                            unique_ptr<ParsedExpression> destination_offset = nullptr);
+unique_ptr<SubqueryExpression> CreateDenseCSRVertexSubquery(int32_t csr_id, unique_ptr<ParsedExpression> vertex_count,
+                                                            const string &edges_cte);
+unique_ptr<SubqueryExpression> GetCountDenseEdges(const string &edges_cte);
+unique_ptr<ParsedExpression> GetVertexOffset(const vector<CSRVertexTable> &vertex_tables, idx_t vertex_table_index);
+unique_ptr<ParsedExpression> GetGlobalVertexCount(const vector<CSRVertexTable> &vertex_tables);
+unique_ptr<CommonTableExpressionInfo> MakeMultiLabelEdgesCTE(const vector<CSRVertexTable> &vertex_tables,
+                                                             const vector<shared_ptr<PropertyGraphTable>> &edge_tables);
 
 } // namespace duckdb
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/concurrent_union_find.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+//! Disjoint sets over [0, count) that threads may Union and Find concurrently. A root is only ever linked under a
+//! smaller root, with a compare-and-swap on its parent, so parents only decrease and the root of every set is its
+//! smallest member, no matter in which order the unions ran.
+class ConcurrentUnionFind {
+public:
+	explicit ConcurrentUnionFind(int64_t count) : count(count), parent(new std::atomic<int64_t>[count]) {
+		for (int64_t i = 0; i < count; i++) {
+			parent[i].store(i, std::memory_order_relaxed);
+		}
+	}
+
+	int64_t Count() const {
+		return count;
+	}
+
+	//! Root of the set of x, halving the path on the way
+	int64_t Find(int64_t x) {
+		while (true) {
+			auto p = parent[x].load(std::memory_order_relaxed);
+			if (p == x) {
+				return x;
+			}
+			auto grandparent = parent[p].load(std::memory_order_relaxed);
+			if (grandparent != p) {
+				// grandparent is an ancestor as well, a lost race only means less compression
+				parent[x].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+			}
+			x = grandparent;
+		}
+	}
+
+	void Union(int64_t a, int64_t b) {
+		while (true) {
+			a = Find(a);
+			b = Find(b);
+			if (a == b) {
+				return;
+			}
+			if (a < b) {
+				std::swap(a, b);
+			}
+			// a may have been linked by another thread since Find, then retry from its new root
+			auto expected = a;
+			if (parent[a].compare_exchange_strong(expected, b)) {
+				return;
+			}
+		}
+	}
+
+	//! Points every element directly at its root
+	void Compress(ClientContext *context) {
+		TraversalParallelFor(context, static_cast<idx_t>(count), [&](idx_t begin, idx_t end) {
+			for (auto i = static_cast<int64_t>(begin); i < static_cast<int64_t>(end); i++) {
+				parent[i].store(Find(i), std::memory_order_relaxed);
+			}
+		});
+	}
+
+	//! The root of every element, once all unions are done
+	vector<int64_t> Flatten(ClientContext *context) {
+		vector<int64_t> roots(count);
+		TraversalParallelFor(context, static_cast<idx_t>(count), [&](idx_t begin, idx_t end) {
+			for (auto i = static_cast<int64_t>(begin); i < static_cast<int64_t>(end); i++) {
+				roots[i] = Find(i);
+			}
+		});
+		return roots;
+	}
+
+private:
+	int64_t count;
+	unique_ptr<std::atomic<int64_t>[]> parent;
+};
+
+} // namespace duckdb
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/csr_edge_property.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/duckpgq_bitmap.hpp"
+
+namespace duckdb {
+
+enum class CSREdgeFilterType : uint8_t {
+	EQUAL,
+	NOT_EQUAL,
+	LESS_THAN,
+	LESS_THAN_OR_EQUAL,
+	GREATER_THAN,
+	GREATER_THAN_OR_EQUAL,
+	//! Inclusive range, constants holds the lower and the upper bound
+	BETWEEN,
+	IN
+};
+
+//! A simple predicate on one edge property, evaluated into a mask over the edges of a CSR
+struct CSREdgeFilter {
+	string property;
+	CSREdgeFilterType type = CSREdgeFilterType::EQUAL;
+	vector<Value> constants;
+
+	//! Parses =, <>, !=, <, <=, >, >=, between and in
+	static CSREdgeFilterType ParseType(const string &op);
+	bool operator==(const CSREdgeFilter &other) const;
+};
+
+//! One edge property column in CSR edge order, value i belongs to edge e[i].
+//! Values are stored in their physical representation: integral, temporal, boolean and decimal properties as
+//! BIGINT, floating point properties as DOUBLE and VARCHAR properties as strings.
+class CSREdgeProperty {
+public:
+	CSREdgeProperty(LogicalType type, idx_t edge_count);
+
+	//! Store row idx of format at CSR edge offset position
+	void SetValue(idx_t position, const UnifiedVectorFormat &format, idx_t idx);
+	//! Rebuild the column after the CSR edges moved, new offset i takes old offset source[i] or NULL when it is -1
+	void Gather(const vector<int64_t> &source);
+	//! Set the bit of every edge that passes the filter, NULL values never pass
+	void Evaluate(const CSREdgeFilter &filter, DuckPGQBitmap &mask) const;
+
+	//! Whether the values are stored as BIGINT, this includes dates and timestamps
+	bool IsIntegral() const {
+		return storage == StorageType::INTEGER;
+	}
+	//! Physical value of an integral property, false when it is NULL
+	bool TryGetInteger(idx_t position, int64_t &value) const {
+		if (!valid[position]) {
+			return false;
+		}
+		value = int_values[position];
+		return true;
+	}
+
+	const LogicalType type;
+
+private:
+	enum class StorageType : uint8_t { INTEGER, DOUBLE, VARCHAR };
+
+	StorageType storage;
+	vector<int64_t> int_values;
+	vector<double> double_values;
+	vector<string> string_values;
+	vector<uint8_t> valid;
+};
+
+} // namespace duckdb
@@ -18,6 +18,8 @@ public:
 	void set(size_t index);
 	bool test(size_t index) const;
 	void reset();
+	//! Number of bits set in both bitmaps, compared a word at a time
+	idx_t IntersectCount(const DuckPGQBitmap &other) const;
 
 private:
 	vector<uint64_t> bitmap;
@@ -3,8 +3,7 @@
 
 namespace duckdb {
 
-#define LANE_LIMIT         512
-#define VISIT_SIZE_DIVISOR 2
+#define LANE_LIMIT 512
 
 // Function to get DuckPGQState from ClientContext
 shared_ptr<DuckPGQState> GetDuckPGQState(ClientContext &context, bool throw_error_not_found = false);
@@ -12,8 +11,16 @@ CreatePropertyGraphInfo *GetPropertyGraphInfo(const shared_ptr<DuckPGQState> &du
 shared_ptr<PropertyGraphTable> ValidateSourceNodeAndEdgeTable(CreatePropertyGraphInfo *pg_info,
                                                               const std::string &node_table,
                                                               const std::string &edge_table);
+//! Selects the source key and function_name(0, rowid, extra_arguments...) for every vertex of the source table
 unique_ptr<SelectNode> CreateSelectNode(const shared_ptr<PropertyGraphTable> &edge_pg_entry,
-                                        const string &function_name, const string &function_alias);
+                                        const string &function_name, const string &function_alias,
+                                        const vector<Value> &extra_arguments = {});
+//! Applies the duckpgq_vertex_reordering setting to a CSR the first time a kernel uses it
+void ApplyVertexReordering(ClientContext &context, DuckPGQState &duckpgq_state, CSR &csr);
+//! Builds the hub bitmap rows of a CSR following the duckpgq_hub_degree_threshold setting, none unless it is set
+void ApplyHubRows(ClientContext &context, DuckPGQState &duckpgq_state, CSR &csr);
+//! Physical value of a BIGINT or TIMESTAMP time window bound, a NULL bound leaves that side of the window open
+int64_t GetTimeWindowBound(const Value &bound, bool is_start);
 unique_ptr<BaseTableRef> CreateBaseTableRef(const string &table_name, const string &alias = "");
 unique_ptr<ColumnRefExpression> CreateColumnRefExpression(const string &column_name, const string &table_name = "",
                                                           const string &alias = "");
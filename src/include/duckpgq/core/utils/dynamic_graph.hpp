@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/dynamic_graph.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+
+namespace duckdb {
+
+#define DYNAMIC_GRAPH_BLOCK_SIZE 64
+
+//! Blocked adjacency store for graphs with frequent edge inserts and deletes.
+//! Every vertex owns a chain of fixed-size blocks in a shared pool. All blocks in a chain are full except the tail,
+//! so inserts and deletes touch at most two blocks and neighbour scans stay sequential within a block.
+//! Exposes the same traversal interface as CSR (ForEachNeighbor / ForEachDeltaEdge) so kernels run on both.
+class DynamicGraph {
+public:
+	explicit DynamicGraph(int64_t vertex_count);
+
+	void InsertEdge(int64_t src, int64_t dst);
+	//! Removes one (src, dst) edge, returns false if the edge does not exist
+	bool DeleteEdge(int64_t src, int64_t dst);
+
+	int64_t VertexCount() const {
+		return vertex_count;
+	}
+	idx_t EdgeCount() const {
+		return edge_count;
+	}
+	int64_t Degree(int64_t vertex) const {
+		return degree[vertex];
+	}
+	//! Dynamic graphs are never relabeled, vertex ids are the rowids
+	int64_t ToInternal(int64_t vertex) const {
+		return vertex;
+	}
+
+	template <class FUNC>
+	void ForEachNeighbor(int64_t vertex, FUNC &&fun) const {
+		auto remaining = degree[vertex];
+		for (auto block = head[vertex]; block != INVALID_BLOCK && remaining > 0; block = next_block[block]) {
+			auto base = block * DYNAMIC_GRAPH_BLOCK_SIZE;
+			auto count = MinValue<int64_t>(remaining, DYNAMIC_GRAPH_BLOCK_SIZE);
+			for (int64_t slot = 0; slot < count; slot++) {
+				fun(neighbors[base + slot]);
+			}
+			remaining -= count;
+		}
+	}
+
+	//! All edges live in the blocks, there is nothing buffered on the side
+	template <class FUNC>
+	void ForEachDeltaEdge(FUNC &&fun) const {
+	}
+	bool HasDelta() const {
+		return false;
+	}
+	template <class FUNC>
+	void ForEachDeltaNeighbor(int64_t vertex, FUNC &&fun) const {
+	}
+
+	//! Inserts and deletes hold it exclusively, traversals share it for their whole run
+	mutable CSRAccessLock access_lock;
+
+private:
+	static constexpr int64_t INVALID_BLOCK = -1;
+
+	int64_t AllocateBlock();
+	void FreeBlock(int64_t block);
+	void CheckVertex(int64_t vertex) const;
+
+	int64_t vertex_count;
+	idx_t edge_count = 0;
+
+	vector<int64_t> degree;
+	vector<int64_t> head;
+	vector<int64_t> tail;
+
+	//! Block pool, DYNAMIC_GRAPH_BLOCK_SIZE neighbour slots per block
+	vector<int64_t> neighbors;
+	vector<int64_t> next_block;
+	vector<int64_t> prev_block;
+	vector<int64_t> free_blocks;
+};
+
+} // namespace duckdb
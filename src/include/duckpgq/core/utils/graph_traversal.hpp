@@ -0,0 +1,420 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/graph_traversal.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/duckpgq_utils.hpp"
+#include "duckpgq/core/utils/partitioned_csr.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace duckdb {
+
+//! A frontier goes dense once it and its out-edges cover more than 1 / DENSE_FRONTIER_DIVISOR of the edges
+#define DENSE_FRONTIER_DIVISOR 20
+//! Dense pull passes over fewer vertices than this stay on the calling thread
+#define PARALLEL_TRAVERSAL_MIN_VERTICES 65536
+//! Parallel dense push passes split the sources and the destinations into this many ranges each, independent of the
+//! number of threads
+#define PARALLEL_PUSH_RANGES 64
+
+//! How EdgeMap visits the edges of a frontier
+enum class EdgeMapMode : uint8_t {
+	//! Pick SPARSE or DENSE/PULL from the size of the frontier and its out-edges
+	AUTO,
+	//! Push along the out-edges of the frontier vertices, in ascending vertex order
+	SPARSE,
+	//! Scan all vertices and push along the out-edges of those in the frontier
+	DENSE,
+	//! Every vertex that still needs an update pulls from its in-neighbours in the frontier, needs the transpose
+	PULL
+};
+
+//! Parses the duckpgq_edge_map_mode setting: auto, sparse, dense or pull
+EdgeMapMode ParseEdgeMapMode(const string &mode);
+//! The duckpgq_edge_map_mode setting of the context, AUTO when it is not set
+EdgeMapMode GetEdgeMapMode(ClientContext &context);
+
+//! Active vertices of one traversal level, kept both as a flag per vertex and as a vertex list.
+//! Sparse passes append to both, dense passes only set flags and Rebuild the list afterwards.
+class Frontier {
+public:
+	explicit Frontier(int64_t vertex_count) : flags(vertex_count, 0) {
+	}
+
+	void Add(int64_t vertex) {
+		if (!flags[vertex]) {
+			flags[vertex] = 1;
+			vertices.push_back(vertex);
+		}
+	}
+	//! Set the flag only, the list is stale until Rebuild
+	void Mark(int64_t vertex) {
+		flags[vertex] = 1;
+	}
+	bool Contains(int64_t vertex) const {
+		return flags[vertex];
+	}
+	void Rebuild() {
+		vertices.clear();
+		for (int64_t vertex = 0; vertex < static_cast<int64_t>(flags.size()); vertex++) {
+			if (flags[vertex]) {
+				vertices.push_back(vertex);
+			}
+		}
+	}
+	void Sort() {
+		std::sort(vertices.begin(), vertices.end());
+	}
+	void Clear() {
+		if (vertices.size() < flags.size() / 8) {
+			for (auto vertex : vertices) {
+				flags[vertex] = 0;
+			}
+		} else {
+			std::fill(flags.begin(), flags.end(), 0);
+		}
+		vertices.clear();
+	}
+	idx_t Size() const {
+		return vertices.size();
+	}
+	idx_t Capacity() const {
+		return flags.size();
+	}
+	bool Empty() const {
+		return vertices.empty();
+	}
+	const vector<int64_t> &Vertices() const {
+		return vertices;
+	}
+
+private:
+	vector<uint8_t> flags;
+	vector<int64_t> vertices;
+};
+
+//! Per-traversal settings of EdgeMap
+template <class GRAPH>
+struct TraversalOptions {
+	//! Lets dense pull and push passes run on the task scheduler, they stay sequential without it
+	ClientContext *context = nullptr;
+	//! Transpose of the graph, enables PULL. A symmetric CSR is its own transpose.
+	const GRAPH *in_graph = nullptr;
+	//! Directed CSR whose transpose PULL reads, built on the first pull pass and kept with the CSR
+	CSR *transpose_source = nullptr;
+	EdgeMapMode mode = EdgeMapMode::AUTO;
+
+	bool CanPull() const {
+		return in_graph || transpose_source;
+	}
+};
+
+//! Options of a kernel running on graph, with parallel passes enabled
+template <class GRAPH>
+TraversalOptions<GRAPH> GetTraversalOptions(ClientContext &context, const GRAPH &graph) {
+	TraversalOptions<GRAPH> options;
+	options.context = &context;
+	options.mode = GetEdgeMapMode(context);
+	return options;
+}
+//! A CSR additionally pulls, a symmetric one over its own edges and a directed one over its transpose
+inline TraversalOptions<CSR> GetTraversalOptions(ClientContext &context, CSR &csr) {
+	TraversalOptions<CSR> options;
+	options.context = &context;
+	options.mode = GetEdgeMapMode(context);
+	if (csr.symmetric) {
+		options.in_graph = &csr;
+	} else {
+		options.transpose_source = &csr;
+	}
+	return options;
+}
+
+//! Runs fun(begin, end) over [0, count), split into tasks when context is set and count is large enough
+void TraversalParallelFor(ClientContext *context, idx_t count, const std::function<void(idx_t, idx_t)> &fun);
+//! Runs fun(task) for every task in [0, task_count), one scheduler task each when context is set
+void TraversalParallelTasks(ClientContext *context, idx_t task_count, const std::function<void(idx_t)> &fun);
+//! The rowid of the vertex with external id vertex, when dictionary is set the CSR numbers its vertices by it
+int64_t VertexRowid(const VertexDictionary *dictionary, int64_t vertex);
+//! component[v] holds any vertex of the component of v, relabels every component by the smallest rowid in it so the
+//! labels do not depend on the algorithm or the vertex order. csr may be null when vertices are external ids already,
+//! dictionary maps the external ids of a dense CSR back to rowids, see DuckPGQState::GetRowidDictionary.
+void LabelComponentsBySmallestRowid(ClientContext *context, const CSR *csr, const VertexDictionary *dictionary,
+                                    vector<int64_t> &component);
+
+//! Combines the results of fun(begin, end) over the ranges of TraversalParallelFor in range order, so the result does
+//! not depend on which thread finished first
+template <class T, class COMBINE>
+T TraversalParallelReduce(ClientContext *context, idx_t count, T identity, const std::function<T(idx_t, idx_t)> &fun,
+                          COMBINE &&combine) {
+	mutex partials_lock;
+	vector<std::pair<idx_t, T>> partials;
+	TraversalParallelFor(context, count, [&](idx_t begin, idx_t end) {
+		auto partial = fun(begin, end);
+		lock_guard<mutex> guard(partials_lock);
+		partials.emplace_back(begin, std::move(partial));
+	});
+	std::sort(partials.begin(), partials.end(),
+	          [](const std::pair<idx_t, T> &a, const std::pair<idx_t, T> &b) { return a.first < b.first; });
+	auto result = identity;
+	for (auto &partial : partials) {
+		result = combine(result, partial.second);
+	}
+	return result;
+}
+
+//! Ligra cost model: sparse while the frontier and its out-edges are small compared to the graph
+template <class GRAPH>
+EdgeMapMode ChooseEdgeMapMode(const GRAPH &graph, const Frontier &frontier, bool can_pull) {
+	idx_t work = frontier.Size();
+	for (auto vertex : frontier.Vertices()) {
+		work += static_cast<idx_t>(graph.Degree(vertex));
+	}
+	if (work <= graph.EdgeCount() / DENSE_FRONTIER_DIVISOR) {
+		return EdgeMapMode::SPARSE;
+	}
+	return can_pull ? EdgeMapMode::PULL : EdgeMapMode::DENSE;
+}
+
+//! Dense push over the base edges on the task scheduler. The edges of every source range are first bucketed by
+//! destination range, then every destination range applies its buckets in source order, so each destination is
+//! updated by one task and in ascending source order.
+template <class GRAPH, class F>
+void ParallelDensePush(const GRAPH &graph, Frontier &frontier, Frontier &next, F &f, ClientContext *context) {
+	auto vertex_count = frontier.Capacity();
+	auto range_size = (vertex_count + PARALLEL_PUSH_RANGES - 1) / PARALLEL_PUSH_RANGES;
+	vector<vector<std::pair<int64_t, int64_t>>> buckets(PARALLEL_PUSH_RANGES * PARALLEL_PUSH_RANGES);
+	TraversalParallelTasks(context, PARALLEL_PUSH_RANGES, [&](idx_t range) {
+		auto end = static_cast<int64_t>(MinValue<idx_t>((range + 1) * range_size, vertex_count));
+		for (auto src = static_cast<int64_t>(range * range_size); src < end; src++) {
+			if (!frontier.Contains(src)) {
+				continue;
+			}
+			graph.ForEachNeighbor(src, [&](int64_t dst) {
+				if (f.Cond(dst)) {
+					buckets[range * PARALLEL_PUSH_RANGES + static_cast<idx_t>(dst) / range_size].emplace_back(src, dst);
+				}
+			});
+		}
+	});
+	TraversalParallelTasks(context, PARALLEL_PUSH_RANGES, [&](idx_t range) {
+		for (idx_t source_range = 0; source_range < PARALLEL_PUSH_RANGES; source_range++) {
+			for (auto &edge : buckets[source_range * PARALLEL_PUSH_RANGES + range]) {
+				if (f.Cond(edge.second) && f.Update(edge.first, edge.second)) {
+					next.Mark(edge.second);
+				}
+			}
+		}
+	});
+}
+
+//! Applies f to every edge leaving the frontier and collects the targets f activates in next.
+//! F provides bool Update(src, dst), true when dst joins the next frontier, and bool Cond(dst), false once dst
+//! cannot change anymore. Update is called in ascending source order per destination, base edges before delta
+//! edges, in every mode except PULL. With a context, dense passes run on several threads: Update may run
+//! concurrently for different destinations, never for the same one. The caller holds a CSRReadGuard on the graph.
+//! next must be empty.
+template <class GRAPH, class F>
+void EdgeMap(const GRAPH &graph, Frontier &frontier, Frontier &next, F &f, const TraversalOptions<GRAPH> &options) {
+	auto mode = options.mode;
+	if (mode == EdgeMapMode::PULL && !options.CanPull()) {
+		mode = EdgeMapMode::DENSE;
+	}
+	if (mode == EdgeMapMode::AUTO) {
+		mode = ChooseEdgeMapMode(graph, frontier, options.CanPull());
+	}
+	switch (mode) {
+	case EdgeMapMode::SPARSE:
+		frontier.Sort();
+		for (auto src : frontier.Vertices()) {
+			graph.ForEachNeighbor(src, [&](int64_t dst) {
+				if (f.Cond(dst) && f.Update(src, dst)) {
+					next.Add(dst);
+				}
+			});
+		}
+		if (graph.HasDelta()) {
+			for (auto src : frontier.Vertices()) {
+				graph.ForEachDeltaNeighbor(src, [&](const CSRDeltaEdge &edge) {
+					if (f.Cond(edge.dst) && f.Update(src, edge.dst)) {
+						next.Add(edge.dst);
+					}
+				});
+			}
+		}
+		return;
+	case EdgeMapMode::DENSE:
+		if (options.context && frontier.Capacity() >= PARALLEL_TRAVERSAL_MIN_VERTICES) {
+			ParallelDensePush(graph, frontier, next, f, options.context);
+			break;
+		}
+		for (int64_t src = 0; src < static_cast<int64_t>(frontier.Capacity()); src++) {
+			if (!frontier.Contains(src)) {
+				continue;
+			}
+			graph.ForEachNeighbor(src, [&](int64_t dst) {
+				if (f.Cond(dst) && f.Update(src, dst)) {
+					next.Mark(dst);
+				}
+			});
+		}
+		break;
+	case EdgeMapMode::PULL: {
+		auto pull = [&](int64_t src, int64_t dst) {
+			if (frontier.Contains(src) && f.Cond(dst) && f.Update(src, dst)) {
+				next.Mark(dst);
+			}
+		};
+		if (options.in_graph) {
+			TraversalParallelFor(options.context, next.Capacity(), [&](idx_t begin, idx_t end) {
+				for (auto dst = static_cast<int64_t>(begin); dst < static_cast<int64_t>(end); dst++) {
+					if (f.Cond(dst)) {
+						options.in_graph->ForEachNeighbor(dst, [&](int64_t src) { pull(src, dst); });
+					}
+				}
+			});
+			break;
+		}
+		auto &transpose = options.transpose_source->GetTranspose();
+		TraversalParallelFor(options.context, next.Capacity(), [&](idx_t begin, idx_t end) {
+			for (auto dst = static_cast<int64_t>(begin); dst < static_cast<int64_t>(end); dst++) {
+				if (f.Cond(dst)) {
+					transpose.ForEachInEdge(dst, [&](int64_t src, int64_t) { pull(src, dst); });
+				}
+			}
+		});
+		break;
+	}
+	default:
+		throw InternalException("Unknown edge map mode");
+	}
+	if (graph.HasDelta()) {
+		// the delta is grouped per source, only the frontier vertices are looked up
+		for (auto src : frontier.Vertices()) {
+			graph.ForEachDeltaNeighbor(src, [&](const CSRDeltaEdge &edge) {
+				if (f.Cond(edge.dst) && f.Update(src, edge.dst)) {
+					next.Mark(edge.dst);
+				}
+			});
+		}
+	}
+	next.Rebuild();
+}
+
+//! Partitioned CSRs are always traversed dense, one pinned partition at a time. Partitions without frontier
+//! vertices are not pinned.
+template <class F>
+void EdgeMap(const PartitionedCSR &graph, Frontier &frontier, Frontier &next, F &f,
+             const TraversalOptions<PartitionedCSR> &options) {
+	frontier.Sort();
+	auto &vertices = frontier.Vertices();
+	idx_t position = 0;
+	for (idx_t partition = 0; partition < graph.PartitionCount() && position < vertices.size(); partition++) {
+		while (position < vertices.size() && vertices[position] < graph.PartitionBegin(partition)) {
+			position++;
+		}
+		if (position == vertices.size() || vertices[position] >= graph.PartitionEnd(partition)) {
+			continue;
+		}
+		graph.ForEachPartitionVertex(partition, [&](int64_t src, const int64_t *neighbors, int64_t degree) {
+			if (!frontier.Contains(src)) {
+				return;
+			}
+			for (int64_t i = 0; i < degree; i++) {
+				if (f.Cond(neighbors[i]) && f.Update(src, neighbors[i])) {
+					next.Mark(neighbors[i]);
+				}
+			}
+		});
+	}
+	next.Rebuild();
+}
+
+//! Calls f(vertex) for every vertex of the frontier
+template <class F>
+void VertexMap(const Frontier &frontier, F &&f) {
+	for (auto vertex : frontier.Vertices()) {
+		f(vertex);
+	}
+}
+
+//! Lane-parallel BFS levels shared by the path-length and reachability kernels.
+//! Bit l of seen / visit / next[v] belongs to the search running in lane l.
+class LaneBfs {
+public:
+	explicit LaneBfs(int64_t vertex_count)
+	    : seen(vertex_count), visit(vertex_count), frontier(vertex_count), next(vertex_count),
+	      next_frontier(vertex_count) {
+	}
+
+	//! Forget all searches
+	void Reset() {
+		std::fill(seen.begin(), seen.end(), std::bitset<LANE_LIMIT>());
+		std::fill(visit.begin(), visit.end(), std::bitset<LANE_LIMIT>());
+		frontier.Clear();
+	}
+	//! Start the search of lane at vertex, mark_seen keeps the search from reaching its source again
+	void AddSource(int64_t vertex, idx_t lane, bool mark_seen) {
+		visit[vertex][lane] = true;
+		if (mark_seen) {
+			seen[vertex][lane] = true;
+		}
+		frontier.Add(vertex);
+	}
+
+	//! Expand every lane by one level, on_edge(src, dst, lanes) sees the lanes that reach dst for the first time
+	//! over the edge. Returns false once no lane reached a new vertex.
+	template <class GRAPH, class ON_EDGE>
+	bool Step(const GRAPH &graph, const TraversalOptions<GRAPH> &options, ON_EDGE &&on_edge) {
+		LaneUpdate<ON_EDGE> update {*this, on_edge};
+		next_frontier.Clear();
+		EdgeMap(graph, frontier, next_frontier, update, options);
+		VertexMap(next_frontier, [&](int64_t vertex) { seen[vertex] |= next[vertex]; });
+		VertexMap(frontier, [&](int64_t vertex) { visit[vertex].reset(); });
+		std::swap(visit, next);
+		std::swap(frontier, next_frontier);
+		return !frontier.Empty();
+	}
+	template <class GRAPH>
+	bool Step(const GRAPH &graph, const TraversalOptions<GRAPH> &options) {
+		return Step(graph, options, [](int64_t, int64_t, const std::bitset<LANE_LIMIT> &) {});
+	}
+
+	vector<std::bitset<LANE_LIMIT>> seen;
+	//! Lanes that reached a vertex in the last level, only set for the vertices of the frontier
+	vector<std::bitset<LANE_LIMIT>> visit;
+	Frontier frontier;
+
+private:
+	template <class ON_EDGE>
+	struct LaneUpdate {
+		LaneBfs &bfs;
+		ON_EDGE &on_edge;
+
+		bool Cond(int64_t dst) const {
+			return true;
+		}
+		bool Update(int64_t src, int64_t dst) {
+			auto lanes = bfs.visit[src] & ~bfs.seen[dst];
+			if (lanes.none()) {
+				return false;
+			}
+			on_edge(src, dst, lanes);
+			auto first = bfs.next[dst].none();
+			bfs.next[dst] |= lanes;
+			return first;
+		}
+	};
+
+	vector<std::bitset<LANE_LIMIT>> next;
+	Frontier next_frontier;
+};
+
+} // namespace duckdb
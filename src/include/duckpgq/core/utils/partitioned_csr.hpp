@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/partitioned_csr.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+
+namespace duckdb {
+
+//! Default number of edges stored in one partition of a PartitionedCSR
+#define DEFAULT_CSR_PARTITION_EDGES 1048576
+
+//! Edge-cut partitioning of a CSR by contiguous vertex ranges for semi-external processing.
+//! Every partition keeps its local offsets and edges in one block of the buffer manager, so partitions that are not
+//! pinned can be spilled to the temporary directory and reloaded. Vertex state stays in memory, kernels pin one
+//! partition at a time and stream its edges through ForEachPartitionEdge.
+class PartitionedCSR {
+public:
+	//! Copies the edges of a compacted CSR into partitions of at most edges_per_partition edges, a vertex with
+	//! more edges than that gets a partition of its own
+	PartitionedCSR(BufferManager &buffer_manager, const CSR &csr, idx_t edges_per_partition);
+	//! Lays out empty partitions for the out-degrees of vertex_count vertices, the edges are streamed in afterwards
+	//! with AppendEdges so they never have to fit in memory at once
+	PartitionedCSR(BufferManager &buffer_manager, const vector<int64_t> &degrees, idx_t edges_per_partition);
+
+	//! Writes count edges into the partitions of their sources, pinning each partition once per run of sources.
+	//! Safe to call from several threads, throws if a vertex receives more edges than its degree
+	void AppendEdges(const int64_t *src, const int64_t *dst, idx_t count);
+	//! Whether all edges announced by the degrees have been appended
+	bool IsComplete() const {
+		return appended_edges.load() == edge_count;
+	}
+
+	int64_t VertexCount() const {
+		return vertex_count;
+	}
+	idx_t EdgeCount() const {
+		return edge_count;
+	}
+	idx_t PartitionCount() const {
+		return partitions.size();
+	}
+	//! First vertex of partition and one past its last vertex
+	int64_t PartitionBegin(idx_t partition) const {
+		return partitions[partition].first_vertex;
+	}
+	int64_t PartitionEnd(idx_t partition) const {
+		return partitions[partition].end_vertex;
+	}
+	//! The partitions copy the vertex order of the CSR, including a vertex reordering applied to it
+	int64_t ToInternal(int64_t vertex) const {
+		if (perm.empty() || vertex < 0 || vertex >= static_cast<int64_t>(perm.size())) {
+			return vertex;
+		}
+		return perm[vertex];
+	}
+
+	//! Pins one partition and calls fun(vertex, neighbors, degree) for every vertex in its range
+	template <class FUNC>
+	void ForEachPartitionVertex(idx_t partition, FUNC &&fun) const {
+		auto &entry = partitions[partition];
+		auto block = entry.block;
+		auto handle = buffer_manager.Pin(block);
+		auto offsets = reinterpret_cast<const int64_t *>(handle.Ptr());
+		auto edges = offsets + (entry.end_vertex - entry.first_vertex + 1);
+		for (auto vertex = entry.first_vertex; vertex < entry.end_vertex; vertex++) {
+			auto local = vertex - entry.first_vertex;
+			fun(vertex, edges + offsets[local], offsets[local + 1] - offsets[local]);
+		}
+	}
+
+	//! Pins one partition and calls fun(src, dst) for every edge in it
+	template <class FUNC>
+	void ForEachPartitionEdge(idx_t partition, FUNC &&fun) const {
+		ForEachPartitionVertex(partition, [&](int64_t vertex, const int64_t *neighbors, int64_t degree) {
+			for (int64_t i = 0; i < degree; i++) {
+				fun(vertex, neighbors[i]);
+			}
+		});
+	}
+
+	//! Same convention as CSR::vsize, the vertex count plus two trailing slots
+	size_t vsize;
+	//! Kernels share it while they stream the partitions, delete_partitioned_csr waits for them
+	mutable CSRAccessLock access_lock;
+
+private:
+	struct Partition {
+		int64_t first_vertex;
+		int64_t end_vertex;
+		idx_t edge_count;
+		shared_ptr<BlockHandle> block;
+	};
+
+	//! Splits the vertex range on the global offsets and allocates one block per partition with its local offsets
+	void AllocatePartitions(const int64_t *offsets, idx_t edges_per_partition);
+	//! Partition holding the edges of vertex
+	idx_t FindPartition(int64_t vertex) const;
+
+	BufferManager &buffer_manager;
+	int64_t vertex_count;
+	idx_t edge_count = 0;
+	vector<Partition> partitions;
+	vector<int64_t> perm;
+	//! Next free edge slot of every vertex, relative to its first edge, while edges are streamed in
+	unique_ptr<std::atomic<int64_t>[]> fill;
+	vector<int64_t> degrees;
+	std::atomic<idx_t> appended_edges {0};
+};
+
+} // namespace duckdb
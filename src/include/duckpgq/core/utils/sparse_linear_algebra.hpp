@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/sparse_linear_algebra.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+#include "duckpgq/core/utils/graph_traversal.hpp"
+
+#include <utility>
+
+namespace duckdb {
+
+//! Destination vertices per bin of a propagation-blocked push, the slice of y one bin touches stays in cache
+#define PROPAGATION_BLOCK_VERTICES 16384
+//! Source vertices binned by one task of a propagation-blocked push
+#define PROPAGATION_BLOCK_SOURCES 65536
+
+// The CSR is read as the adjacency matrix A with A[src][dst] set for every base edge. A semiring provides Add, which
+// must be associative and commutative with Zero as identity, and Multiply, which combines a vector entry with an
+// edge weight and maps Zero to Zero. Edges in the delta are not part of the matrix, kernels compact first.
+
+//! Sums of products, e.g. PageRank and path counting
+template <class T>
+struct PlusTimesSemiring {
+	using value_t = T;
+	static T Zero() {
+		return 0;
+	}
+	static T One() {
+		return 1;
+	}
+	static T Add(T a, T b) {
+		return a + b;
+	}
+	static T Multiply(T a, T b) {
+		return a * b;
+	}
+};
+
+//! Every stored edge has weight One, the matrix is the pattern of the graph
+template <class SEMIRING>
+struct PatternWeight {
+	typename SEMIRING::value_t operator()(int64_t offset) const {
+		return SEMIRING::One();
+	}
+};
+
+//! Edge weights from a column aligned with e, such as CSR::w or CSR::w_double
+template <class T>
+struct ColumnWeight {
+	explicit ColumnWeight(const vector<T> &column) : column(column) {
+	}
+	const vector<T> &column;
+
+	T operator()(int64_t offset) const {
+		return column[offset];
+	}
+};
+
+//! Per-call settings of the sparse kernels
+struct SparseOptions {
+	//! Lets the kernels run on the task scheduler, they stay sequential without it
+	ClientContext *context = nullptr;
+	//! Transpose of the CSR, lets x A pull over in-edges instead of pushing along out-edges
+	const CSRTranspose *transpose = nullptr;
+};
+
+//! y[j] = Add over the edges i -> j of Multiply(x[i], weight(edge)). Pulls over the transpose in parallel when one is
+//! given, otherwise pushes along the out-edges, binning the updates by destination block on large graphs.
+//! Every mode adds the terms of y[j] in ascending order of i, so all of them give the same result.
+//! Entries of y past the vertex count keep their value.
+template <class SEMIRING, class WEIGHT>
+void VxM(const CSR &csr, const WEIGHT &weight, const vector<typename SEMIRING::value_t> &x,
+         vector<typename SEMIRING::value_t> &y, const SparseOptions &options) {
+	using T = typename SEMIRING::value_t;
+	auto vertex_count = csr.VertexCount();
+	if (options.transpose) {
+		auto &transpose = *options.transpose;
+		TraversalParallelFor(options.context, vertex_count, [&](idx_t begin, idx_t end) {
+			for (auto column = static_cast<int64_t>(begin); column < static_cast<int64_t>(end); column++) {
+				auto sum = SEMIRING::Zero();
+				transpose.ForEachInEdge(column, [&](int64_t src, int64_t offset) {
+					sum = SEMIRING::Add(sum, SEMIRING::Multiply(x[src], weight(offset)));
+				});
+				y[column] = sum;
+			}
+		});
+		return;
+	}
+	std::fill(y.begin(), y.begin() + vertex_count, SEMIRING::Zero());
+	auto offsets = reinterpret_cast<const int64_t *>(csr.v);
+	if (!options.context || vertex_count <= PROPAGATION_BLOCK_VERTICES) {
+		for (int64_t src = 0; src < vertex_count; src++) {
+			if (x[src] == SEMIRING::Zero()) {
+				continue;
+			}
+			for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+				auto dst = csr.e[offset];
+				y[dst] = SEMIRING::Add(y[dst], SEMIRING::Multiply(x[src], weight(offset)));
+			}
+		}
+		return;
+	}
+	// propagation blocking: every source range writes its updates into one bin per destination block, then every
+	// block applies the bins of all source ranges in order, touching only its own slice of y
+	auto block_count = static_cast<idx_t>((vertex_count + PROPAGATION_BLOCK_VERTICES - 1) / PROPAGATION_BLOCK_VERTICES);
+	auto range_count = static_cast<idx_t>((vertex_count + PROPAGATION_BLOCK_SOURCES - 1) / PROPAGATION_BLOCK_SOURCES);
+	vector<vector<vector<std::pair<int64_t, T>>>> bins(range_count, vector<vector<std::pair<int64_t, T>>>(block_count));
+	TraversalParallelTasks(options.context, range_count, [&](idx_t range) {
+		auto begin = static_cast<int64_t>(range * PROPAGATION_BLOCK_SOURCES);
+		auto end = MinValue<int64_t>(begin + PROPAGATION_BLOCK_SOURCES, vertex_count);
+		auto &range_bins = bins[range];
+		for (auto src = begin; src < end; src++) {
+			if (x[src] == SEMIRING::Zero()) {
+				continue;
+			}
+			for (auto offset = offsets[src]; offset < offsets[src + 1]; offset++) {
+				auto dst = csr.e[offset];
+				range_bins[dst / PROPAGATION_BLOCK_VERTICES].emplace_back(dst,
+				                                                          SEMIRING::Multiply(x[src], weight(offset)));
+			}
+		}
+	});
+	TraversalParallelTasks(options.context, block_count, [&](idx_t block) {
+		for (auto &range_bins : bins) {
+			for (auto &update : range_bins[block]) {
+				y[update.first] = SEMIRING::Add(y[update.first], update.second);
+			}
+		}
+	});
+}
+
+} // namespace duckdb
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/triangle_counting.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+#include "duckpgq/core/utils/compressed_sparse_row.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+//! Intersections gallop through the longer list once it is this many times longer than the shorter one
+#define TRIANGLE_GALLOP_RATIO 32
+//! Wedges sampled per round of the estimator, split over a fixed number of tasks so the estimate does not depend on
+//! the number of threads
+#define TRIANGLE_SAMPLE_ROUND 65536
+#define TRIANGLE_SAMPLE_TASKS 64
+//! The estimator stops after this many samples even if the interval is still wider than asked for
+#define TRIANGLE_MAX_SAMPLES (1 << 24)
+//! Closed fractions below this are bounded absolutely, to error times this floor, as a relative bound around a
+//! fraction near zero would never be reached
+#define TRIANGLE_MIN_TRANSITIVITY 0.001
+
+//! Degree-ordered orientation of an undirected CSR, every edge stored in both directions. Each edge {u, v} is kept
+//! once, at the endpoint that comes first by (degree, vertex), so no list is longer than the square root of twice the
+//! edge count. Lists are sorted, self-loops and duplicate edges are dropped.
+struct OrientedGraph {
+	vector<int64_t> offsets;
+	vector<int64_t> targets;
+	//! Distinct neighbours of every vertex other than itself
+	vector<int64_t> degree;
+
+	int64_t VertexCount() const {
+		return static_cast<int64_t>(degree.size());
+	}
+	const int64_t *Targets(int64_t vertex) const {
+		return targets.data() + offsets[vertex];
+	}
+	idx_t OutDegree(int64_t vertex) const {
+		return static_cast<idx_t>(offsets[vertex + 1] - offsets[vertex]);
+	}
+};
+
+OrientedGraph OrientByDegree(ClientContext &context, const CSR &csr);
+
+//! Triangles through every vertex, each triangle is found once and credited to its three corners
+vector<int64_t> CountVertexTriangles(ClientContext &context, const OrientedGraph &graph);
+
+//! Estimated triangle count with a confidence interval, and the closed fraction of the wedges it is derived from
+struct TriangleEstimate {
+	double triangles = 0;
+	double lower_bound = 0;
+	double upper_bound = 0;
+	double transitivity = 0;
+	idx_t samples = 0;
+	//! Whether the interval is within the requested error of the estimate, relative
+	bool error_met = false;
+};
+
+//! Wedge sampling (Seshadhri et al.) on an undirected CSR: wedges are sampled uniformly, the closed fraction times the
+//! wedge count over three estimates the triangles. Samples until the Wilson interval of the closed fraction at the
+//! given confidence is within error of it, relative with a floor of TRIANGLE_MIN_TRANSITIVITY, or TRIANGLE_MAX_SAMPLES
+//! are taken. Wedges are counted and sampled over the distinct neighbours of every vertex, so self-loops and parallel
+//! edges do not dilute the closed fraction. Closure checks use CSR::HasEdge, so hub bitmap rows speed them up.
+TriangleEstimate EstimateTriangles(ClientContext &context, const CSR &csr, double error, double confidence);
+
+//! Calls fun(x) for every x in both sorted lists, merging or galloping through the longer list
+template <class FUNC>
+void ForEachCommonElement(const int64_t *a, idx_t a_size, const int64_t *b, idx_t b_size, FUNC &&fun) {
+	if (a_size > b_size) {
+		std::swap(a, b);
+		std::swap(a_size, b_size);
+	}
+	if (a_size == 0) {
+		return;
+	}
+	if (b_size / a_size < TRIANGLE_GALLOP_RATIO) {
+		idx_t i = 0;
+		idx_t j = 0;
+		while (i < a_size && j < b_size) {
+			if (a[i] < b[j]) {
+				i++;
+			} else if (b[j] < a[i]) {
+				j++;
+			} else {
+				fun(a[i]);
+				i++;
+				j++;
+			}
+		}
+		return;
+	}
+	idx_t j = 0;
+	for (idx_t i = 0; i < a_size && j < b_size; i++) {
+		// exponential search for the first element of b not below a[i], then binary search within the last step
+		idx_t step = 1;
+		while (j + step < b_size && b[j + step] < a[i]) {
+			step *= 2;
+		}
+		j = static_cast<idx_t>(std::lower_bound(b + j, b + MinValue(j + step + 1, b_size), a[i]) - b);
+		if (j < b_size && b[j] == a[i]) {
+			fun(a[i]);
+			j++;
+		}
+	}
+}
+
+} // namespace duckdb
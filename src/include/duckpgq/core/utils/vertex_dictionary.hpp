@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//                         DuckPGQ
+//
+// duckpgq/core/utils/vertex_dictionary.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "duckpgq/common.hpp"
+
+namespace duckdb {
+
+//! Maps the key of a vertex table to a dense vertex id in [0, Size()).
+//! Keys may span several columns of any fixed-width or VARCHAR type, they are encoded into one byte string per row.
+//! The keys are kept as a sorted array: the dense id of a key is its rank, so ids do not depend on insertion order
+//! and the live vertices of a table with deleted rows are numbered without gaps. BIGINT and VARCHAR keys are encoded
+//! order-preserving, so their dense ids follow the key order.
+class VertexDictionary {
+public:
+	//! Encode the key columns of every row, rows with a NULL key column get no entry in valid
+	static void EncodeKeys(DataChunk &args, idx_t first_column, vector<string> &keys, vector<bool> &valid);
+
+	//! Moves a batch of keys into one of the insert shards. Concurrent batches pick shards round robin, so they only
+	//! wait for each other when there are more inserting threads than shards. batch_rowids is either empty or holds
+	//! the rowid of every key.
+	void Insert(vector<string> &batch, vector<int64_t> &batch_rowids);
+	//! Merges the shards, then sorts and deduplicates the keys. Inserting after a lookup renumbers the vertices.
+	void Finalize();
+	//! Returns -1 when the key is not in the dictionary, needs a finalized dictionary
+	int64_t Lookup(const string &key) const;
+	//! The smallest rowid inserted with the key of dense_id, -1 when the key came without a rowid. Needs a finalized
+	//! dictionary.
+	int64_t GetRowid(int64_t dense_id) const;
+
+	idx_t Size() const {
+		return keys.size();
+	}
+	bool IsFinalized() const {
+		return finalized.load();
+	}
+	//! Whether the keys were inserted with their rowids, as the CSR builders do
+	bool HasRowids() const {
+		return has_rowids.load();
+	}
+
+	//! The query that filled a CSR builder dictionary, a later build starts over from an empty dictionary
+	transaction_t build_query = MAXIMUM_QUERY_ID;
+
+private:
+	static constexpr idx_t INSERT_SHARD_COUNT = 16;
+
+	struct InsertShard {
+		std::mutex lock;
+		vector<string> keys;
+		vector<int64_t> rowids;
+	};
+
+	InsertShard shards[INSERT_SHARD_COUNT];
+	std::atomic<idx_t> next_shard {0};
+	std::mutex finalize_lock;
+	vector<string> keys;
+	//! rowids[i] belongs to keys[i]
+	vector<int64_t> rowids;
+	std::atomic<bool> finalized {true};
+	std::atomic<bool> has_rowids {false};
+};
+
+} // namespace duckdb
@@ -4,6 +4,9 @@
 #include "duckdb/common/case_insensitive_map.hpp"
 
 #include <duckpgq/core/utils/compressed_sparse_row.hpp>
+#include <duckpgq/core/utils/dynamic_graph.hpp>
+#include <duckpgq/core/utils/partitioned_csr.hpp>
+#include <duckpgq/core/utils/vertex_dictionary.hpp>
 
 namespace duckdb {
 
@@ -20,6 +23,15 @@ public:
 	// Methods to retrieve property graph structures or Compressed Sparse Row (CSR) representations by ID.
 	CreatePropertyGraphInfo *GetPropertyGraph(const string &pg_name);
 	CSR *GetCSR(int32_t id);
+	//! Returns nullptr when no dynamic graph is registered under this id
+	DynamicGraph *GetDynamicGraph(int32_t id);
+	//! Returns nullptr when no partitioned CSR is registered under this id
+	PartitionedCSR *GetPartitionedCSR(int32_t id);
+	//! Returns nullptr when no vertex dictionary is registered under this id
+	VertexDictionary *GetVertexDictionary(int32_t id);
+	//! The builder dictionary of CSR csr_id when it numbers a single vertex table of vertex_count rows and kept their
+	//! rowids, nullptr otherwise
+	VertexDictionary *GetRowidDictionary(int32_t csr_id, int64_t vertex_count);
 
 	// Manage property graph data processing.
 	void RetrievePropertyGraphs(const shared_ptr<Connection> &context);
@@ -40,6 +52,15 @@ public:
 	std::unordered_map<int32_t, unique_ptr<CSR>> csr_list;
 	std::mutex csr_lock;
 	std::unordered_set<int32_t> csr_to_delete;
+
+	//! Dynamic graph stores that absorb edge inserts and deletes, kept until they are explicitly dropped
+	std::unordered_map<int32_t, unique_ptr<DynamicGraph>> dynamic_graph_list;
+
+	//! CSRs moved into buffer-managed partitions by csr_partition, kept until they are explicitly dropped
+	std::unordered_map<int32_t, unique_ptr<PartitionedCSR>> partitioned_csr_list;
+
+	//! Key to dense id dictionaries of vertex tables, kept until they are explicitly dropped
+	std::unordered_map<int32_t, unique_ptr<VertexDictionary>> vertex_dictionary_list;
 };
 
 } // namespace duckdb